@@ -0,0 +1,801 @@
+/*
+Copyright (c) 2025 Joshua Skelton
+
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not claim
+     that you wrote the original software. If you use this software in a
+     product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "../mathc.h"
+
+#if !defined(MATHC_USE_FLOATING_POINT)
+#error "The benchmark requires mfloat_t"
+#endif
+
+/* Number of elements passed to the batched (_n, _soa) functions */
+#define BENCH_BATCH 256
+/* Minimum time spent on each function, in seconds */
+#define BENCH_MIN_TIME 0.02
+/* Number of rays passed to the packet functions */
+#define BENCH_PACKET 8
+/* Number of bones referenced by the skinning functions */
+#define BENCH_BONES 64
+/* Number of keys of every animation track */
+#define BENCH_KEYS 32
+/* Number of threads of the thread pool and of mathc_parallel_for() */
+#define BENCH_THREADS 4
+#define BENCH_BUFFER_SIZE (BENCH_BATCH * MAT4_SIZE)
+
+#define BENCH(name, count, call) do { \
+	long iterations = 1; \
+	double elapsed; \
+	if (bench_skip(name)) { \
+		break; \
+	} \
+	for (;;) { \
+		long i; \
+		double start = bench_now(); \
+		for (i = 0; i < iterations; i++) { \
+			(void)call; \
+		} \
+		elapsed = bench_now() - start; \
+		if (elapsed >= BENCH_MIN_TIME || iterations >= (1L << 30)) { \
+			break; \
+		} \
+		iterations = iterations * 2; \
+	} \
+	bench_report(name, count, iterations, elapsed); \
+} while (0)
+
+static bool bench_json = false;
+static const char *bench_filter = NULL;
+
+static mfloat_t r[BENCH_BUFFER_SIZE];
+static mfloat_t a[BENCH_BUFFER_SIZE];
+static mfloat_t b[BENCH_BUFFER_SIZE];
+static mfloat_t c[BENCH_BUFFER_SIZE];
+static mfloat_t d[BENCH_BUFFER_SIZE];
+static mfloat_t e[BENCH_BUFFER_SIZE];
+/* Unit quaternions, pairwise one radian apart so that slerp takes the
+ * trigonometric path rather than the linear fallback */
+static mfloat_t qa[BENCH_BUFFER_SIZE];
+static mfloat_t qb[BENCH_BUFFER_SIZE];
+static uint32_t mask[BENCH_BATCH];
+static uint16_t packed[BENCH_BUFFER_SIZE];
+/* Four bone indices per vertex, into a palette of BENCH_BONES matrices */
+static int bones[BENCH_BATCH * 4];
+static mfloat_t *soa_r[MAT4_SIZE];
+static mfloat_t *soa_a[MAT4_SIZE];
+static mfloat_t *soa_b[MAT4_SIZE];
+static struct vec3_stream stream_r;
+static struct vec3_stream stream_a;
+static struct vec3_stream stream_b;
+static struct vec3_stream packet_a;
+static struct vec3_stream packet_b;
+static int hierarchy_parents[BENCH_BATCH];
+static bool hierarchy_dirty[BENCH_BATCH];
+static struct mat4_hierarchy hierarchy;
+static struct bvh_node bvh_nodes[BENCH_BATCH * 2];
+static int bvh_indices[BENCH_BATCH];
+static struct bvh bvh;
+static struct aligned_buffer buffer;
+#if defined(MATHC_USE_THREADS)
+static struct mathc_thread_pool pool;
+#endif
+#if defined(MATHC_USE_EASING_FUNCTIONS)
+static mfloat_t ease_values[BENCH_BATCH + 2];
+static struct ease_table ease;
+#endif
+static mfloat_t track_times[BENCH_KEYS];
+static struct animation_track tracks[BENCH_BATCH];
+static long bvh_visited;
+static mfloat_t basis2[2][2];
+static mfloat_t basis_r2[2][2];
+static mfloat_t basis3[3][3];
+static mfloat_t basis_r3[3][3];
+#if defined(MATHC_USE_INT)
+static mint_t ir[BENCH_BUFFER_SIZE];
+static mint_t ia[BENCH_BUFFER_SIZE];
+static mint_t ib[BENCH_BUFFER_SIZE];
+static mint_t ic[BENCH_BUFFER_SIZE];
+#endif
+
+static double bench_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static const char *bench_precision(void)
+{
+#if defined(MATHC_USE_THREADS)
+	return sizeof(mfloat_t) == sizeof(double) ? "double-threads" : "float-threads";
+#else
+	return sizeof(mfloat_t) == sizeof(double) ? "double" : "float";
+#endif
+}
+
+static bool bench_skip(const char *name)
+{
+	return bench_filter != NULL && strstr(name, bench_filter) == NULL;
+}
+
+static void bench_report(const char *name, long count, long iterations, double elapsed)
+{
+	double ns_per_op = elapsed * 1e9 / (double)iterations;
+	double ops_per_sec = (double)iterations / elapsed;
+	if (bench_json) {
+		printf("{\"function\": \"%s\", \"precision\": \"%s\", \"count\": %ld, \"iterations\": %ld, \"ns_per_op\": %.3f, \"ops_per_sec\": %.1f}\n",
+			name, bench_precision(), count, iterations, ns_per_op, ops_per_sec);
+	} else {
+		printf("%s,%s,%ld,%ld,%.3f,%.1f\n", name, bench_precision(), count, iterations, ns_per_op, ops_per_sec);
+	}
+}
+
+static bool bench_bvh_hit(void *data, int index, mfloat_t *result, mfloat_t *origin, mfloat_t *direction)
+{
+	mfloat_t *v = (mfloat_t *)data + index * VEC3_SIZE * 3;
+	mfloat_t t;
+	if (ray_intersect_triangle(&t, origin, direction, v, v + VEC3_SIZE, v + VEC3_SIZE * 2) && t < *result) {
+		*result = t;
+		return true;
+	}
+	return false;
+}
+
+static void bench_bvh_visit(void *data, int index)
+{
+	(void)data;
+	bvh_visited = bvh_visited + index;
+}
+
+#if defined(MATHC_USE_THREADS)
+static void bench_thread_multiply(void *data, size_t begin, size_t end)
+{
+	(void)data;
+	mat4_multiply_n(r + begin * MAT4_SIZE, a + begin * MAT4_SIZE, b + begin * MAT4_SIZE, end - begin);
+}
+#endif
+
+static void bench_reset(void)
+{
+	unsigned int seed = 12345;
+	int i;
+	int j;
+	for (i = 0; i < BENCH_BUFFER_SIZE; i++) {
+		/* Values in 0.1-1.0, valid for every function (square roots, arc cosines, divisions) */
+		seed = seed * 1103515245u + 12345u;
+		a[i] = MFLOAT_C(0.1) + (mfloat_t)((seed >> 16) % 1000) / MFLOAT_C(1111.0);
+		b[i] = MFLOAT_C(1.0) - a[i] * MFLOAT_C(0.5);
+		c[i] = a[i] * MFLOAT_C(0.75);
+		d[i] = b[i] * MFLOAT_C(0.25);
+		e[i] = MFLOAT_C(0.5);
+#if defined(MATHC_USE_INT)
+		ia[i] = (mint_t)(1 + i % 5);
+		ib[i] = (mint_t)(1 + i % 3);
+		ic[i] = (mint_t)(6 + i % 4);
+#endif
+	}
+	for (i = 0; i < BENCH_BUFFER_SIZE; i += QUAT_SIZE) {
+		mfloat_t axis[VEC3_SIZE];
+		mfloat_t turn[QUAT_SIZE];
+		vec3_normalize(axis, vec3(axis, a[i], b[i + 1], c[i + 2]));
+		quat_from_axis_angle(qa + i, axis, a[i + 3] * MFLOAT_C(6.0));
+		vec3_normalize(axis, vec3(axis, b[i], c[i + 1], a[i + 2]));
+		quat_from_axis_angle(turn, axis, MFLOAT_C(1.0));
+		quat_multiply(qb + i, qa + i, turn);
+	}
+	for (i = 0; i < MAT4_SIZE; i++) {
+		soa_r[i] = r + i * BENCH_BATCH;
+		soa_a[i] = a + i * BENCH_BATCH;
+		soa_b[i] = b + i * BENCH_BATCH;
+	}
+	stream_r.x = r;
+	stream_r.y = r + BENCH_BATCH;
+	stream_r.z = r + BENCH_BATCH * 2;
+	stream_r.count = BENCH_BATCH;
+	stream_a.x = a;
+	stream_a.y = a + BENCH_BATCH;
+	stream_a.z = a + BENCH_BATCH * 2;
+	stream_a.count = BENCH_BATCH;
+	stream_b.x = b;
+	stream_b.y = b + BENCH_BATCH;
+	stream_b.z = b + BENCH_BATCH * 2;
+	stream_b.count = BENCH_BATCH;
+	packet_a = stream_a;
+	packet_a.count = BENCH_PACKET;
+	packet_b = stream_b;
+	packet_b.count = BENCH_PACKET;
+	/* Binary tree, with every node below the root */
+	for (i = 0; i < BENCH_BATCH; i++) {
+		hierarchy_parents[i] = i == 0 ? -1 : (i - 1) / 2;
+		hierarchy_dirty[i] = false;
+	}
+	hierarchy.parents = hierarchy_parents;
+	hierarchy.local = a;
+	hierarchy.world = r;
+	hierarchy.dirty = hierarchy_dirty;
+	hierarchy.count = BENCH_BATCH;
+	for (i = 0; i < BENCH_BATCH * 4; i++) {
+		bones[i] = (i * 7) % BENCH_BONES;
+	}
+	for (i = 0; i < BENCH_KEYS; i++) {
+		track_times[i] = (mfloat_t)i / (mfloat_t)(BENCH_KEYS - 1);
+	}
+	/* Linear vec3 tracks, each with its own keys */
+	for (i = 0; i < BENCH_BATCH; i++) {
+		tracks[i].times = track_times;
+		tracks[i].values = a + (i % 16) * BENCH_KEYS * VEC3_SIZE;
+		tracks[i].count = BENCH_KEYS;
+		tracks[i].size = VEC3_SIZE;
+		tracks[i].interpolation = ANIMATION_LINEAR;
+		tracks[i].cursor = 0;
+	}
+#if defined(MATHC_USE_EASING_FUNCTIONS)
+	ease_table(&ease, sine_ease_out, ease_values, BENCH_BATCH, true);
+#endif
+	bvh.nodes = bvh_nodes;
+	bvh.indices = bvh_indices;
+	bvh_build_triangles(&bvh, a, BENCH_BATCH);
+	aligned_buffer(&buffer, r, sizeof(r), 64, MAT4_SIZE * sizeof(mfloat_t));
+	for (i = 0; i < 3; i++) {
+		for (j = 0; j < 3; j++) {
+			basis3[i][j] = i == j ? MFLOAT_C(1.0) : MFLOAT_C(0.25);
+			if (i < 2 && j < 2) {
+				basis2[i][j] = basis3[i][j];
+			}
+		}
+	}
+}
+
+static void bench_all(void)
+{
+#if defined(MATHC_USE_THREADS)
+	/* A pool can't be created twice, so it is destroyed in the same call */
+	BENCH("mathc_thread_pool_create", 1, (mathc_thread_pool_create(&pool, BENCH_THREADS), mathc_thread_pool_destroy(&pool)));
+	mathc_thread_pool_create(&pool, BENCH_THREADS);
+	BENCH("mathc_thread_pool_dispatch", BENCH_BATCH, mathc_thread_pool_dispatch(&pool, BENCH_BATCH, 16, bench_thread_multiply, NULL));
+	mathc_thread_pool_destroy(&pool);
+	BENCH("mathc_parallel_for", BENCH_BATCH, mathc_parallel_for(BENCH_BATCH, 16, bench_thread_multiply, NULL, BENCH_THREADS));
+#endif
+#if defined(MATHC_USE_INT)
+	BENCH("clampi", 1, clampi(2, 2, 2));
+#endif
+#if defined(MATHC_USE_FLOATING_POINT)
+	BENCH("nearly_equal", 1, nearly_equal(MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("to_radians", 1, to_radians(MFLOAT_C(0.5)));
+	BENCH("to_degrees", 1, to_degrees(MFLOAT_C(0.5)));
+	BENCH("clampf", 1, clampf(MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("mathc_sin", 1, mathc_sin(MFLOAT_C(0.5)));
+	BENCH("mathc_cos", 1, mathc_cos(MFLOAT_C(0.5)));
+	BENCH("mathc_sincos", 1, mathc_sincos(MFLOAT_C(0.5), r, r + 1));
+	BENCH("mathc_acos", 1, mathc_acos(MFLOAT_C(0.5)));
+	BENCH("mathc_atan2", 1, mathc_atan2(MFLOAT_C(0.5), MFLOAT_C(0.5)));
+#endif
+#if defined(MATHC_USE_INT)
+	BENCH("vec2i_is_zero", 1, vec2i_is_zero(ia));
+	BENCH("vec2i_is_equal", 1, vec2i_is_equal(ia, ib));
+	BENCH("vec2i", 1, vec2i(ir, 2, 2));
+	BENCH("vec2i_assign", 1, vec2i_assign(ir, ia));
+#endif
+#if defined(MATHC_USE_INT) && defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec2i_assign_vec2", 1, vec2i_assign_vec2(ir, a));
+#endif
+#if defined(MATHC_USE_INT)
+	BENCH("vec2i_zero", 1, vec2i_zero(ir));
+	BENCH("vec2i_one", 1, vec2i_one(ir));
+	BENCH("vec2i_sign", 1, vec2i_sign(ir, ia));
+	BENCH("vec2i_add", 1, vec2i_add(ir, ia, ib));
+	BENCH("vec2i_add_i", 1, vec2i_add_i(ir, ia, 2));
+	BENCH("vec2i_subtract", 1, vec2i_subtract(ir, ia, ib));
+	BENCH("vec2i_subtract_i", 1, vec2i_subtract_i(ir, ia, 2));
+	BENCH("vec2i_multiply", 1, vec2i_multiply(ir, ia, ib));
+	BENCH("vec2i_multiply_i", 1, vec2i_multiply_i(ir, ia, 2));
+	BENCH("vec2i_divide", 1, vec2i_divide(ir, ia, ib));
+	BENCH("vec2i_divide_i", 1, vec2i_divide_i(ir, ia, 2));
+	BENCH("vec2i_snap", 1, vec2i_snap(ir, ia, ib));
+	BENCH("vec2i_snap_i", 1, vec2i_snap_i(ir, ia, 2));
+	BENCH("vec2i_negative", 1, vec2i_negative(ir, ia));
+	BENCH("vec2i_abs", 1, vec2i_abs(ir, ia));
+	BENCH("vec2i_max", 1, vec2i_max(ir, ia, ib));
+	BENCH("vec2i_min", 1, vec2i_min(ir, ia, ib));
+	BENCH("vec2i_clamp", 1, vec2i_clamp(ir, ia, ib, ic));
+	BENCH("vec2i_tangent", 1, vec2i_tangent(ir, ia));
+	BENCH("vec3i_is_zero", 1, vec3i_is_zero(ia));
+	BENCH("vec3i_is_equal", 1, vec3i_is_equal(ia, ib));
+	BENCH("vec3i", 1, vec3i(ir, 2, 2, 2));
+	BENCH("vec3i_assign", 1, vec3i_assign(ir, ia));
+#endif
+#if defined(MATHC_USE_INT) && defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec3i_assign_vec3", 1, vec3i_assign_vec3(ir, a));
+#endif
+#if defined(MATHC_USE_INT)
+	BENCH("vec3i_zero", 1, vec3i_zero(ir));
+	BENCH("vec3i_one", 1, vec3i_one(ir));
+	BENCH("vec3i_sign", 1, vec3i_sign(ir, ia));
+	BENCH("vec3i_add", 1, vec3i_add(ir, ia, ib));
+	BENCH("vec3i_add_i", 1, vec3i_add_i(ir, ia, 2));
+	BENCH("vec3i_subtract", 1, vec3i_subtract(ir, ia, ib));
+	BENCH("vec3i_subtract_i", 1, vec3i_subtract_i(ir, ia, 2));
+	BENCH("vec3i_multiply", 1, vec3i_multiply(ir, ia, ib));
+	BENCH("vec3i_multiply_i", 1, vec3i_multiply_i(ir, ia, 2));
+	BENCH("vec3i_divide", 1, vec3i_divide(ir, ia, ib));
+	BENCH("vec3i_divide_i", 1, vec3i_divide_i(ir, ia, 2));
+	BENCH("vec3i_snap", 1, vec3i_snap(ir, ia, ib));
+	BENCH("vec3i_snap_i", 1, vec3i_snap_i(ir, ia, 2));
+	BENCH("vec3i_cross", 1, vec3i_cross(ir, ia, ib));
+	BENCH("vec3i_negative", 1, vec3i_negative(ir, ia));
+	BENCH("vec3i_abs", 1, vec3i_abs(ir, ia));
+	BENCH("vec3i_max", 1, vec3i_max(ir, ia, ib));
+	BENCH("vec3i_min", 1, vec3i_min(ir, ia, ib));
+	BENCH("vec3i_clamp", 1, vec3i_clamp(ir, ia, ib, ic));
+	BENCH("vec4i_is_zero", 1, vec4i_is_zero(ia));
+	BENCH("vec4i_is_equal", 1, vec4i_is_equal(ia, ib));
+	BENCH("vec4i", 1, vec4i(ir, 2, 2, 2, 2));
+	BENCH("vec4i_assign", 1, vec4i_assign(ir, ia));
+#endif
+#if defined(MATHC_USE_INT) && defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec4i_assign_vec4", 1, vec4i_assign_vec4(ir, a));
+#endif
+#if defined(MATHC_USE_INT)
+	BENCH("vec4i_zero", 1, vec4i_zero(ir));
+	BENCH("vec4i_one", 1, vec4i_one(ir));
+	BENCH("vec4i_sign", 1, vec4i_sign(ir, ia));
+	BENCH("vec4i_add", 1, vec4i_add(ir, ia, ib));
+	BENCH("vec4i_add_i", 1, vec4i_add_i(ir, ia, 2));
+	BENCH("vec4i_subtract", 1, vec4i_subtract(ir, ia, ib));
+	BENCH("vec4i_subtract_i", 1, vec4i_subtract_i(ir, ia, 2));
+	BENCH("vec4i_multiply", 1, vec4i_multiply(ir, ia, ib));
+	BENCH("vec4i_multiply_i", 1, vec4i_multiply_i(ir, ia, 2));
+	BENCH("vec4i_divide", 1, vec4i_divide(ir, ia, ib));
+	BENCH("vec4i_divide_i", 1, vec4i_divide_i(ir, ia, 2));
+	BENCH("vec4i_snap", 1, vec4i_snap(ir, ia, ib));
+	BENCH("vec4i_snap_i", 1, vec4i_snap_i(ir, ia, 2));
+	BENCH("vec4i_negative", 1, vec4i_negative(ir, ia));
+	BENCH("vec4i_abs", 1, vec4i_abs(ir, ia));
+	BENCH("vec4i_max", 1, vec4i_max(ir, ia, ib));
+	BENCH("vec4i_min", 1, vec4i_min(ir, ia, ib));
+	BENCH("vec4i_clamp", 1, vec4i_clamp(ir, ia, ib, ic));
+#endif
+#if defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec2_is_zero", 1, vec2_is_zero(a));
+	BENCH("vec2_is_equal", 1, vec2_is_equal(a, b));
+	BENCH("vec2", 1, vec2(r, MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("vec2_assign", 1, vec2_assign(r, a));
+#endif
+#if defined(MATHC_USE_INT) && defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec2_assign_vec2i", 1, vec2_assign_vec2i(r, ia));
+#endif
+#if defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec2_zero", 1, vec2_zero(r));
+	BENCH("vec2_one", 1, vec2_one(r));
+	BENCH("vec2_sign", 1, vec2_sign(r, a));
+	BENCH("vec2_add", 1, vec2_add(r, a, b));
+	BENCH("vec2_add_f", 1, vec2_add_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec2_subtract", 1, vec2_subtract(r, a, b));
+	BENCH("vec2_subtract_f", 1, vec2_subtract_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec2_multiply", 1, vec2_multiply(r, a, b));
+	BENCH("vec2_multiply_f", 1, vec2_multiply_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec2_multiply_mat2", 1, vec2_multiply_mat2(r, a, b));
+	BENCH("vec2_multiply_mat2_nr", 1, vec2_multiply_mat2_nr(r, a, b));
+	BENCH("vec2_divide", 1, vec2_divide(r, a, b));
+	BENCH("vec2_divide_f", 1, vec2_divide_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec2_snap", 1, vec2_snap(r, a, b));
+	BENCH("vec2_snap_f", 1, vec2_snap_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec2_negative", 1, vec2_negative(r, a));
+	BENCH("vec2_abs", 1, vec2_abs(r, a));
+	BENCH("vec2_floor", 1, vec2_floor(r, a));
+	BENCH("vec2_ceil", 1, vec2_ceil(r, a));
+	BENCH("vec2_round", 1, vec2_round(r, a));
+	BENCH("vec2_max", 1, vec2_max(r, a, b));
+	BENCH("vec2_min", 1, vec2_min(r, a, b));
+	BENCH("vec2_clamp", 1, vec2_clamp(r, a, b, c));
+	BENCH("vec2_cross", 1, vec2_cross(a, b));
+	BENCH("vec2_normalize", 1, vec2_normalize(r, a));
+	BENCH("vec2_normalize_fast", 1, vec2_normalize_fast(r, a));
+	BENCH("vec2_dot", 1, vec2_dot(a, b));
+	BENCH("vec2_project", 1, vec2_project(r, a, b));
+	BENCH("vec2_slide", 1, vec2_slide(r, a, b));
+	BENCH("vec2_reflect", 1, vec2_reflect(r, a, b));
+	BENCH("vec2_tangent", 1, vec2_tangent(r, a));
+	BENCH("vec2_rotate", 1, vec2_rotate(r, a, MFLOAT_C(0.5)));
+	BENCH("vec2_lerp", 1, vec2_lerp(r, a, b, MFLOAT_C(0.5)));
+	BENCH("vec2_bilinear", 1, vec2_bilinear(r, a, b, c, d, MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("vec2_bezier3", 1, vec2_bezier3(r, a, b, c, MFLOAT_C(0.5)));
+	BENCH("vec2_bezier4", 1, vec2_bezier4(r, a, b, c, d, MFLOAT_C(0.5)));
+	BENCH("vec2_angle", 1, vec2_angle(a));
+	BENCH("vec2_length", 1, vec2_length(a));
+	BENCH("vec2_length_squared", 1, vec2_length_squared(a));
+	BENCH("vec2_distance", 1, vec2_distance(a, b));
+	BENCH("vec2_distance_squared", 1, vec2_distance_squared(a, b));
+	BENCH("vec2_linear_independent", 1, vec2_linear_independent(a, b));
+	BENCH("vec2_orthonormalization", 1, vec2_orthonormalization(basis_r2, basis2));
+	BENCH("vec3_is_zero", 1, vec3_is_zero(a));
+	BENCH("vec3_is_equal", 1, vec3_is_equal(a, b));
+	BENCH("vec3", 1, vec3(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("vec3_assign", 1, vec3_assign(r, a));
+#endif
+#if defined(MATHC_USE_INT) && defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec3_assign_vec3i", 1, vec3_assign_vec3i(r, ia));
+#endif
+#if defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec3_zero", 1, vec3_zero(r));
+	BENCH("vec3_one", 1, vec3_one(r));
+	BENCH("vec3_sign", 1, vec3_sign(r, a));
+	BENCH("vec3_add", 1, vec3_add(r, a, b));
+	BENCH("vec3_add_f", 1, vec3_add_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec3_subtract", 1, vec3_subtract(r, a, b));
+	BENCH("vec3_subtract_f", 1, vec3_subtract_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec3_multiply", 1, vec3_multiply(r, a, b));
+	BENCH("vec3_multiply_f", 1, vec3_multiply_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec3_multiply_mat3", 1, vec3_multiply_mat3(r, a, b));
+	BENCH("vec3_multiply_mat3_nr", 1, vec3_multiply_mat3_nr(r, a, b));
+	BENCH("vec3_divide", 1, vec3_divide(r, a, b));
+	BENCH("vec3_divide_f", 1, vec3_divide_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec3_snap", 1, vec3_snap(r, a, b));
+	BENCH("vec3_snap_f", 1, vec3_snap_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec3_negative", 1, vec3_negative(r, a));
+	BENCH("vec3_abs", 1, vec3_abs(r, a));
+	BENCH("vec3_floor", 1, vec3_floor(r, a));
+	BENCH("vec3_ceil", 1, vec3_ceil(r, a));
+	BENCH("vec3_round", 1, vec3_round(r, a));
+	BENCH("vec3_max", 1, vec3_max(r, a, b));
+	BENCH("vec3_min", 1, vec3_min(r, a, b));
+	BENCH("vec3_clamp", 1, vec3_clamp(r, a, b, c));
+	BENCH("vec3_cross", 1, vec3_cross(r, a, b));
+	BENCH("vec3_cross_nr", 1, vec3_cross_nr(r, a, b));
+	BENCH("vec3_normalize", 1, vec3_normalize(r, a));
+	BENCH("vec3_normalize_fast", 1, vec3_normalize_fast(r, a));
+	BENCH("vec3_normalize_n_fast", BENCH_BATCH, vec3_normalize_n_fast(r, a, BENCH_BATCH));
+	BENCH("vec3_dot", 1, vec3_dot(a, b));
+	BENCH("vec3_project", 1, vec3_project(r, a, b));
+	BENCH("vec3_slide", 1, vec3_slide(r, a, b));
+	BENCH("vec3_reflect", 1, vec3_reflect(r, a, b));
+	BENCH("vec3_rotate", 1, vec3_rotate(r, a, b, MFLOAT_C(0.5)));
+	BENCH("vec3_rotate_quat", 1, vec3_rotate_quat(r, a, qa));
+	BENCH("vec3_lerp", 1, vec3_lerp(r, a, b, MFLOAT_C(0.5)));
+	BENCH("vec3_bilinear", 1, vec3_bilinear(r, a, b, c, d, MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("vec3_bezier3", 1, vec3_bezier3(r, a, b, c, MFLOAT_C(0.5)));
+	BENCH("vec3_bezier4", 1, vec3_bezier4(r, a, b, c, d, MFLOAT_C(0.5)));
+	BENCH("vec3_length", 1, vec3_length(a));
+	BENCH("vec3_length_squared", 1, vec3_length_squared(a));
+	BENCH("vec3_distance", 1, vec3_distance(a, b));
+	BENCH("vec3_distance_squared", 1, vec3_distance_squared(a, b));
+	BENCH("vec3_linear_independent", 1, vec3_linear_independent(a, b, c));
+	BENCH("vec3_orthonormalization", 1, vec3_orthonormalization(basis_r3, basis3));
+	BENCH("vec3_stream_add", BENCH_BATCH, vec3_stream_add(&stream_r, &stream_a, &stream_b));
+	BENCH("vec3_stream_add_f", BENCH_BATCH, vec3_stream_add_f(&stream_r, &stream_a, MFLOAT_C(0.5)));
+	BENCH("vec3_stream_subtract", BENCH_BATCH, vec3_stream_subtract(&stream_r, &stream_a, &stream_b));
+	BENCH("vec3_stream_subtract_f", BENCH_BATCH, vec3_stream_subtract_f(&stream_r, &stream_a, MFLOAT_C(0.5)));
+	BENCH("vec3_stream_multiply", BENCH_BATCH, vec3_stream_multiply(&stream_r, &stream_a, &stream_b));
+	BENCH("vec3_stream_multiply_f", BENCH_BATCH, vec3_stream_multiply_f(&stream_r, &stream_a, MFLOAT_C(0.5)));
+	BENCH("vec3_stream_divide", BENCH_BATCH, vec3_stream_divide(&stream_r, &stream_a, &stream_b));
+	BENCH("vec3_stream_divide_f", BENCH_BATCH, vec3_stream_divide_f(&stream_r, &stream_a, MFLOAT_C(0.5)));
+	BENCH("vec3_stream_negative", BENCH_BATCH, vec3_stream_negative(&stream_r, &stream_a));
+	BENCH("vec3_stream_abs", BENCH_BATCH, vec3_stream_abs(&stream_r, &stream_a));
+	BENCH("vec3_stream_max", BENCH_BATCH, vec3_stream_max(&stream_r, &stream_a, &stream_b));
+	BENCH("vec3_stream_min", BENCH_BATCH, vec3_stream_min(&stream_r, &stream_a, &stream_b));
+	BENCH("vec3_stream_clamp", BENCH_BATCH, vec3_stream_clamp(&stream_r, &stream_a, a, b));
+	BENCH("vec3_stream_cross", BENCH_BATCH, vec3_stream_cross(&stream_r, &stream_a, &stream_b));
+	BENCH("vec3_stream_normalize", BENCH_BATCH, vec3_stream_normalize(&stream_r, &stream_a));
+	BENCH("vec3_stream_normalize_fast", BENCH_BATCH, vec3_stream_normalize_fast(&stream_r, &stream_a));
+	BENCH("vec3_stream_lerp", BENCH_BATCH, vec3_stream_lerp(&stream_r, &stream_a, &stream_b, MFLOAT_C(0.5)));
+	BENCH("vec3_stream_dot", BENCH_BATCH, vec3_stream_dot(r, &stream_a, &stream_b));
+	BENCH("vec3_stream_length", BENCH_BATCH, vec3_stream_length(r, &stream_a));
+	BENCH("vec3_stream_length_squared", BENCH_BATCH, vec3_stream_length_squared(r, &stream_a));
+	BENCH("vec4_is_zero", 1, vec4_is_zero(a));
+	BENCH("vec4_is_equal", 1, vec4_is_equal(a, b));
+	BENCH("vec4", 1, vec4(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("vec4_assign", 1, vec4_assign(r, a));
+#endif
+#if defined(MATHC_USE_INT) && defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec4_assign_vec4i", 1, vec4_assign_vec4i(r, ia));
+#endif
+#if defined(MATHC_USE_FLOATING_POINT)
+	BENCH("vec4_zero", 1, vec4_zero(r));
+	BENCH("vec4_one", 1, vec4_one(r));
+	BENCH("vec4_sign", 1, vec4_sign(r, a));
+	BENCH("vec4_add", 1, vec4_add(r, a, b));
+	BENCH("vec4_add_f", 1, vec4_add_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec4_subtract", 1, vec4_subtract(r, a, b));
+	BENCH("vec4_subtract_f", 1, vec4_subtract_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec4_multiply", 1, vec4_multiply(r, a, b));
+	BENCH("vec4_multiply_f", 1, vec4_multiply_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec4_multiply_mat4", 1, vec4_multiply_mat4(r, a, b));
+	BENCH("vec4_multiply_mat4_nr", 1, vec4_multiply_mat4_nr(r, a, b));
+	BENCH("vec4_divide", 1, vec4_divide(r, a, b));
+	BENCH("vec4_divide_f", 1, vec4_divide_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec4_snap", 1, vec4_snap(r, a, b));
+	BENCH("vec4_snap_f", 1, vec4_snap_f(r, a, MFLOAT_C(0.5)));
+	BENCH("vec4_negative", 1, vec4_negative(r, a));
+	BENCH("vec4_abs", 1, vec4_abs(r, a));
+	BENCH("vec4_floor", 1, vec4_floor(r, a));
+	BENCH("vec4_ceil", 1, vec4_ceil(r, a));
+	BENCH("vec4_round", 1, vec4_round(r, a));
+	BENCH("vec4_max", 1, vec4_max(r, a, b));
+	BENCH("vec4_min", 1, vec4_min(r, a, b));
+	BENCH("vec4_clamp", 1, vec4_clamp(r, a, b, c));
+	BENCH("vec4_normalize", 1, vec4_normalize(r, a));
+	BENCH("vec4_normalize_fast", 1, vec4_normalize_fast(r, a));
+	BENCH("vec4_dot", 1, vec4_dot(a, b));
+	BENCH("vec4_lerp", 1, vec4_lerp(r, a, b, MFLOAT_C(0.5)));
+	BENCH("vec4_bilinear", 1, vec4_bilinear(r, a, b, c, d, MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("quat_is_zero", 1, quat_is_zero(qa));
+	BENCH("quat_is_equal", 1, quat_is_equal(qa, qb));
+	BENCH("quat", 1, quat(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("quat_assign", 1, quat_assign(r, qa));
+	BENCH("quat_zero", 1, quat_zero(r));
+	BENCH("quat_null", 1, quat_null(r));
+	BENCH("quat_multiply", 1, quat_multiply(r, qa, qb));
+	BENCH("quat_multiply_f", 1, quat_multiply_f(r, qa, MFLOAT_C(0.5)));
+	BENCH("quat_divide", 1, quat_divide(r, qa, qb));
+	BENCH("quat_divide_f", 1, quat_divide_f(r, qa, MFLOAT_C(0.5)));
+	BENCH("quat_negative", 1, quat_negative(r, qa));
+	BENCH("quat_conjugate", 1, quat_conjugate(r, qa));
+	BENCH("quat_inverse", 1, quat_inverse(r, qa));
+	BENCH("quat_normalize", 1, quat_normalize(r, qa));
+	BENCH("quat_normalize_fast", 1, quat_normalize_fast(r, qa));
+	BENCH("quat_normalize_n_fast", BENCH_BATCH, quat_normalize_n_fast(r, qa, BENCH_BATCH));
+	BENCH("quat_dot", 1, quat_dot(qa, qb));
+	BENCH("quat_power", 1, quat_power(r, qa, MFLOAT_C(0.5)));
+	BENCH("quat_from_axis_angle", 1, quat_from_axis_angle(r, a, MFLOAT_C(0.5)));
+	BENCH("quat_from_vec3", 1, quat_from_vec3(r, a, b));
+	BENCH("quat_from_mat4", 1, quat_from_mat4(r, a));
+	BENCH("quat_lerp", 1, quat_lerp(r, qa, qb, MFLOAT_C(0.5)));
+	BENCH("quat_slerp", 1, quat_slerp(r, qa, qb, MFLOAT_C(0.5)));
+	BENCH("quat_slerp_n", BENCH_BATCH, quat_slerp_n(r, qa, qb, MFLOAT_C(0.5), BENCH_BATCH));
+	BENCH("quat_slerp_n_fast", BENCH_BATCH, quat_slerp_n_fast(r, qa, qb, MFLOAT_C(0.5), BENCH_BATCH));
+	BENCH("quat_nlerp_n", BENCH_BATCH, quat_nlerp_n(r, qa, qb, MFLOAT_C(0.5), BENCH_BATCH));
+	BENCH("quat_length", 1, quat_length(qa));
+	BENCH("quat_length_squared", 1, quat_length_squared(qa));
+	BENCH("quat_angle", 1, quat_angle(qa, qb));
+	BENCH("trs", 1, trs(r, a, qa, b));
+	BENCH("trs_identity", 1, trs_identity(r));
+	BENCH("trs_assign", 1, trs_assign(r, a));
+	BENCH("trs_multiply", 1, trs_multiply(r, a, b));
+	BENCH("trs_inverse", 1, trs_inverse(r, a));
+	BENCH("trs_lerp", 1, trs_lerp(r, a, b, MFLOAT_C(0.5)));
+	BENCH("trs_transform_point", 1, trs_transform_point(r, a, b));
+	BENCH("mat2", 1, mat2(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("mat2_zero", 1, mat2_zero(r));
+	BENCH("mat2_identity", 1, mat2_identity(r));
+	BENCH("mat2_determinant", 1, mat2_determinant(a));
+	BENCH("mat2_assign", 1, mat2_assign(r, a));
+	BENCH("mat2_negative", 1, mat2_negative(r, a));
+	BENCH("mat2_transpose", 1, mat2_transpose(r, a));
+	BENCH("mat2_transpose_nr", 1, mat2_transpose_nr(r, a));
+	BENCH("mat2_cofactor", 1, mat2_cofactor(r, a));
+	BENCH("mat2_adjugate", 1, mat2_adjugate(r, a));
+	BENCH("mat2_multiply", 1, mat2_multiply(r, a, b));
+	BENCH("mat2_multiply_nr", 1, mat2_multiply_nr(r, a, b));
+	BENCH("mat2_multiply_f", 1, mat2_multiply_f(r, a, MFLOAT_C(0.5)));
+	BENCH("mat2_inverse", 1, mat2_inverse(r, a));
+	BENCH("mat2_scaling", 1, mat2_scaling(r, a));
+	BENCH("mat2_scale", 1, mat2_scale(r, a, b));
+	BENCH("mat2_rotation_z", 1, mat2_rotation_z(r, MFLOAT_C(0.5)));
+	BENCH("mat2_lerp", 1, mat2_lerp(r, a, b, MFLOAT_C(0.5)));
+	BENCH("mat3", 1, mat3(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("mat3_zero", 1, mat3_zero(r));
+	BENCH("mat3_identity", 1, mat3_identity(r));
+	BENCH("mat3_determinant", 1, mat3_determinant(a));
+	BENCH("mat3_assign", 1, mat3_assign(r, a));
+	BENCH("mat3_negative", 1, mat3_negative(r, a));
+	BENCH("mat3_transpose", 1, mat3_transpose(r, a));
+	BENCH("mat3_transpose_nr", 1, mat3_transpose_nr(r, a));
+	BENCH("mat3_cofactor", 1, mat3_cofactor(r, a));
+	BENCH("mat3_multiply", 1, mat3_multiply(r, a, b));
+	BENCH("mat3_multiply_nr", 1, mat3_multiply_nr(r, a, b));
+	BENCH("mat3_multiply_f", 1, mat3_multiply_f(r, a, MFLOAT_C(0.5)));
+	BENCH("mat3_inverse", 1, mat3_inverse(r, a));
+	BENCH("mat3_scaling", 1, mat3_scaling(r, a));
+	BENCH("mat3_scale", 1, mat3_scale(r, a, b));
+	BENCH("mat3_rotation_x", 1, mat3_rotation_x(r, MFLOAT_C(0.5)));
+	BENCH("mat3_rotation_y", 1, mat3_rotation_y(r, MFLOAT_C(0.5)));
+	BENCH("mat3_rotation_z", 1, mat3_rotation_z(r, MFLOAT_C(0.5)));
+	BENCH("mat3_rotation_axis", 1, mat3_rotation_axis(r, a, MFLOAT_C(0.5)));
+	BENCH("mat3_rotation_quat", 1, mat3_rotation_quat(r, qa));
+	BENCH("mat3_lerp", 1, mat3_lerp(r, a, b, MFLOAT_C(0.5)));
+	BENCH("mat3_to_std140", 1, mat3_to_std140(r, a));
+	BENCH("mat3_from_std140", 1, mat3_from_std140(r, a));
+	BENCH("mat3_to_std140_n", BENCH_BATCH, mat3_to_std140_n(r, a, BENCH_BATCH, 0));
+	BENCH("mat4", 1, mat4(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("mat4_zero", 1, mat4_zero(r));
+	BENCH("mat4_identity", 1, mat4_identity(r));
+	BENCH("mat4_determinant", 1, mat4_determinant(a));
+	BENCH("mat4_assign", 1, mat4_assign(r, a));
+	BENCH("mat4_negative", 1, mat4_negative(r, a));
+	BENCH("mat4_transpose", 1, mat4_transpose(r, a));
+	BENCH("mat4_transpose_nr", 1, mat4_transpose_nr(r, a));
+	BENCH("mat4_cofactor", 1, mat4_cofactor(r, a));
+	BENCH("mat4_rotation_x", 1, mat4_rotation_x(r, MFLOAT_C(0.5)));
+	BENCH("mat4_rotation_y", 1, mat4_rotation_y(r, MFLOAT_C(0.5)));
+	BENCH("mat4_rotation_z", 1, mat4_rotation_z(r, MFLOAT_C(0.5)));
+	BENCH("mat4_rotation_axis", 1, mat4_rotation_axis(r, a, MFLOAT_C(0.5)));
+	BENCH("mat4_rotation_quat", 1, mat4_rotation_quat(r, qa));
+	BENCH("mat4_from_trs", 1, mat4_from_trs(r, a));
+	BENCH("mat4_translation", 1, mat4_translation(r, a, b));
+	BENCH("mat4_translate", 1, mat4_translate(r, a, b));
+	BENCH("mat4_scaling", 1, mat4_scaling(r, a, b));
+	BENCH("mat4_scale", 1, mat4_scale(r, a, b));
+	BENCH("mat4_multiply", 1, mat4_multiply(r, a, b));
+	BENCH("mat4_multiply_nr", 1, mat4_multiply_nr(r, a, b));
+	BENCH("mat4_multiply_affine", 1, mat4_multiply_affine(r, a, b));
+	BENCH("mat4_multiply_n", BENCH_BATCH, mat4_multiply_n(r, a, b, BENCH_BATCH));
+	BENCH("mat4_multiply_n_left", BENCH_BATCH, mat4_multiply_n_left(r, a, b, BENCH_BATCH));
+	BENCH("mat4_multiply_n_right", BENCH_BATCH, mat4_multiply_n_right(r, a, b, BENCH_BATCH));
+	BENCH("mat4_multiply_soa", BENCH_BATCH, mat4_multiply_soa(soa_r, soa_a, soa_b, BENCH_BATCH));
+	BENCH("mat4_transform_points", BENCH_BATCH, mat4_transform_points(r, a, BENCH_BATCH, 0, b));
+	BENCH("mat4_transform_directions", BENCH_BATCH, mat4_transform_directions(r, a, BENCH_BATCH, 0, b));
+	BENCH("mat4_multiply_f", 1, mat4_multiply_f(r, a, MFLOAT_C(0.5)));
+	BENCH("mat4_inverse", 1, mat4_inverse(r, a));
+	BENCH("mat4_inverse_affine", 1, mat4_inverse_affine(r, a));
+	BENCH("mat4_inverse_rigid", 1, mat4_inverse_rigid(r, a));
+	BENCH("mat4_lerp", 1, mat4_lerp(r, a, b, MFLOAT_C(0.5)));
+	BENCH("mat4_look_at", 1, mat4_look_at(r, a, b, c));
+	BENCH("mat4_ortho", 1, mat4_ortho(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("mat4_perspective", 1, mat4_perspective(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("mat4_perspective_fov", 1, mat4_perspective_fov(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("mat4_perspective_infinite", 1, mat4_perspective_infinite(r, MFLOAT_C(0.5), MFLOAT_C(0.5), MFLOAT_C(0.5)));
+	BENCH("mat4_hierarchy_set_local", 1, mat4_hierarchy_set_local(&hierarchy, 0, a));
+	BENCH("mat4_hierarchy_update", BENCH_BATCH, (hierarchy.dirty[0] = true, mat4_hierarchy_update(&hierarchy)));
+	BENCH("frustum_from_mat4", 1, frustum_from_mat4(r, a));
+	BENCH("frustum_intersects_sphere", 1, frustum_intersects_sphere(a, b, MFLOAT_C(0.5)));
+	BENCH("frustum_intersects_aabb", 1, frustum_intersects_aabb(a, b, c));
+	BENCH("frustum_intersects_sphere_n", BENCH_BATCH, frustum_intersects_sphere_n(mask, a, b, BENCH_BATCH));
+	BENCH("frustum_intersects_aabb_n", BENCH_BATCH, frustum_intersects_aabb_n(mask, a, b, c, BENCH_BATCH));
+	BENCH("frustum_intersects_sphere_stream", BENCH_BATCH, frustum_intersects_sphere_stream(mask, a, &stream_a, b));
+	BENCH("frustum_intersects_aabb_stream", BENCH_BATCH, frustum_intersects_aabb_stream(mask, a, &stream_a, &stream_b));
+	BENCH("ray_intersect_triangle", 1, ray_intersect_triangle(r, a, b, c, d, e));
+	BENCH("ray_intersect_aabb", 1, ray_intersect_aabb(r, a, b, c, d));
+	BENCH("ray_intersect_sphere", 1, ray_intersect_sphere(r, a, b, c, MFLOAT_C(0.5)));
+	BENCH("ray_intersect_plane", 1, ray_intersect_plane(r, a, b, c));
+	BENCH("ray_intersect_triangle_packet", BENCH_PACKET, ray_intersect_triangle_packet(r, &packet_a, &packet_b, a, b, c));
+	BENCH("ray_intersect_aabb_packet", BENCH_PACKET, ray_intersect_aabb_packet(r, &packet_a, &packet_b, a, b));
+	BENCH("ray_intersect_sphere_packet", BENCH_PACKET, ray_intersect_sphere_packet(r, &packet_a, &packet_b, a, MFLOAT_C(0.5)));
+	BENCH("ray_intersect_plane_packet", BENCH_PACKET, ray_intersect_plane_packet(r, &packet_a, &packet_b, a));
+	BENCH("bvh_build", BENCH_BATCH, bvh_build(&bvh, a, b, BENCH_BATCH));
+	BENCH("bvh_build_triangles", BENCH_BATCH, bvh_build_triangles(&bvh, a, BENCH_BATCH));
+	BENCH("bvh_intersect_ray", 1, (r[0] = MFLOAT_C(1000.0), bvh_intersect_ray(r, &bvh, a, b, bench_bvh_hit, a)));
+	BENCH("bvh_intersect_ray_triangles", 1, (r[0] = MFLOAT_C(1000.0), bvh_intersect_ray_triangles(r, &bvh, a, b, c)));
+	BENCH("bvh_query_frustum", 1, bvh_query_frustum(&bvh, a, bench_bvh_visit, a));
+	BENCH("aligned_buffer", 1, aligned_buffer(&buffer, r, sizeof(r), 64, MAT4_SIZE * sizeof(mfloat_t)));
+	BENCH("aligned_buffer_at", 1, aligned_buffer_at(&buffer, 3));
+	BENCH("aligned_buffer_size", 1, aligned_buffer_size(&buffer, 3));
+	BENCH("mat4_skin_points", BENCH_BATCH, mat4_skin_points(r, a, BENCH_BATCH, 0, bones, b, c));
+	BENCH("mat4_skin_stream", BENCH_BATCH, mat4_skin_stream(&stream_r, &stream_a, bones, a, b));
+	BENCH("dualquat_from_quat_vec3", 1, dualquat_from_quat_vec3(r, qa, a));
+	BENCH("dualquat_from_mat4", 1, dualquat_from_mat4(r, a));
+	BENCH("dualquat_skin_points", BENCH_BATCH, dualquat_skin_points(r, a, BENCH_BATCH, 0, bones, b, c));
+	BENCH("dualquat_skin_stream", BENCH_BATCH, dualquat_skin_stream(&stream_r, &stream_a, bones, a, b));
+	BENCH("animation_track_sample", 1, animation_track_sample(r, tracks, MFLOAT_C(0.5)));
+	BENCH("animation_track_sample_n", BENCH_BATCH, animation_track_sample_n(r, tracks, BENCH_BATCH, MFLOAT_C(0.5)));
+	BENCH("quat_encode_32", 1, quat_encode_32(mask, qa));
+	BENCH("quat_decode_32", 1, quat_decode_32(r, mask));
+	BENCH("quat_encode_32_n", BENCH_BATCH, quat_encode_32_n(mask, qa, BENCH_BATCH));
+	BENCH("quat_decode_32_n", BENCH_BATCH, quat_decode_32_n(r, mask, BENCH_BATCH));
+	BENCH("quat_encode_48", 1, quat_encode_48(packed, qa));
+	BENCH("quat_decode_48", 1, quat_decode_48(r, packed));
+	BENCH("quat_encode_48_n", BENCH_BATCH, quat_encode_48_n(packed, qa, BENCH_BATCH));
+	BENCH("quat_decode_48_n", BENCH_BATCH, quat_decode_48_n(r, packed, BENCH_BATCH));
+	BENCH("vec3_encode_half", 1, vec3_encode_half(packed, a));
+	BENCH("vec3_decode_half", 1, vec3_decode_half(r, packed));
+	BENCH("vec3_encode_half_n", BENCH_BATCH, vec3_encode_half_n(packed, a, BENCH_BATCH));
+	BENCH("vec3_decode_half_n", BENCH_BATCH, vec3_decode_half_n(r, packed, BENCH_BATCH));
+	BENCH("vec3_encode_range", 1, vec3_encode_range(packed, a, b, c));
+	BENCH("vec3_decode_range", 1, vec3_decode_range(r, packed, a, b));
+	BENCH("vec3_encode_range_n", BENCH_BATCH, vec3_encode_range_n(packed, a, b, c, BENCH_BATCH));
+	BENCH("vec3_decode_range_n", BENCH_BATCH, vec3_decode_range_n(r, packed, a, b, BENCH_BATCH));
+	BENCH("half_encode_n", BENCH_BATCH, half_encode_n(packed, a, BENCH_BATCH));
+	BENCH("half_decode_n", BENCH_BATCH, half_decode_n(r, packed, BENCH_BATCH));
+	BENCH("bfloat16_encode_n", BENCH_BATCH, bfloat16_encode_n(packed, a, BENCH_BATCH));
+	BENCH("bfloat16_decode_n", BENCH_BATCH, bfloat16_decode_n(r, packed, BENCH_BATCH));
+	BENCH("mat4_transform_points_half", BENCH_BATCH, mat4_transform_points_half(r, packed, BENCH_BATCH, 0, a));
+#endif
+#if defined(MATHC_USE_EASING_FUNCTIONS)
+	BENCH("quadratic_ease_out", 1, quadratic_ease_out(MFLOAT_C(0.5)));
+	BENCH("quadratic_ease_out_n", BENCH_BATCH, quadratic_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("quadratic_ease_in", 1, quadratic_ease_in(MFLOAT_C(0.5)));
+	BENCH("quadratic_ease_in_n", BENCH_BATCH, quadratic_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("quadratic_ease_in_out", 1, quadratic_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("quadratic_ease_in_out_n", BENCH_BATCH, quadratic_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("cubic_ease_out", 1, cubic_ease_out(MFLOAT_C(0.5)));
+	BENCH("cubic_ease_out_n", BENCH_BATCH, cubic_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("cubic_ease_in", 1, cubic_ease_in(MFLOAT_C(0.5)));
+	BENCH("cubic_ease_in_n", BENCH_BATCH, cubic_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("cubic_ease_in_out", 1, cubic_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("cubic_ease_in_out_n", BENCH_BATCH, cubic_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("quartic_ease_out", 1, quartic_ease_out(MFLOAT_C(0.5)));
+	BENCH("quartic_ease_out_n", BENCH_BATCH, quartic_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("quartic_ease_in", 1, quartic_ease_in(MFLOAT_C(0.5)));
+	BENCH("quartic_ease_in_n", BENCH_BATCH, quartic_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("quartic_ease_in_out", 1, quartic_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("quartic_ease_in_out_n", BENCH_BATCH, quartic_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("quintic_ease_out", 1, quintic_ease_out(MFLOAT_C(0.5)));
+	BENCH("quintic_ease_out_n", BENCH_BATCH, quintic_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("quintic_ease_in", 1, quintic_ease_in(MFLOAT_C(0.5)));
+	BENCH("quintic_ease_in_n", BENCH_BATCH, quintic_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("quintic_ease_in_out", 1, quintic_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("quintic_ease_in_out_n", BENCH_BATCH, quintic_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("sine_ease_out", 1, sine_ease_out(MFLOAT_C(0.5)));
+	BENCH("sine_ease_out_n", BENCH_BATCH, sine_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("sine_ease_in", 1, sine_ease_in(MFLOAT_C(0.5)));
+	BENCH("sine_ease_in_n", BENCH_BATCH, sine_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("sine_ease_in_out", 1, sine_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("sine_ease_in_out_n", BENCH_BATCH, sine_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("circular_ease_out", 1, circular_ease_out(MFLOAT_C(0.5)));
+	BENCH("circular_ease_out_n", BENCH_BATCH, circular_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("circular_ease_in", 1, circular_ease_in(MFLOAT_C(0.5)));
+	BENCH("circular_ease_in_n", BENCH_BATCH, circular_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("circular_ease_in_out", 1, circular_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("circular_ease_in_out_n", BENCH_BATCH, circular_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("exponential_ease_out", 1, exponential_ease_out(MFLOAT_C(0.5)));
+	BENCH("exponential_ease_out_n", BENCH_BATCH, exponential_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("exponential_ease_in", 1, exponential_ease_in(MFLOAT_C(0.5)));
+	BENCH("exponential_ease_in_n", BENCH_BATCH, exponential_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("exponential_ease_in_out", 1, exponential_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("exponential_ease_in_out_n", BENCH_BATCH, exponential_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("elastic_ease_out", 1, elastic_ease_out(MFLOAT_C(0.5)));
+	BENCH("elastic_ease_out_n", BENCH_BATCH, elastic_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("elastic_ease_in", 1, elastic_ease_in(MFLOAT_C(0.5)));
+	BENCH("elastic_ease_in_n", BENCH_BATCH, elastic_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("elastic_ease_in_out", 1, elastic_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("elastic_ease_in_out_n", BENCH_BATCH, elastic_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("back_ease_out", 1, back_ease_out(MFLOAT_C(0.5)));
+	BENCH("back_ease_out_n", BENCH_BATCH, back_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("back_ease_in", 1, back_ease_in(MFLOAT_C(0.5)));
+	BENCH("back_ease_in_n", BENCH_BATCH, back_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("back_ease_in_out", 1, back_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("back_ease_in_out_n", BENCH_BATCH, back_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("bounce_ease_out", 1, bounce_ease_out(MFLOAT_C(0.5)));
+	BENCH("bounce_ease_out_n", BENCH_BATCH, bounce_ease_out_n(r, a, BENCH_BATCH));
+	BENCH("bounce_ease_in", 1, bounce_ease_in(MFLOAT_C(0.5)));
+	BENCH("bounce_ease_in_n", BENCH_BATCH, bounce_ease_in_n(r, a, BENCH_BATCH));
+	BENCH("bounce_ease_in_out", 1, bounce_ease_in_out(MFLOAT_C(0.5)));
+	BENCH("bounce_ease_in_out_n", BENCH_BATCH, bounce_ease_in_out_n(r, a, BENCH_BATCH));
+	BENCH("ease_table", BENCH_BATCH, ease_table(&ease, sine_ease_out, ease_values, BENCH_BATCH, true));
+	BENCH("ease_table_sample", 1, ease_table_sample(&ease, MFLOAT_C(0.5)));
+	BENCH("ease_table_sample_n", BENCH_BATCH, ease_table_sample_n(r, &ease, a, BENCH_BATCH));
+#endif
+}
+
+int main(int argc, char **argv)
+{
+	int i;
+	bool header = true;
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0) {
+			bench_json = true;
+		} else if (strcmp(argv[i], "--no-header") == 0) {
+			header = false;
+		} else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			bench_filter = argv[++i];
+		} else {
+			fprintf(stderr, "usage: %s [--json] [--no-header] [--filter substring]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (header && !bench_json) {
+		printf("function,precision,count,iterations,ns_per_op,ops_per_sec\n");
+	}
+	bench_reset();
+	bench_all();
+	return 0;
+}
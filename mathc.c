@@ -21,8 +21,899 @@ the following restrictions:
 
 #include "mathc.h"
 
+/* Number of elements processed at a time by the vec3_stream functions that need temporaries */
+#define MATHC_STREAM_CHUNK 64
+/* Number of elements tested at a time by the functions that write a bitmask, one bit each */
+#define MATHC_MASK_BITS 32
+/* Number of bins tried on each axis when building a struct bvh */
+#define MATHC_BVH_BINS 16
+/* Largest number of primitives a struct bvh leaf holds when splitting it doesn't pay off */
+#define MATHC_BVH_LEAF_SIZE 4
+/* Depth after which struct bvh nodes are halved instead of split by area, so the
+ * depth stays below the size of the traversal stacks */
+#define MATHC_BVH_SAH_DEPTH 32
+#define MATHC_BVH_STACK_SIZE 64
+/* Largest |x| that mathc_sin(), mathc_cos() and mathc_sincos() reduce accurately */
+#define MATHC_FAST_TRIG_RANGE MFLOAT_C(1.0e5)
+
+#if defined(MATHC_SSE)
+#if defined(__FMA__) || defined(__F16C__)
+#include <immintrin.h>
+#else
+#include <xmmintrin.h>
+#endif
+#if defined(__FMA__)
+#define MATHC_SSE_MADD(a, b, c) _mm_fmadd_ps(a, b, c)
+#else
+#define MATHC_SSE_MADD(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c)
+#endif
+#if defined(__F16C__)
+#define MATHC_F16C
+#endif
+/* Products of 2x2 matrices packed in one register, used by mat4_inverse() */
+#define MATHC_SSE_MAT2_MULTIPLY(a, b) _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))), \
+	_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))))
+#define MATHC_SSE_MAT2_ADJ_MULTIPLY(a, b) _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b), \
+	_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))))
+#define MATHC_SSE_MAT2_MULTIPLY_ADJ(a, b) _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))), \
+	_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))))
+#endif
+
+#if defined(MATHC_USE_FLOATING_POINT)
+/* Polynomial approximations used by the _fast functions, with no branches so
+ * that loops calling them vectorize. MATHC_FAST_ACCURACY selects the tier */
+static mfloat_t mathc_fast_acos_polynomial(mfloat_t x)
+{
+	/* Arc cosine for x in [0, 1] divided by sqrt(1 - x), from Abramowitz and
+	 * Stegun 4.4.45 and 4.4.46 */
+#if MATHC_FAST_ACCURACY <= 4
+	return MFLOAT_C(1.5707288) + x * (MFLOAT_C(-0.2121144) + x * (MFLOAT_C(0.0742610) + x * MFLOAT_C(-0.0187293)));
+#else
+	return MFLOAT_C(1.5707963050) + x * (MFLOAT_C(-0.2145988016) + x * (MFLOAT_C(0.0889789874) + x * (MFLOAT_C(-0.0501743046)
+		+ x * (MFLOAT_C(0.0308918810) + x * (MFLOAT_C(-0.0170881256) + x * (MFLOAT_C(0.0066700901) + x * MFLOAT_C(-0.0012624911)))))));
+#endif
+}
+
+static mfloat_t mathc_fast_acos_unit(mfloat_t x)
+{
+	/* 1 - x is exact and positive up to 1, above which the square root
+	 * gives NaN like acos() */
+	return MSQRT(MFLOAT_C(1.0) - x) * mathc_fast_acos_polynomial(x);
+}
+
+static mfloat_t mathc_fast_sin_half_pi(mfloat_t x)
+{
+	/* Sine for x in [-pi/2, pi/2], with odd polynomials minimizing the
+	 * relative error, so that ratios of small sines stay accurate */
+	mfloat_t x2 = x * x;
+#if MATHC_FAST_ACCURACY <= 4
+	return x * (MFLOAT_C(0.99989182126) + x2 * (MFLOAT_C(-0.16596011654) + x2 * MFLOAT_C(0.0076029033434)));
+#else
+	return x * (MFLOAT_C(0.99999906090) + x2 * (MFLOAT_C(-0.16665554093) + x2 * (MFLOAT_C(0.0083118998014) + x2 * MFLOAT_C(-0.00018488140289))));
+#endif
+}
+
+static mfloat_t mathc_fast_sin_quarter_pi(mfloat_t x)
+{
+	/* Sine for x in [-pi/4, pi/4], with minimax odd polynomials */
+	mfloat_t x2 = x * x;
+#if MATHC_FAST_ACCURACY <= 4
+	return x * (MFLOAT_C(0.99999499756) + x2 * (MFLOAT_C(-0.16660161988) + x2 * MFLOAT_C(0.0081215579246)));
+#else
+	return x * (MFLOAT_C(0.99999999846) + x2 * (MFLOAT_C(-0.16666653424) + x2 * (MFLOAT_C(0.0083320846384) + x2 * MFLOAT_C(-0.00019503948393))));
+#endif
+}
+
+static mfloat_t mathc_fast_cos_quarter_pi(mfloat_t x)
+{
+	/* Cosine for x in [-pi/4, pi/4], with minimax even polynomials */
+	mfloat_t x2 = x * x;
+#if MATHC_FAST_ACCURACY <= 4
+	return MFLOAT_C(0.99999003496) + x2 * (MFLOAT_C(-0.49970814036) + x2 * MFLOAT_C(0.040398535969));
+#else
+	return MFLOAT_C(0.99999997242) + x2 * (MFLOAT_C(-0.49999856696) + x2 * (MFLOAT_C(0.041655026884) + x2 * MFLOAT_C(-0.0013585908511)));
+#endif
+}
+
+static mfloat_t mathc_fast_atan_unit(mfloat_t x)
+{
+	/* Arc tangent for x in [-1, 1], with minimax odd polynomials */
+	mfloat_t x2 = x * x;
+#if MATHC_FAST_ACCURACY <= 4
+	return x * (MFLOAT_C(0.99921381257) + x2 * (MFLOAT_C(-0.32117496931) + x2 * (MFLOAT_C(0.14626446359) + x2 * MFLOAT_C(-0.038986514159))));
+#else
+	return x * (MFLOAT_C(0.99999611155) + x2 * (MFLOAT_C(-0.33317368055) + x2 * (MFLOAT_C(0.19807815565) + x2 * (MFLOAT_C(-0.13233342096)
+		+ x2 * (MFLOAT_C(0.079623672365) + x2 * (MFLOAT_C(-0.033604220565) + x2 * MFLOAT_C(0.0068117932908)))))));
+#endif
+}
+
+static mfloat_t mathc_fast_reduce_quarter_pi(mfloat_t x, unsigned int *quadrant)
+{
+	/* Subtract the nearest multiple of pi/2, split in three constants so the
+	 * remainder keeps its precision. The first two have 8 significant bits,
+	 * so their products with multiples up to 2^16 are exact, which covers
+	 * |x| < MATHC_FAST_TRIG_RANGE. Larger values are clamped, which keeps the
+	 * conversion to int defined, and x - x turns infinities and NaN into NaN.
+	 * The quadrant is the multiple modulo 4, taken on the unsigned value so
+	 * negative multiples need no shift of a negative int */
+	mfloat_t clamped = MFABS(x) < MATHC_FAST_TRIG_RANGE ? x : MCOPYSIGN(MATHC_FAST_TRIG_RANGE, x);
+	int nearest = (int)(clamped * MFLOAT_C(0.63661977236758134308) + MCOPYSIGN(MFLOAT_C(0.5), clamped));
+	mfloat_t k = (mfloat_t)nearest;
+	*quadrant = (unsigned int)nearest & 3u;
+	return ((clamped - k * MFLOAT_C(1.5703125)) - k * MFLOAT_C(4.84466552734375e-4)) - k * MFLOAT_C(-6.3975783775576867831e-7) + (x - x);
+}
+
+static mfloat_t mathc_fast_rsqrt(mfloat_t x)
+{
+	/* Reciprocal square root of one value, from the hardware estimate refined
+	 * by a Newton-Raphson step. Without one, a square root and a division
+	 * are faster than the bit trick of mathc_fast_rsqrt_n() */
+#if defined(MATHC_SSE)
+	mfloat_t y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+	return y * (MFLOAT_C(1.5) - MFLOAT_C(0.5) * x * y * y);
+#else
+	return MFLOAT_C(1.0) / MSQRT(x);
+#endif
+}
+
+static void mathc_fast_rsqrt_n(mfloat_t *values, size_t count)
+{
+	size_t i = 0;
+#if defined(MATHC_SSE)
+	for (; i + 4 <= count; i += 4) {
+		__m128 x = _mm_loadu_ps(values + i);
+		__m128 y = _mm_rsqrt_ps(x);
+		__m128 xyy = _mm_mul_ps(_mm_mul_ps(x, y), y);
+		y = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_set1_ps(0.5f), xyy)));
+		_mm_storeu_ps(values + i, y);
+	}
+#elif defined(MATHC_USE_SINGLE_FLOATING_POINT) && !defined(MATHC_FLOATING_POINT_TYPE)
+	/* An estimate from the bit pattern refined by Newton-Raphson steps. Unlike
+	 * square roots, which may set errno, this loop vectorizes */
+	for (; i < count; i++) {
+		union {
+			float f;
+			uint32_t i;
+		} bits;
+		mfloat_t x = values[i];
+		mfloat_t y;
+		bits.f = x;
+		bits.i = UINT32_C(0x5f375a86) - (bits.i >> 1);
+		y = bits.f;
+		y = y * (MFLOAT_C(1.5) - MFLOAT_C(0.5) * x * y * y);
+		y = y * (MFLOAT_C(1.5) - MFLOAT_C(0.5) * x * y * y);
+#if MATHC_FAST_ACCURACY > 4
+		y = y * (MFLOAT_C(1.5) - MFLOAT_C(0.5) * x * y * y);
+#endif
+		values[i] = y;
+	}
+#endif
+	for (; i < count; i++) {
+		values[i] = mathc_fast_rsqrt(values[i]);
+	}
+}
+
+static uint32_t mathc_mask_not_negative(mfloat_t *distance, size_t count)
+{
+	/* Bit i is set when distance[i] is zero or positive */
+	uint32_t mask = 0;
+	size_t i = 0;
+#if defined(MATHC_SSE)
+	for (; i + 4 <= count; i += 4) {
+		__m128 d = _mm_loadu_ps(distance + i);
+		mask |= (uint32_t)_mm_movemask_ps(_mm_cmpge_ps(d, _mm_setzero_ps())) << i;
+	}
+#endif
+	for (; i < count; i++) {
+		mask |= (uint32_t)(distance[i] >= MFLOAT_C(0.0)) << i;
+	}
+	return mask;
+}
+
+static uint32_t mathc_frustum_spheres(mfloat_t *f0, mfloat_t *x, mfloat_t *y, mfloat_t *z, mfloat_t *radius, size_t count)
+{
+	/* Smallest signed distance to the six planes, one plane at a time so
+	 * every loop vectorizes */
+	mfloat_t distance[MATHC_MASK_BITS];
+	size_t i;
+	int j;
+	for (j = 0; j < 6; j++) {
+		mfloat_t a = f0[j * VEC4_SIZE];
+		mfloat_t b = f0[j * VEC4_SIZE + 1];
+		mfloat_t c = f0[j * VEC4_SIZE + 2];
+		mfloat_t w = f0[j * VEC4_SIZE + 3];
+		for (i = 0; i < count; i++) {
+			mfloat_t d = a * x[i] + b * y[i] + c * z[i] + w;
+			distance[i] = j == 0 || d < distance[i] ? d : distance[i];
+		}
+	}
+	for (i = 0; i < count; i++) {
+		distance[i] = distance[i] + radius[i];
+	}
+	return mathc_mask_not_negative(distance, count);
+}
+
+static uint32_t mathc_frustum_aabbs(mfloat_t *f0, mfloat_t *min_x, mfloat_t *min_y, mfloat_t *min_z, mfloat_t *max_x, mfloat_t *max_y, mfloat_t *max_z, size_t count)
+{
+	/* Signed distance of the corner furthest along each plane normal, from
+	 * the center and half extents so there is no select per component */
+	mfloat_t distance[MATHC_MASK_BITS];
+	size_t i;
+	int j;
+	for (j = 0; j < 6; j++) {
+		mfloat_t a = f0[j * VEC4_SIZE] * MFLOAT_C(0.5);
+		mfloat_t b = f0[j * VEC4_SIZE + 1] * MFLOAT_C(0.5);
+		mfloat_t c = f0[j * VEC4_SIZE + 2] * MFLOAT_C(0.5);
+		mfloat_t w = f0[j * VEC4_SIZE + 3];
+		mfloat_t abs_a = MFABS(a);
+		mfloat_t abs_b = MFABS(b);
+		mfloat_t abs_c = MFABS(c);
+		for (i = 0; i < count; i++) {
+			mfloat_t d = a * (min_x[i] + max_x[i]) + b * (min_y[i] + max_y[i]) + c * (min_z[i] + max_z[i]) + w
+				+ abs_a * (max_x[i] - min_x[i]) + abs_b * (max_y[i] - min_y[i]) + abs_c * (max_z[i] - min_z[i]);
+			distance[i] = j == 0 || d < distance[i] ? d : distance[i];
+		}
+	}
+	return mathc_mask_not_negative(distance, count);
+}
+
+static uint32_t mathc_ray_packet_hits(mfloat_t *result, mfloat_t *distance, mfloat_t *margin, size_t count)
+{
+	/* Keeps the distances whose margin isn't negative. The select gets a loop
+	 * of its own, since next to the comparisons of the margin it doesn't vectorize */
+	size_t i;
+	for (i = 0; i < count; i++) {
+		mfloat_t closest = result[i];
+		mfloat_t d = distance[i];
+		result[i] = margin[i] >= MFLOAT_C(0.0) ? d : closest;
+	}
+	return mathc_mask_not_negative(margin, count);
+}
+
+/* Primitives a struct bvh is built from: triangles if not NULL, boxes otherwise */
+struct mathc_bvh_source {
+	mfloat_t *min;
+	mfloat_t *max;
+	mfloat_t *triangles;
+};
+
+static void mathc_bvh_bounds(struct mathc_bvh_source *source, int index, mfloat_t *min, mfloat_t *max)
+{
+	int i;
+	if (source->triangles != NULL) {
+		mfloat_t *t = source->triangles + (size_t)index * VEC3_SIZE * 3;
+		for (i = 0; i < 3; i++) {
+			min[i] = t[i] < t[3 + i] ? t[i] : t[3 + i];
+			min[i] = t[6 + i] < min[i] ? t[6 + i] : min[i];
+			max[i] = t[i] > t[3 + i] ? t[i] : t[3 + i];
+			max[i] = t[6 + i] > max[i] ? t[6 + i] : max[i];
+		}
+	} else {
+		for (i = 0; i < 3; i++) {
+			min[i] = source->min[(size_t)index * VEC3_SIZE + i];
+			max[i] = source->max[(size_t)index * VEC3_SIZE + i];
+		}
+	}
+}
+
+static void mathc_bvh_grow(mfloat_t *min, mfloat_t *max, mfloat_t *v0, mfloat_t *v1)
+{
+	int i;
+	for (i = 0; i < 3; i++) {
+		min[i] = v0[i] < min[i] ? v0[i] : min[i];
+		max[i] = v1[i] > max[i] ? v1[i] : max[i];
+	}
+}
+
+static mfloat_t mathc_bvh_half_area(mfloat_t *min, mfloat_t *max)
+{
+	mfloat_t x = max[0] - min[0];
+	mfloat_t y = max[1] - min[1];
+	mfloat_t z = max[2] - min[2];
+	return x * y + y * z + z * x;
+}
+
+static int mathc_bvh_bin(mfloat_t centroid, mfloat_t minimum, mfloat_t scale, int bins)
+{
+	int bin = (int)((centroid - minimum) * scale);
+	return bin < bins - 1 ? bin : bins - 1;
+}
+
+static void mathc_bvh_node_bounds(struct bvh *result, struct mathc_bvh_source *source, struct bvh_node *node)
+{
+	mfloat_t min[VEC3_SIZE];
+	mfloat_t max[VEC3_SIZE];
+	int i;
+	for (i = 0; i < node->count; i++) {
+		mathc_bvh_bounds(source, result->indices[node->first + i], min, max);
+		if (i == 0) {
+			vec3_assign(node->min, min);
+			vec3_assign(node->max, max);
+		} else {
+			mathc_bvh_grow(node->min, node->max, min, max);
+		}
+	}
+}
+
+static void mathc_bvh_split(struct bvh *result, struct mathc_bvh_source *source, size_t index, int depth)
+{
+	struct bvh_node *node = result->nodes + index;
+	/* Free slots for the children, since a node with two primitives or more
+	 * always leaves room for two more nodes */
+	struct bvh_node *left = result->nodes + result->node_count;
+	struct bvh_node *right = left + 1;
+	int *indices = result->indices + node->first;
+	int count = node->count;
+	/* Small nodes don't need more bins than primitives */
+	int bins = count < MATHC_BVH_BINS ? count : MATHC_BVH_BINS;
+	mfloat_t bin_min[3][MATHC_BVH_BINS][VEC3_SIZE];
+	mfloat_t bin_max[3][MATHC_BVH_BINS][VEC3_SIZE];
+	int bin_count[3][MATHC_BVH_BINS];
+	mfloat_t right_min[MATHC_BVH_BINS][VEC3_SIZE];
+	mfloat_t right_max[MATHC_BVH_BINS][VEC3_SIZE];
+	int right_count[MATHC_BVH_BINS];
+	mfloat_t scale[VEC3_SIZE];
+	mfloat_t min[VEC3_SIZE];
+	mfloat_t max[VEC3_SIZE];
+	mfloat_t best_cost = MFLOAT_C(0.0);
+	int best_axis = -1;
+	int best_split = 0;
+	int left_count = 0;
+	int axis;
+	int i;
+	int j;
+	if (count <= 1) {
+		return;
+	}
+	/* Surface area heuristic, evaluated at the boundaries between bins. The
+	 * bins span the bounds of the node, which hold every centroid */
+	if (depth < MATHC_BVH_SAH_DEPTH) {
+		for (axis = 0; axis < 3; axis++) {
+			mfloat_t extent = node->max[axis] - node->min[axis];
+			scale[axis] = extent > MFLOAT_C(0.0) ? (mfloat_t)bins * (MFLOAT_C(1.0) - MFLT_EPSILON) / extent : MFLOAT_C(0.0);
+			/* Empty bins start inside out, any primitive of the node grows them */
+			for (j = 0; j < bins; j++) {
+				vec3_assign(bin_min[axis][j], node->max);
+				vec3_assign(bin_max[axis][j], node->min);
+				bin_count[axis][j] = 0;
+			}
+		}
+		for (i = 0; i < count; i++) {
+			mathc_bvh_bounds(source, indices[i], min, max);
+			for (axis = 0; axis < 3; axis++) {
+				int bin = mathc_bvh_bin((min[axis] + max[axis]) * MFLOAT_C(0.5), node->min[axis], scale[axis], bins);
+				mathc_bvh_grow(bin_min[axis][bin], bin_max[axis][bin], min, max);
+				bin_count[axis][bin] = bin_count[axis][bin] + 1;
+			}
+		}
+		for (axis = 0; axis < 3; axis++) {
+			int total = 0;
+			if (scale[axis] == MFLOAT_C(0.0)) {
+				continue;
+			}
+			/* Sweep from the right for the bounds and count of bins j and above */
+			for (j = bins - 1; j > 0; j--) {
+				if (bin_count[axis][j] > 0) {
+					if (total == 0) {
+						vec3_assign(min, bin_min[axis][j]);
+						vec3_assign(max, bin_max[axis][j]);
+					} else {
+						mathc_bvh_grow(min, max, bin_min[axis][j], bin_max[axis][j]);
+					}
+					total = total + bin_count[axis][j];
+				}
+				vec3_assign(right_min[j], min);
+				vec3_assign(right_max[j], max);
+				right_count[j] = total;
+			}
+			/* Sweep from the left, splitting before bin j */
+			total = 0;
+			for (j = 1; j < bins; j++) {
+				if (bin_count[axis][j - 1] > 0) {
+					if (total == 0) {
+						vec3_assign(min, bin_min[axis][j - 1]);
+						vec3_assign(max, bin_max[axis][j - 1]);
+					} else {
+						mathc_bvh_grow(min, max, bin_min[axis][j - 1], bin_max[axis][j - 1]);
+					}
+					total = total + bin_count[axis][j - 1];
+				}
+				if (total > 0 && right_count[j] > 0) {
+					mfloat_t cost = (mfloat_t)total * mathc_bvh_half_area(min, max) + (mfloat_t)right_count[j] * mathc_bvh_half_area(right_min[j], right_max[j]);
+					if (best_axis < 0 || cost < best_cost) {
+						best_cost = cost;
+						best_axis = axis;
+						best_split = j;
+						vec3_assign(left->min, min);
+						vec3_assign(left->max, max);
+						vec3_assign(right->min, right_min[j]);
+						vec3_assign(right->max, right_max[j]);
+					}
+				}
+			}
+		}
+		/* Keep a leaf when intersecting its primitives is cheaper than one
+		 * more level of boxes */
+		if (best_axis >= 0 && count <= MATHC_BVH_LEAF_SIZE
+			&& MFLOAT_C(1.0) + best_cost / mathc_bvh_half_area(node->min, node->max) >= (mfloat_t)count) {
+			return;
+		}
+	}
+	if (best_axis >= 0) {
+		/* Move the primitives left of the split to the front */
+		for (i = 0; i < count; i++) {
+			mathc_bvh_bounds(source, indices[i], min, max);
+			if (mathc_bvh_bin((min[best_axis] + max[best_axis]) * MFLOAT_C(0.5), node->min[best_axis], scale[best_axis], bins) < best_split) {
+				int swap = indices[i];
+				indices[i] = indices[left_count];
+				indices[left_count] = swap;
+				left_count = left_count + 1;
+			}
+		}
+	} else if (count <= MATHC_BVH_LEAF_SIZE) {
+		return;
+	} else {
+		/* No split by area, either too deep or with every centroid in the same
+		 * bin: halving still bounds the depth */
+		left_count = count / 2;
+	}
+	left->first = node->first;
+	left->count = left_count;
+	right->first = node->first + left_count;
+	right->count = count - left_count;
+	if (best_axis < 0) {
+		mathc_bvh_node_bounds(result, source, left);
+		mathc_bvh_node_bounds(result, source, right);
+	}
+	node->first = (int)result->node_count;
+	node->count = 0;
+	result->node_count = result->node_count + 2;
+}
+
+static struct bvh *mathc_bvh_build(struct bvh *result, struct mathc_bvh_source *source, size_t count)
+{
+	size_t level_end = 1;
+	size_t i;
+	int depth = 0;
+	result->count = count;
+	result->node_count = 0;
+	if (count == 0) {
+		return result;
+	}
+	for (i = 0; i < count; i++) {
+		result->indices[i] = (int)i;
+	}
+	result->nodes[0].first = 0;
+	result->nodes[0].count = (int)count;
+	result->node_count = 1;
+	mathc_bvh_node_bounds(result, source, result->nodes);
+	/* The nodes array doubles as the queue of nodes left to split. Children
+	 * are appended after every node of the current level, so a level ends
+	 * where the next one starts */
+	for (i = 0; i < result->node_count; i++) {
+		if (i == level_end) {
+			depth = depth + 1;
+			level_end = result->node_count;
+		}
+		mathc_bvh_split(result, source, i, depth);
+	}
+	return result;
+}
+
+static bool mathc_bvh_ray_box(struct bvh_node *node, mfloat_t *origin, mfloat_t *inverse, mfloat_t limit, mfloat_t *distance)
+{
+	mfloat_t t_near = MFLOAT_C(0.0);
+	mfloat_t t_far = limit;
+	int i;
+	for (i = 0; i < 3; i++) {
+		mfloat_t t0 = (node->min[i] - origin[i]) * inverse[i];
+		mfloat_t t1 = (node->max[i] - origin[i]) * inverse[i];
+		mfloat_t t_min = t0 < t1 ? t0 : t1;
+		mfloat_t t_max = t0 < t1 ? t1 : t0;
+		t_near = t_min > t_near ? t_min : t_near;
+		t_far = t_max < t_far ? t_max : t_far;
+	}
+	*distance = t_near;
+	return t_near <= t_far;
+}
+
+static bool mathc_bvh_triangle(void *data, int index, mfloat_t *result, mfloat_t *origin, mfloat_t *direction)
+{
+	mfloat_t *v = (mfloat_t *)data + (size_t)index * VEC3_SIZE * 3;
+	mfloat_t t;
+	if (ray_intersect_triangle(&t, origin, direction, v, v + VEC3_SIZE, v + VEC3_SIZE * 2) && t < *result) {
+		*result = t;
+		return true;
+	}
+	return false;
+}
+
+/* Transform a point by the weighted sum of the four matrices of a vertex.
+ * Only the affine part of the matrices is blended */
+static void mathc_skin_mat4(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, int *bones, mfloat_t *weights, mfloat_t *m0)
+{
+#if defined(MATHC_SSE)
+	mfloat_t transformed[VEC4_SIZE];
+	__m128 c0 = _mm_setzero_ps();
+	__m128 c1 = _mm_setzero_ps();
+	__m128 c2 = _mm_setzero_ps();
+	__m128 c3 = _mm_setzero_ps();
+	int j;
+	for (j = 0; j < 4; j++) {
+		mfloat_t *m = m0 + (size_t)bones[j] * MAT4_SIZE;
+		__m128 w = _mm_set1_ps(weights[j]);
+		c0 = MATHC_SSE_MADD(_mm_loadu_ps(m), w, c0);
+		c1 = MATHC_SSE_MADD(_mm_loadu_ps(m + 4), w, c1);
+		c2 = MATHC_SSE_MADD(_mm_loadu_ps(m + 8), w, c2);
+		c3 = MATHC_SSE_MADD(_mm_loadu_ps(m + 12), w, c3);
+	}
+	c3 = MATHC_SSE_MADD(c0, _mm_set1_ps(x), c3);
+	c3 = MATHC_SSE_MADD(c1, _mm_set1_ps(y), c3);
+	c3 = MATHC_SSE_MADD(c2, _mm_set1_ps(z), c3);
+	_mm_storeu_ps(transformed, c3);
+	result[0] = transformed[0];
+	result[1] = transformed[1];
+	result[2] = transformed[2];
+#else
+	mfloat_t m[12] = {MFLOAT_C(0.0)};
+	int j;
+	int k;
+	for (j = 0; j < 4; j++) {
+		mfloat_t *bone = m0 + (size_t)bones[j] * MAT4_SIZE;
+		mfloat_t w = weights[j];
+		for (k = 0; k < 4; k++) {
+			m[k * 3] += bone[k * 4] * w;
+			m[k * 3 + 1] += bone[k * 4 + 1] * w;
+			m[k * 3 + 2] += bone[k * 4 + 2] * w;
+		}
+	}
+	result[0] = m[0] * x + m[3] * y + m[6] * z + m[9];
+	result[1] = m[1] * x + m[4] * y + m[7] * z + m[10];
+	result[2] = m[2] * x + m[5] * y + m[8] * z + m[11];
+#endif
+}
+
+/* Transform a point by the weighted sum of the four dual quaternions of a
+ * vertex, each flipped to the hemisphere of the first one. Weights are
+ * expected to be positive */
+static void mathc_skin_dualquat(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, int *bones, mfloat_t *weights, mfloat_t *d0)
+{
+	mfloat_t *first = d0 + (size_t)bones[0] * DUALQUAT_SIZE;
+	mfloat_t d[DUALQUAT_SIZE] = {MFLOAT_C(0.0)};
+	mfloat_t scale;
+	mfloat_t tx;
+	mfloat_t ty;
+	mfloat_t tz;
+	mfloat_t cx;
+	mfloat_t cy;
+	mfloat_t cz;
+	int j;
+	int k;
+	for (j = 0; j < 4; j++) {
+		mfloat_t *bone = d0 + (size_t)bones[j] * DUALQUAT_SIZE;
+		mfloat_t w = MCOPYSIGN(weights[j], bone[0] * first[0] + bone[1] * first[1] + bone[2] * first[2] + bone[3] * first[3]);
+		for (k = 0; k < DUALQUAT_SIZE; k++) {
+			d[k] += bone[k] * w;
+		}
+	}
+	scale = d[0] * d[0] + d[1] * d[1] + d[2] * d[2] + d[3] * d[3];
+	scale = MFLOAT_C(1.0) / MSQRT(scale > MFLT_MIN ? scale : MFLT_MIN);
+	for (k = 0; k < DUALQUAT_SIZE; k++) {
+		d[k] = d[k] * scale;
+	}
+	/* Translation 2 * dual * conjugate(real) */
+	tx = MFLOAT_C(2.0) * (d[3] * d[4] - d[7] * d[0] + d[1] * d[6] - d[2] * d[5]);
+	ty = MFLOAT_C(2.0) * (d[3] * d[5] - d[7] * d[1] + d[2] * d[4] - d[0] * d[6]);
+	tz = MFLOAT_C(2.0) * (d[3] * d[6] - d[7] * d[2] + d[0] * d[5] - d[1] * d[4]);
+	/* Rotation v + 2 * r x (r x v + w * v) */
+	cx = d[1] * z - d[2] * y + d[3] * x;
+	cy = d[2] * x - d[0] * z + d[3] * y;
+	cz = d[0] * y - d[1] * x + d[3] * z;
+	result[0] = x + MFLOAT_C(2.0) * (d[1] * cz - d[2] * cy) + tx;
+	result[1] = y + MFLOAT_C(2.0) * (d[2] * cx - d[0] * cz) + ty;
+	result[2] = z + MFLOAT_C(2.0) * (d[0] * cy - d[1] * cx) + tz;
+}
+
+/* Key at or before time, for a time inside the keys of the track. The
+ * search starts at the cursor, so that playing forward costs one or two
+ * comparisons per call, and falls back to a binary search for jumps */
+static size_t mathc_animation_key(struct animation_track *track, mfloat_t time)
+{
+	mfloat_t *times = track->times;
+	size_t last = track->count - 1;
+	size_t key = track->cursor < last ? track->cursor : 0;
+	size_t low = key;
+	size_t high = key;
+	if (time < times[key]) {
+		low = 0;
+		high = key - 1;
+	} else if (key + 1 < last && times[key + 1] <= time) {
+		low = key + 1;
+		high = time < times[key + 2] ? low : last - 1;
+	}
+	while (low < high) {
+		size_t middle = low + (high - low + 1) / 2;
+		if (times[middle] <= time) {
+			low = middle;
+		} else {
+			high = middle - 1;
+		}
+	}
+	track->cursor = low;
+	return low;
+}
+
+/* Half precision conversions with round to nearest even, subnormals,
+ * infinities and NaNs */
+static mhalf_t mathc_half_from_float(float f)
+{
+	union {
+		float f;
+		uint32_t i;
+	} bits;
+	uint32_t sign;
+	uint16_t half;
+	bits.f = f;
+	sign = (bits.i >> 16) & UINT32_C(0x8000);
+	bits.i = bits.i & UINT32_C(0x7fffffff);
+	if (bits.i >= UINT32_C(0x47800000)) {
+		/* Too large for a half, infinity or NaN */
+		half = bits.i > UINT32_C(0x7f800000) ? 0x7e00 : 0x7c00;
+	} else if (bits.i < UINT32_C(0x38800000)) {
+		/* Subnormal half, rounded by adding 0.5 */
+		bits.f = bits.f + 0.5f;
+		half = (uint16_t)(bits.i - UINT32_C(0x3f000000));
+	} else {
+		uint32_t odd = (bits.i >> 13) & 1;
+		bits.i = bits.i + UINT32_C(0xc8000fff) + odd;
+		half = (uint16_t)(bits.i >> 13);
+	}
+	return (uint16_t)(half | sign);
+}
+
+static float mathc_float_from_half(mhalf_t h)
+{
+	union {
+		float f;
+		uint32_t i;
+	} bits;
+	uint32_t exponent;
+	bits.i = (uint32_t)(h & 0x7fff) << 13;
+	exponent = bits.i & UINT32_C(0x0f800000);
+	bits.i = bits.i + UINT32_C(0x38000000);
+	if (exponent == UINT32_C(0x0f800000)) {
+		/* Infinity or NaN */
+		bits.i = bits.i + UINT32_C(0x38000000);
+	} else if (exponent == 0) {
+		/* Subnormal, renormalized by subtracting 2^-14 */
+		bits.i = bits.i + UINT32_C(0x00800000);
+		bits.f = bits.f - 6.103515625e-05f;
+	}
+	bits.i = bits.i | ((uint32_t)(h & 0x8000) << 16);
+	return bits.f;
+}
+
+/* The three smallest components of a quaternion, mapped from the range
+ * [-1 / sqrt(2), 1 / sqrt(2)] to integers in [0, maximum], and the index
+ * of the largest component, made positive by negating the quaternion */
+static int mathc_quat_smallest_three(uint32_t *result, mfloat_t *q0, uint32_t maximum)
+{
+	mfloat_t q[QUAT_SIZE];
+	mfloat_t scale;
+	int largest = 0;
+	int i;
+	int j = 0;
+	quat_normalize(q, q0);
+	for (i = 1; i < 4; i++) {
+		if (MFABS(q[i]) > MFABS(q[largest])) {
+			largest = i;
+		}
+	}
+	scale = MCOPYSIGN(MFLOAT_C(0.70710678118654752440), q[largest]);
+	for (i = 0; i < 4; i++) {
+		if (i != largest) {
+			mfloat_t u = (q[i] * scale + MFLOAT_C(0.5)) * (mfloat_t)maximum + MFLOAT_C(0.5);
+			u = u > MFLOAT_C(0.0) ? u : MFLOAT_C(0.0);
+			u = u < (mfloat_t)maximum ? u : (mfloat_t)maximum;
+			result[j] = (uint32_t)u;
+			j = j + 1;
+		}
+	}
+	return largest;
+}
+
+static mfloat_t *mathc_quat_from_smallest_three(mfloat_t *result, int largest, uint32_t *v0, uint32_t maximum)
+{
+	mfloat_t scale = MFLOAT_C(1.41421356237309504880) / (mfloat_t)maximum;
+	mfloat_t sum = MFLOAT_C(0.0);
+	int i;
+	int j = 0;
+	result[largest] = MFLOAT_C(0.0);
+	for (i = 0; i < 4; i++) {
+		if (i != largest) {
+			result[i] = (mfloat_t)v0[j] * scale - MFLOAT_C(0.70710678118654752440);
+			sum = sum + result[i] * result[i];
+			j = j + 1;
+		}
+	}
+	if (sum > MFLOAT_C(1.0)) {
+		/* Rounding took the three components outside the unit sphere */
+		quat_multiply_f(result, result, MFLOAT_C(1.0) / MSQRT(sum));
+		sum = MFLOAT_C(1.0);
+	}
+	result[largest] = MSQRT(MFLOAT_C(1.0) - sum);
+	return result;
+}
+
+/* Batched form of mathc_quat_from_smallest_three(), from the components
+ * already unpacked into a, b and c, without branches on the index of the
+ * largest component */
+static void mathc_quat_from_smallest_three_n(mfloat_t *result, uint32_t *largest, mfloat_t *a, mfloat_t *b, mfloat_t *c, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		mfloat_t sum = a[i] * a[i] + b[i] * b[i] + c[i] * c[i];
+		mfloat_t scale = sum > MFLOAT_C(1.0) ? MFLOAT_C(1.0) / MSQRT(sum) : MFLOAT_C(1.0);
+		mfloat_t x = a[i] * scale;
+		mfloat_t y = b[i] * scale;
+		mfloat_t z = c[i] * scale;
+		mfloat_t w = MSQRT(sum < MFLOAT_C(1.0) ? MFLOAT_C(1.0) - sum : MFLOAT_C(0.0));
+		uint32_t l = largest[i];
+		mfloat_t *out = result + i * QUAT_SIZE;
+		out[0] = l == 0 ? w : x;
+		out[1] = l == 1 ? w : (l == 0 ? x : y);
+		out[2] = l == 2 ? w : (l == 3 ? z : y);
+		out[3] = l == 3 ? w : z;
+	}
+}
+#endif
+
+#if defined(MATHC_USE_THREADS)
+static size_t mathc_thread_grain(size_t count, size_t grain, int threads)
+{
+	if (grain == 0) {
+		/* A few chunks per thread, to balance uneven threads */
+		grain = threads > 1 ? count / ((size_t)threads * 4) : count;
+		if (grain == 0) {
+			grain = 1;
+		}
+	}
+	return grain;
+}
+
+/* Runs the chunks of the current dispatch until none is left. Called and
+ * returns with the mutex of the pool locked */
+static void mathc_thread_pool_run(struct mathc_thread_pool *pool)
+{
+	while (pool->next < pool->count) {
+		size_t begin = pool->next;
+		size_t end = pool->count - begin > pool->grain ? begin + pool->grain : pool->count;
+		void (*func)(void *data, size_t begin, size_t end) = pool->func;
+		void *data = pool->data;
+		/* Take the next chunk, so faster threads end up processing more chunks */
+		pool->next = end;
+		pthread_mutex_unlock(&pool->mutex);
+		func(data, begin, end);
+		pthread_mutex_lock(&pool->mutex);
+	}
+}
+
+static void *mathc_thread_pool_worker(void *pool_pointer)
+{
+	struct mathc_thread_pool *pool = (struct mathc_thread_pool *)pool_pointer;
+	unsigned long generation = 0;
+	pthread_mutex_lock(&pool->mutex);
+	while (true) {
+		while (!pool->stop && pool->generation == generation) {
+			pthread_cond_wait(&pool->wake, &pool->mutex);
+		}
+		if (pool->stop) {
+			break;
+		}
+		generation = pool->generation;
+		mathc_thread_pool_run(pool);
+		pool->busy = pool->busy - 1;
+		if (pool->busy == 0) {
+			pthread_cond_signal(&pool->done);
+		}
+	}
+	pthread_mutex_unlock(&pool->mutex);
+	return NULL;
+}
+
+MATHC_API struct mathc_thread_pool *mathc_thread_pool_create(struct mathc_thread_pool *result, int threads)
+{
+	int i;
+	if (threads > MATHC_MAX_THREADS) {
+		threads = MATHC_MAX_THREADS;
+	}
+	pthread_mutex_init(&result->mutex, NULL);
+	pthread_cond_init(&result->wake, NULL);
+	pthread_cond_init(&result->done, NULL);
+	result->threads = 0;
+	result->busy = 0;
+	result->generation = 0;
+	result->stop = false;
+	result->next = 0;
+	result->count = 0;
+	result->grain = 1;
+	result->func = NULL;
+	result->data = NULL;
+	/* The thread that dispatches is one of the workers */
+	for (i = 0; i < threads - 1; i++) {
+		if (pthread_create(&result->workers[result->threads], NULL, mathc_thread_pool_worker, result) == 0) {
+			result->threads = result->threads + 1;
+		}
+	}
+	return result;
+}
+
+MATHC_API void mathc_thread_pool_dispatch(struct mathc_thread_pool *pool, size_t count, size_t grain, void (*func)(void *data, size_t begin, size_t end), void *data)
+{
+	if (count == 0) {
+		return;
+	}
+	grain = mathc_thread_grain(count, grain, pool->threads + 1);
+	if (pool->threads == 0 || count <= grain) {
+		func(data, 0, count);
+		return;
+	}
+	pthread_mutex_lock(&pool->mutex);
+	pool->next = 0;
+	pool->count = count;
+	pool->grain = grain;
+	pool->func = func;
+	pool->data = data;
+	pool->busy = pool->threads;
+	pool->generation = pool->generation + 1;
+	pthread_cond_broadcast(&pool->wake);
+	mathc_thread_pool_run(pool);
+	/* Every worker has to see this dispatch before the next one starts */
+	while (pool->busy > 0) {
+		pthread_cond_wait(&pool->done, &pool->mutex);
+	}
+	pthread_mutex_unlock(&pool->mutex);
+}
+
+MATHC_API void mathc_thread_pool_destroy(struct mathc_thread_pool *pool)
+{
+	int i;
+	pthread_mutex_lock(&pool->mutex);
+	pool->stop = true;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->mutex);
+	for (i = 0; i < pool->threads; i++) {
+		pthread_join(pool->workers[i], NULL);
+	}
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->wake);
+	pthread_mutex_destroy(&pool->mutex);
+	pool->threads = 0;
+}
+
+MATHC_API void mathc_parallel_for(size_t count, size_t grain, void (*func)(void *data, size_t begin, size_t end), void *data, int threads)
+{
+	struct mathc_thread_pool pool;
+	if (count == 0) {
+		return;
+	}
+	if (threads > MATHC_MAX_THREADS) {
+		threads = MATHC_MAX_THREADS;
+	}
+	grain = mathc_thread_grain(count, grain, threads);
+	if (threads <= 1 || count <= grain) {
+		func(data, 0, count);
+		return;
+	}
+	/* A pool of its own, for a single dispatch */
+	mathc_thread_pool_create(&pool, threads);
+	mathc_thread_pool_dispatch(&pool, count, grain, func, data);
+	mathc_thread_pool_destroy(&pool);
+}
+#endif
+
 #if defined(MATHC_USE_INT)
-mint_t clampi(mint_t value, mint_t min, mint_t max)
+MATHC_API mint_t clampi(mint_t value, mint_t min, mint_t max)
 {
 	if (value < min) {
 		value = min;
@@ -34,7 +925,7 @@ mint_t clampi(mint_t value, mint_t min, mint_t max)
 #endif
 
 #if defined(MATHC_USE_FLOATING_POINT)
-bool nearly_equal(mfloat_t a, mfloat_t b, mfloat_t epsilon)
+MATHC_API bool nearly_equal(mfloat_t a, mfloat_t b, mfloat_t epsilon)
 {
 	bool result = false;
 	if (a == b) {
@@ -45,17 +936,17 @@ bool nearly_equal(mfloat_t a, mfloat_t b, mfloat_t epsilon)
 	return result;
 }
 
-mfloat_t to_radians(mfloat_t degrees)
+MATHC_API mfloat_t to_radians(mfloat_t degrees)
 {
 	return MRADIANS(degrees);
 }
 
-mfloat_t to_degrees(mfloat_t radians)
+MATHC_API mfloat_t to_degrees(mfloat_t radians)
 {
 	return MDEGREES(radians);
 }
 
-mfloat_t clampf(mfloat_t value, mfloat_t min, mfloat_t max)
+MATHC_API mfloat_t clampf(mfloat_t value, mfloat_t min, mfloat_t max)
 {
 	if (value < min) {
 		value = min;
@@ -64,27 +955,83 @@ mfloat_t clampf(mfloat_t value, mfloat_t min, mfloat_t max)
 	}
 	return value;
 }
+
+MATHC_API mfloat_t mathc_sin(mfloat_t x)
+{
+	unsigned int quadrant;
+	mfloat_t r = mathc_fast_reduce_quarter_pi(x, &quadrant);
+	mfloat_t s = mathc_fast_sin_quarter_pi(r);
+	mfloat_t c = mathc_fast_cos_quarter_pi(r);
+	/* Odd quadrants use the cosine, and the upper two are negated */
+	mfloat_t result = s + (c - s) * (mfloat_t)(quadrant & 1u);
+	return result * (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (mfloat_t)(quadrant >> 1));
+}
+
+MATHC_API mfloat_t mathc_cos(mfloat_t x)
+{
+	unsigned int quadrant;
+	mfloat_t r = mathc_fast_reduce_quarter_pi(x, &quadrant);
+	mfloat_t s = mathc_fast_sin_quarter_pi(r);
+	mfloat_t c = mathc_fast_cos_quarter_pi(r);
+	/* Odd quadrants use the sine, and the two around pi are negated */
+	mfloat_t result = c + (s - c) * (mfloat_t)(quadrant & 1u);
+	return result * (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (mfloat_t)(((quadrant + 1u) >> 1) & 1u));
+}
+
+MATHC_API void mathc_sincos(mfloat_t x, mfloat_t *s, mfloat_t *c)
+{
+	/* Both values share one range reduction and the same two polynomials */
+	unsigned int quadrant;
+	mfloat_t r = mathc_fast_reduce_quarter_pi(x, &quadrant);
+	mfloat_t sr = mathc_fast_sin_quarter_pi(r);
+	mfloat_t cr = mathc_fast_cos_quarter_pi(r);
+	mfloat_t odd = (mfloat_t)(quadrant & 1u);
+	*s = (sr + (cr - sr) * odd) * (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (mfloat_t)(quadrant >> 1));
+	*c = (cr + (sr - cr) * odd) * (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (mfloat_t)(((quadrant + 1u) >> 1) & 1u));
+}
+
+MATHC_API mfloat_t mathc_acos(mfloat_t x)
+{
+	mfloat_t result = mathc_fast_acos_unit(MFABS(x));
+	/* acos(-x) = pi - acos(x) */
+	return MPI_2 - MCOPYSIGN(MPI_2 - result, x);
+}
+
+MATHC_API mfloat_t mathc_atan2(mfloat_t y, mfloat_t x)
+{
+	/* The selects only pick constants or operands, and the quadrant is
+	 * applied with copysign, so loops calling this function vectorize */
+	mfloat_t ax = MFABS(x);
+	mfloat_t ay = MFABS(y);
+	mfloat_t maximum = ax >= ay ? ax : ay;
+	mfloat_t minimum = ax >= ay ? ay : ax;
+	mfloat_t swapped = ax >= ay ? MFLOAT_C(0.0) : MFLOAT_C(1.0);
+	mfloat_t result = mathc_fast_atan_unit(minimum / (maximum + MFLT_MIN));
+	result = result + (MPI_2 - MFLOAT_C(2.0) * result) * swapped;
+	result = MPI_2 - MCOPYSIGN(MPI_2 - result, x);
+	return MCOPYSIGN(result, y);
+}
 #endif
 
 #if defined(MATHC_USE_INT)
-bool vec2i_is_zero(mint_t *v0)
+MATHC_API bool vec2i_is_zero(mint_t *v0)
 {
 	return v0[0] == 0 && v0[1] == 0;
 }
 
-bool vec2i_is_equal(mint_t *v0, mint_t *v1)
+MATHC_API bool vec2i_is_equal(mint_t *v0, mint_t *v1)
 {
 	return v0[0] == v1[0] && v0[1] == v1[1];
 }
 
-mint_t *vec2i(mint_t *result, mint_t x, mint_t y)
+MATHC_API mint_t *vec2i(mint_t *result, mint_t x, mint_t y)
 {
 	result[0] = x;
 	result[1] = y;
 	return result;
 }
 
-mint_t *vec2i_assign(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec2i_assign(mint_t *result, mint_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -92,7 +1039,7 @@ mint_t *vec2i_assign(mint_t *result, mint_t *v0)
 }
 
 #if defined(MATHC_USE_FLOATING_POINT)
-mint_t *vec2i_assign_vec2(mint_t *result, mfloat_t *v0)
+MATHC_API mint_t *vec2i_assign_vec2(mint_t *result, mfloat_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -100,21 +1047,21 @@ mint_t *vec2i_assign_vec2(mint_t *result, mfloat_t *v0)
 }
 #endif
 
-mint_t *vec2i_zero(mint_t *result)
+MATHC_API mint_t *vec2i_zero(mint_t *result)
 {
 	result[0] = 0;
 	result[1] = 0;
 	return result;
 }
 
-mint_t *vec2i_one(mint_t *result)
+MATHC_API mint_t *vec2i_one(mint_t *result)
 {
 	result[0] = 1;
 	result[1] = 1;
 	return result;
 }
 
-mint_t *vec2i_sign(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec2i_sign(mint_t *result, mint_t *v0)
 {
 	if (v0[0] > 0) {
 		result[0] = 1;
@@ -133,84 +1080,84 @@ mint_t *vec2i_sign(mint_t *result, mint_t *v0)
 	return result;
 }
 
-mint_t *vec2i_add(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec2i_add(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] + v1[0];
 	result[1] = v0[1] + v1[1];
 	return result;
 }
 
-mint_t *vec2i_add_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec2i_add_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] + i;
 	result[1] = v0[1] + i;
 	return result;
 }
 
-mint_t *vec2i_subtract(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec2i_subtract(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] - v1[0];
 	result[1] = v0[1] - v1[1];
 	return result;
 }
 
-mint_t *vec2i_subtract_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec2i_subtract_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] - i;
 	result[1] = v0[1] - i;
 	return result;
 }
 
-mint_t *vec2i_multiply(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec2i_multiply(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] * v1[0];
 	result[1] = v0[1] * v1[1];
 	return result;
 }
 
-mint_t *vec2i_multiply_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec2i_multiply_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] * i;
 	result[1] = v0[1] * i;
 	return result;
 }
 
-mint_t *vec2i_divide(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec2i_divide(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] / v1[0];
 	result[1] = v0[1] / v1[1];
 	return result;
 }
 
-mint_t *vec2i_divide_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec2i_divide_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] / i;
 	result[1] = v0[1] / i;
 	return result;
 }
 
-mint_t *vec2i_snap(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec2i_snap(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = (v0[0] / v1[0]) * v1[0];
 	result[1] = (v0[1] / v1[1]) * v1[1];
 	return result;
 }
 
-mint_t *vec2i_snap_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec2i_snap_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = (v0[0] / i) * i;
 	result[1] = (v0[1] / i) * i;
 	return result;
 }
 
-mint_t *vec2i_negative(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec2i_negative(mint_t *result, mint_t *v0)
 {
 	result[0] = -v0[0];
 	result[1] = -v0[1];
 	return result;
 }
 
-mint_t *vec2i_abs(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec2i_abs(mint_t *result, mint_t *v0)
 {
 	result[0] = v0[0];
 	if (result[0] < 0) {
@@ -223,7 +1170,7 @@ mint_t *vec2i_abs(mint_t *result, mint_t *v0)
 	return result;
 }
 
-mint_t *vec2i_max(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec2i_max(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	if (v0[0] > v1[0]) {
 		result[0] = v0[0];
@@ -238,7 +1185,7 @@ mint_t *vec2i_max(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec2i_min(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec2i_min(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	if (v0[0] < v1[0]) {
 		result[0] = v0[0];
@@ -253,14 +1200,14 @@ mint_t *vec2i_min(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec2i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2)
+MATHC_API mint_t *vec2i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2)
 {
 	vec2i_min(result, v0, v1);
-	vec2i_max(result, v0, v2);
+	vec2i_max(result, result, v2);
 	return result;
 }
 
-mint_t *vec2i_tangent(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec2i_tangent(mint_t *result, mint_t *v0)
 {
 	mint_t a0 = v0[0];
 	mint_t a1 = v0[1];
@@ -269,17 +1216,17 @@ mint_t *vec2i_tangent(mint_t *result, mint_t *v0)
 	return result;
 }
 
-bool vec3i_is_zero(mint_t *v0)
+MATHC_API bool vec3i_is_zero(mint_t *v0)
 {
 	return v0[0] == 0 && v0[1] == 0 && v0[2] == 0;
 }
 
-bool vec3i_is_equal(mint_t *v0, mint_t *v1)
+MATHC_API bool vec3i_is_equal(mint_t *v0, mint_t *v1)
 {
 	return v0[0] == v1[0] && v0[1] == v1[1] && v0[2] == v1[2];
 }
 
-mint_t *vec3i(mint_t *result, mint_t x, mint_t y, mint_t z)
+MATHC_API mint_t *vec3i(mint_t *result, mint_t x, mint_t y, mint_t z)
 {
 	result[0] = x;
 	result[1] = y;
@@ -287,7 +1234,7 @@ mint_t *vec3i(mint_t *result, mint_t x, mint_t y, mint_t z)
 	return result;
 }
 
-mint_t *vec3i_assign(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec3i_assign(mint_t *result, mint_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -296,7 +1243,7 @@ mint_t *vec3i_assign(mint_t *result, mint_t *v0)
 }
 
 #if defined(MATHC_USE_FLOATING_POINT)
-mint_t *vec3i_assign_vec3(mint_t *result, mfloat_t *v0)
+MATHC_API mint_t *vec3i_assign_vec3(mint_t *result, mfloat_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -305,7 +1252,7 @@ mint_t *vec3i_assign_vec3(mint_t *result, mfloat_t *v0)
 }
 #endif
 
-mint_t *vec3i_zero(mint_t *result)
+MATHC_API mint_t *vec3i_zero(mint_t *result)
 {
 	result[0] = 0;
 	result[1] = 0;
@@ -313,7 +1260,7 @@ mint_t *vec3i_zero(mint_t *result)
 	return result;
 }
 
-mint_t *vec3i_one(mint_t *result)
+MATHC_API mint_t *vec3i_one(mint_t *result)
 {
 	result[0] = 1;
 	result[1] = 1;
@@ -321,7 +1268,7 @@ mint_t *vec3i_one(mint_t *result)
 	return result;
 }
 
-mint_t *vec3i_sign(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec3i_sign(mint_t *result, mint_t *v0)
 {
 	if (v0[0] > 0) {
 		result[0] = 1;
@@ -347,7 +1294,7 @@ mint_t *vec3i_sign(mint_t *result, mint_t *v0)
 	return result;
 }
 
-mint_t *vec3i_add(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec3i_add(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] + v1[0];
 	result[1] = v0[1] + v1[1];
@@ -355,7 +1302,7 @@ mint_t *vec3i_add(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec3i_add_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec3i_add_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] + i;
 	result[1] = v0[1] + i;
@@ -363,7 +1310,7 @@ mint_t *vec3i_add_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec3i_subtract(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec3i_subtract(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] - v1[0];
 	result[1] = v0[1] - v1[1];
@@ -371,7 +1318,7 @@ mint_t *vec3i_subtract(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec3i_subtract_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec3i_subtract_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] - i;
 	result[1] = v0[1] - i;
@@ -379,7 +1326,7 @@ mint_t *vec3i_subtract_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec3i_multiply(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec3i_multiply(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] * v1[0];
 	result[1] = v0[1] * v1[1];
@@ -387,7 +1334,7 @@ mint_t *vec3i_multiply(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec3i_multiply_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec3i_multiply_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] * i;
 	result[1] = v0[1] * i;
@@ -395,7 +1342,7 @@ mint_t *vec3i_multiply_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec3i_divide(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec3i_divide(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] / v1[0];
 	result[1] = v0[1] / v1[1];
@@ -403,7 +1350,7 @@ mint_t *vec3i_divide(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec3i_divide_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec3i_divide_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] / i;
 	result[1] = v0[1] / i;
@@ -411,7 +1358,7 @@ mint_t *vec3i_divide_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec3i_snap(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec3i_snap(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = (v0[0] / v1[0]) * v1[0];
 	result[1] = (v0[1] / v1[1]) * v1[1];
@@ -419,7 +1366,7 @@ mint_t *vec3i_snap(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec3i_snap_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec3i_snap_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = (v0[0] / i) * i;
 	result[1] = (v0[1] / i) * i;
@@ -427,7 +1374,7 @@ mint_t *vec3i_snap_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec3i_cross(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec3i_cross(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	mint_t cross[VEC3_SIZE];
 	cross[0] = v0[1] * v1[2] - v0[2] * v1[1];
@@ -439,7 +1386,7 @@ mint_t *vec3i_cross(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec3i_negative(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec3i_negative(mint_t *result, mint_t *v0)
 {
 	result[0] = -v0[0];
 	result[1] = -v0[1];
@@ -447,7 +1394,7 @@ mint_t *vec3i_negative(mint_t *result, mint_t *v0)
 	return result;
 }
 
-mint_t *vec3i_abs(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec3i_abs(mint_t *result, mint_t *v0)
 {
 	result[0] = v0[0];
 	if (result[0] < 0) {
@@ -464,7 +1411,7 @@ mint_t *vec3i_abs(mint_t *result, mint_t *v0)
 	return result;
 }
 
-mint_t *vec3i_max(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec3i_max(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	if (v0[0] > v1[0]) {
 		result[0] = v0[0];
@@ -484,7 +1431,7 @@ mint_t *vec3i_max(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec3i_min(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec3i_min(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	if (v0[0] < v1[0]) {
 		result[0] = v0[0];
@@ -504,24 +1451,24 @@ mint_t *vec3i_min(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec3i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2)
+MATHC_API mint_t *vec3i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2)
 {
 	vec3i_min(result, v0, v1);
-	vec3i_max(result, v0, v2);
+	vec3i_max(result, result, v2);
 	return result;
 }
 
-bool vec4i_is_zero(mint_t *v0)
+MATHC_API bool vec4i_is_zero(mint_t *v0)
 {
 	return v0[0] == 0 && v0[1] == 0 && v0[2] == 0 && v0[3] == 0;
 }
 
-bool vec4i_is_equal(mint_t *v0, mint_t *v1)
+MATHC_API bool vec4i_is_equal(mint_t *v0, mint_t *v1)
 {
 	return v0[0] == v1[0] && v0[1] == v1[1] && v0[2] == v1[2] && v0[3] == v1[3];
 }
 
-mint_t *vec4i(mint_t *result, mint_t x, mint_t y, mint_t z, mint_t w)
+MATHC_API mint_t *vec4i(mint_t *result, mint_t x, mint_t y, mint_t z, mint_t w)
 {
 	result[0] = x;
 	result[1] = y;
@@ -530,7 +1477,7 @@ mint_t *vec4i(mint_t *result, mint_t x, mint_t y, mint_t z, mint_t w)
 	return result;
 }
 
-mint_t *vec4i_assign(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec4i_assign(mint_t *result, mint_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -540,7 +1487,7 @@ mint_t *vec4i_assign(mint_t *result, mint_t *v0)
 }
 
 #if defined(MATHC_USE_FLOATING_POINT)
-mint_t *vec4i_assign_vec4(mint_t *result, mfloat_t *v0)
+MATHC_API mint_t *vec4i_assign_vec4(mint_t *result, mfloat_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -550,7 +1497,7 @@ mint_t *vec4i_assign_vec4(mint_t *result, mfloat_t *v0)
 }
 #endif
 
-mint_t *vec4i_zero(mint_t *result)
+MATHC_API mint_t *vec4i_zero(mint_t *result)
 {
 	result[0] = 0;
 	result[1] = 0;
@@ -559,7 +1506,7 @@ mint_t *vec4i_zero(mint_t *result)
 	return result;
 }
 
-mint_t *vec4i_one(mint_t *result)
+MATHC_API mint_t *vec4i_one(mint_t *result)
 {
 	result[0] = 1;
 	result[1] = 1;
@@ -568,7 +1515,7 @@ mint_t *vec4i_one(mint_t *result)
 	return result;
 }
 
-mint_t *vec4i_sign(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec4i_sign(mint_t *result, mint_t *v0)
 {
 	if (v0[0] > 0) {
 		result[0] = 1;
@@ -601,7 +1548,7 @@ mint_t *vec4i_sign(mint_t *result, mint_t *v0)
 	return result;
 }
 
-mint_t *vec4i_add(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec4i_add(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] + v1[0];
 	result[1] = v0[1] + v1[1];
@@ -610,7 +1557,7 @@ mint_t *vec4i_add(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec4i_add_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec4i_add_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] + i;
 	result[1] = v0[1] + i;
@@ -619,7 +1566,7 @@ mint_t *vec4i_add_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec4i_subtract(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec4i_subtract(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] - v1[0];
 	result[1] = v0[1] - v1[1];
@@ -628,7 +1575,7 @@ mint_t *vec4i_subtract(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec4i_subtract_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec4i_subtract_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] - i;
 	result[1] = v0[1] - i;
@@ -637,7 +1584,7 @@ mint_t *vec4i_subtract_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec4i_multiply(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec4i_multiply(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] * v1[0];
 	result[1] = v0[1] * v1[1];
@@ -646,7 +1593,7 @@ mint_t *vec4i_multiply(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec4i_multiply_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec4i_multiply_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] * i;
 	result[1] = v0[1] * i;
@@ -655,7 +1602,7 @@ mint_t *vec4i_multiply_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec4i_divide(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec4i_divide(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = v0[0] / v1[0];
 	result[1] = v0[1] / v1[1];
@@ -664,7 +1611,7 @@ mint_t *vec4i_divide(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec4i_divide_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec4i_divide_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = v0[0] / i;
 	result[1] = v0[1] / i;
@@ -673,7 +1620,7 @@ mint_t *vec4i_divide_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec4i_snap(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec4i_snap(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	result[0] = (v0[0] / v1[0]) * v1[0];
 	result[1] = (v0[1] / v1[1]) * v1[1];
@@ -682,7 +1629,7 @@ mint_t *vec4i_snap(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec4i_snap_i(mint_t *result, mint_t *v0, mint_t i)
+MATHC_API mint_t *vec4i_snap_i(mint_t *result, mint_t *v0, mint_t i)
 {
 	result[0] = (v0[0] / i) * i;
 	result[1] = (v0[1] / i) * i;
@@ -691,7 +1638,7 @@ mint_t *vec4i_snap_i(mint_t *result, mint_t *v0, mint_t i)
 	return result;
 }
 
-mint_t *vec4i_negative(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec4i_negative(mint_t *result, mint_t *v0)
 {
 	result[0] = -v0[0];
 	result[1] = -v0[1];
@@ -700,7 +1647,7 @@ mint_t *vec4i_negative(mint_t *result, mint_t *v0)
 	return result;
 }
 
-mint_t *vec4i_abs(mint_t *result, mint_t *v0)
+MATHC_API mint_t *vec4i_abs(mint_t *result, mint_t *v0)
 {
 	result[0] = v0[0];
 	if (result[0] < 0) {
@@ -721,7 +1668,7 @@ mint_t *vec4i_abs(mint_t *result, mint_t *v0)
 	return result;
 }
 
-mint_t *vec4i_max(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec4i_max(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	if (v0[0] > v1[0]) {
 		result[0] = v0[0];
@@ -746,7 +1693,7 @@ mint_t *vec4i_max(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec4i_min(mint_t *result, mint_t *v0, mint_t *v1)
+MATHC_API mint_t *vec4i_min(mint_t *result, mint_t *v0, mint_t *v1)
 {
 	if (v0[0] < v1[0]) {
 		result[0] = v0[0];
@@ -771,33 +1718,33 @@ mint_t *vec4i_min(mint_t *result, mint_t *v0, mint_t *v1)
 	return result;
 }
 
-mint_t *vec4i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2)
+MATHC_API mint_t *vec4i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2)
 {
 	vec4i_min(result, v0, v1);
-	vec4i_max(result, v0, v2);
+	vec4i_max(result, result, v2);
 	return result;
 }
 #endif
 
 #if defined(MATHC_USE_FLOATING_POINT)
-bool vec2_is_zero(mfloat_t *v0)
+MATHC_API bool vec2_is_zero(mfloat_t *v0)
 {
 	return MFABS(v0[0]) < MFLT_EPSILON && MFABS(v0[1]) < MFLT_EPSILON;
 }
 
-bool vec2_is_equal(mfloat_t *v0, mfloat_t *v1)
+MATHC_API bool vec2_is_equal(mfloat_t *v0, mfloat_t *v1)
 {
 	return MFABS(v0[0] - v1[0]) < MFLT_EPSILON && MFABS(v0[1] - v1[1]) < MFLT_EPSILON;
 }
 
-mfloat_t *vec2(mfloat_t *result, mfloat_t x, mfloat_t y)
+MATHC_API mfloat_t *vec2(mfloat_t *result, mfloat_t x, mfloat_t y)
 {
 	result[0] = x;
 	result[1] = y;
 	return result;
 }
 
-mfloat_t *vec2_assign(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_assign(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -805,7 +1752,7 @@ mfloat_t *vec2_assign(mfloat_t *result, mfloat_t *v0)
 }
 
 #if defined(MATHC_USE_INT)
-mfloat_t *vec2_assign_vec2i(mfloat_t *result, mint_t *v0)
+MATHC_API mfloat_t *vec2_assign_vec2i(mfloat_t *result, mint_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -813,21 +1760,21 @@ mfloat_t *vec2_assign_vec2i(mfloat_t *result, mint_t *v0)
 }
 #endif
 
-mfloat_t *vec2_zero(mfloat_t *result)
+MATHC_API mfloat_t *vec2_zero(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(0.0);
 	result[1] = MFLOAT_C(0.0);
 	return result;
 }
 
-mfloat_t *vec2_one(mfloat_t *result)
+MATHC_API mfloat_t *vec2_one(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(1.0);
 	result[1] = MFLOAT_C(1.0);
 	return result;
 }
 
-mfloat_t *vec2_sign(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_sign(mfloat_t *result, mfloat_t *v0)
 {
 	if (v0[0] > MFLOAT_C(0.0)) {
 		result[0] = MFLOAT_C(1.0);
@@ -846,49 +1793,49 @@ mfloat_t *vec2_sign(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec2_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] + v1[0];
 	result[1] = v0[1] + v1[1];
 	return result;
 }
 
-mfloat_t *vec2_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec2_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] + f;
 	result[1] = v0[1] + f;
 	return result;
 }
 
-mfloat_t *vec2_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] - v1[0];
 	result[1] = v0[1] - v1[1];
 	return result;
 }
 
-mfloat_t *vec2_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec2_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] - f;
 	result[1] = v0[1] - f;
 	return result;
 }
 
-mfloat_t *vec2_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] * v1[0];
 	result[1] = v0[1] * v1[1];
 	return result;
 }
 
-mfloat_t *vec2_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec2_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] * f;
 	result[1] = v0[1] * f;
 	return result;
 }
 
-mfloat_t *vec2_multiply_mat2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
+MATHC_API mfloat_t *vec2_multiply_mat2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 {
 	mfloat_t x = v0[0];
 	mfloat_t y = v0[1];
@@ -897,95 +1844,102 @@ mfloat_t *vec2_multiply_mat2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *vec2_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_multiply_mat2_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT v0, mfloat_t *MATHC_RESTRICT m0)
+{
+	result[0] = m0[0] * v0[0] + m0[2] * v0[1];
+	result[1] = m0[1] * v0[0] + m0[3] * v0[1];
+	return result;
+}
+
+MATHC_API mfloat_t *vec2_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] / v1[0];
 	result[1] = v0[1] / v1[1];
 	return result;
 }
 
-mfloat_t *vec2_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec2_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] / f;
 	result[1] = v0[1] / f;
 	return result;
 }
 
-mfloat_t *vec2_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFLOOR(v0[0] / v1[0]) * v1[0];
 	result[1] = MFLOOR(v0[1] / v1[1]) * v1[1];
 	return result;
 }
 
-mfloat_t *vec2_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec2_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = MFLOOR(v0[0] / f) * f;
 	result[1] = MFLOOR(v0[1] / f) * f;
 	return result;
 }
 
-mfloat_t *vec2_negative(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_negative(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = -v0[0];
 	result[1] = -v0[1];
 	return result;
 }
 
-mfloat_t *vec2_abs(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_abs(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MFABS(v0[0]);
 	result[1] = MFABS(v0[1]);
 	return result;
 }
 
-mfloat_t *vec2_floor(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_floor(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MFLOOR(v0[0]);
 	result[1] = MFLOOR(v0[1]);
 	return result;
 }
 
-mfloat_t *vec2_ceil(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_ceil(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MCEIL(v0[0]);
 	result[1] = MCEIL(v0[1]);
 	return result;
 }
 
-mfloat_t *vec2_round(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_round(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MROUND(v0[0]);
 	result[1] = MROUND(v0[1]);
 	return result;
 }
 
-mfloat_t *vec2_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFMAX(v0[0], v1[0]);
 	result[1] = MFMAX(v0[1], v1[1]);
 	return result;
 }
 
-mfloat_t *vec2_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFMIN(v0[0], v1[0]);
 	result[1] = MFMIN(v0[1], v1[1]);
 	return result;
 }
 
-mfloat_t *vec2_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
+MATHC_API mfloat_t *vec2_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
 {
 	vec2_min(result, v0, v1);
-	vec2_max(result, v0, v2);
+	vec2_max(result, result, v2);
 	return result;
 }
 
-mfloat_t vec2_cross(mfloat_t* v0, mfloat_t* v1) {
+MATHC_API mfloat_t vec2_cross(mfloat_t* v0, mfloat_t* v1) {
     return v0[0] * v1[1] - v0[1] * v1[0];
 }
 
-mfloat_t *vec2_normalize(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_normalize(mfloat_t *result, mfloat_t *v0)
 {
 	mfloat_t l = MSQRT(v0[0] * v0[0] + v0[1] * v0[1]);
 	result[0] = v0[0] / l;
@@ -993,12 +1947,21 @@ mfloat_t *vec2_normalize(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t vec2_dot(mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_normalize_fast(mfloat_t *result, mfloat_t *v0)
+{
+	/* Biased by the smallest normal value, so a zero vector stays zero without a branch */
+	mfloat_t l = mathc_fast_rsqrt(v0[0] * v0[0] + v0[1] * v0[1] + MFLT_MIN);
+	result[0] = v0[0] * l;
+	result[1] = v0[1] * l;
+	return result;
+}
+
+MATHC_API mfloat_t vec2_dot(mfloat_t *v0, mfloat_t *v1)
 {
 	return v0[0] * v1[0] + v0[1] * v1[1];
 }
 
-mfloat_t *vec2_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec2_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	mfloat_t d = vec2_dot(v1, v1);
 	mfloat_t s = vec2_dot(v0, v1) / d;
@@ -1007,7 +1970,7 @@ mfloat_t *vec2_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec2_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
+MATHC_API mfloat_t *vec2_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 {
 	mfloat_t d = vec2_dot(v0, normal);
 	result[0] = v0[0] - normal[0] * d;
@@ -1015,7 +1978,7 @@ mfloat_t *vec2_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 	return result;
 }
 
-mfloat_t *vec2_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
+MATHC_API mfloat_t *vec2_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 {
 	mfloat_t d = MFLOAT_C(2.0) * vec2_dot(v0, normal);
 	result[0] = normal[0] * d - v0[0];
@@ -1023,7 +1986,7 @@ mfloat_t *vec2_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 	return result;
 }
 
-mfloat_t *vec2_tangent(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec2_tangent(mfloat_t *result, mfloat_t *v0)
 {
 	mfloat_t a0 = v0[0];
 	mfloat_t a1 = v0[1];
@@ -1032,25 +1995,26 @@ mfloat_t *vec2_tangent(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec2_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec2_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
-	mfloat_t cs = MCOS(f);
-	mfloat_t sn = MSIN(f);
+	mfloat_t cs;
+	mfloat_t sn;
 	mfloat_t x = v0[0];
 	mfloat_t y = v0[1];
+	MSINCOS(f, &sn, &cs);
 	result[0] = x * cs - y * sn;
 	result[1] = x * sn + y * cs;
 	return result;
 }
 
-mfloat_t *vec2_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
+MATHC_API mfloat_t *vec2_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
 {
 	result[0] = v0[0] + (v1[0] - v0[0]) * f;
 	result[1] = v0[1] + (v1[1] - v0[1]) * f;
 	return result;
 }
 
-mfloat_t *vec2_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v) {
+MATHC_API mfloat_t *vec2_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v) {
     mfloat_t tmp0[VEC2_SIZE];
     mfloat_t tmp1[VEC2_SIZE];
     vec2_lerp(tmp0, v0, v1, u);
@@ -1059,7 +2023,7 @@ mfloat_t *vec2_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *
     return result;
 }
 
-mfloat_t *vec2_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f)
+MATHC_API mfloat_t *vec2_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f)
 {
 	mfloat_t tmp0[VEC2_SIZE];
 	mfloat_t tmp1[VEC2_SIZE];
@@ -1069,7 +2033,7 @@ mfloat_t *vec2_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v
 	return result;
 }
 
-mfloat_t *vec2_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f)
+MATHC_API mfloat_t *vec2_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f)
 {
 	mfloat_t tmp0[VEC2_SIZE];
 	mfloat_t tmp1[VEC2_SIZE];
@@ -1085,42 +2049,42 @@ mfloat_t *vec2_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v
 	return result;
 }
 
-mfloat_t vec2_angle(mfloat_t *v0)
+MATHC_API mfloat_t vec2_angle(mfloat_t *v0)
 {
 	return MATAN2(v0[1], v0[0]);
 }
 
-mfloat_t vec2_length(mfloat_t *v0)
+MATHC_API mfloat_t vec2_length(mfloat_t *v0)
 {
 	return MSQRT(v0[0] * v0[0] + v0[1] * v0[1]);
 }
 
-mfloat_t vec2_length_squared(mfloat_t *v0)
+MATHC_API mfloat_t vec2_length_squared(mfloat_t *v0)
 {
 	return v0[0] * v0[0] + v0[1] * v0[1];
 }
 
-mfloat_t vec2_distance(mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t vec2_distance(mfloat_t *v0, mfloat_t *v1)
 {
 	return MSQRT((v0[0] - v1[0]) * (v0[0] - v1[0]) + (v0[1] - v1[1]) * (v0[1] - v1[1]));
 }
 
-mfloat_t vec2_distance_squared(mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t vec2_distance_squared(mfloat_t *v0, mfloat_t *v1)
 {
 	return (v0[0] - v1[0]) * (v0[0] - v1[0]) + (v0[1] - v1[1]) * (v0[1] - v1[1]);
 }
 
-bool vec2_linear_independent(mfloat_t *v0, mfloat_t *v1)
+MATHC_API bool vec2_linear_independent(mfloat_t *v0, mfloat_t *v1)
 {
 	return (v0[0] * v1[1] - v1[0] * v0[1]) != 0;
 }
 
-mfloat_t** vec2_orthonormalization(mfloat_t result[2][2], mfloat_t basis[2][2])
+MATHC_API mfloat_t** vec2_orthonormalization(mfloat_t result[2][2], mfloat_t basis[2][2])
 {
 	mfloat_t v0[2];
 	mfloat_t v1[2];
 
-	for(int32_t i = 0; i < 2; ++i) {
+	for(int i = 0; i < 2; ++i) {
 		v0[i] = basis[0][i];
 		v1[i] = basis[1][i];
 	}
@@ -1133,7 +2097,7 @@ mfloat_t** vec2_orthonormalization(mfloat_t result[2][2], mfloat_t basis[2][2])
 	mfloat_t u0[2];
 	mfloat_t u1[2];
 
-	for(int32_t i = 0; i < 2; ++i) {
+	for(int i = 0; i < 2; ++i) {
 		u0[i] = v0[i];
 	}
 
@@ -1145,17 +2109,17 @@ mfloat_t** vec2_orthonormalization(mfloat_t result[2][2], mfloat_t basis[2][2])
 	return (mfloat_t**)result;
 }
 
-bool vec3_is_zero(mfloat_t *v0)
+MATHC_API bool vec3_is_zero(mfloat_t *v0)
 {
 	return MFABS(v0[0]) < MFLT_EPSILON && MFABS(v0[1]) < MFLT_EPSILON && MFABS(v0[2]) < MFLT_EPSILON;
 }
 
-bool vec3_is_equal(mfloat_t *v0, mfloat_t *v1)
+MATHC_API bool vec3_is_equal(mfloat_t *v0, mfloat_t *v1)
 {
 	return MFABS(v0[0] - v1[0]) < MFLT_EPSILON && MFABS(v0[1] - v1[1]) < MFLT_EPSILON && MFABS(v0[2] - v1[2]) < MFLT_EPSILON;
 }
 
-mfloat_t *vec3(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z)
+MATHC_API mfloat_t *vec3(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z)
 {
 	result[0] = x;
 	result[1] = y;
@@ -1163,7 +2127,7 @@ mfloat_t *vec3(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z)
 	return result;
 }
 
-mfloat_t *vec3_assign(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec3_assign(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -1172,7 +2136,7 @@ mfloat_t *vec3_assign(mfloat_t *result, mfloat_t *v0)
 }
 
 #if defined(MATHC_USE_INT)
-mfloat_t *vec3_assign_vec3i(mfloat_t *result, mint_t *v0)
+MATHC_API mfloat_t *vec3_assign_vec3i(mfloat_t *result, mint_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = v0[1];
@@ -1181,7 +2145,7 @@ mfloat_t *vec3_assign_vec3i(mfloat_t *result, mint_t *v0)
 }
 #endif
 
-mfloat_t *vec3_zero(mfloat_t *result)
+MATHC_API mfloat_t *vec3_zero(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(0.0);
 	result[1] = MFLOAT_C(0.0);
@@ -1189,7 +2153,7 @@ mfloat_t *vec3_zero(mfloat_t *result)
 	return result;
 }
 
-mfloat_t *vec3_one(mfloat_t *result)
+MATHC_API mfloat_t *vec3_one(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(1.0);
 	result[1] = MFLOAT_C(1.0);
@@ -1197,7 +2161,7 @@ mfloat_t *vec3_one(mfloat_t *result)
 	return result;
 }
 
-mfloat_t *vec3_sign(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec3_sign(mfloat_t *result, mfloat_t *v0)
 {
 	if (v0[0] > MFLOAT_C(0.0)) {
 		result[0] = MFLOAT_C(1.0);
@@ -1223,7 +2187,7 @@ mfloat_t *vec3_sign(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec3_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] + v1[0];
 	result[1] = v0[1] + v1[1];
@@ -1231,7 +2195,7 @@ mfloat_t *vec3_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec3_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] + f;
 	result[1] = v0[1] + f;
@@ -1239,7 +2203,7 @@ mfloat_t *vec3_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec3_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] - v1[0];
 	result[1] = v0[1] - v1[1];
@@ -1247,7 +2211,7 @@ mfloat_t *vec3_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec3_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] - f;
 	result[1] = v0[1] - f;
@@ -1255,7 +2219,7 @@ mfloat_t *vec3_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec3_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] * v1[0];
 	result[1] = v0[1] * v1[1];
@@ -1263,7 +2227,7 @@ mfloat_t *vec3_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec3_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] * f;
 	result[1] = v0[1] * f;
@@ -1271,7 +2235,7 @@ mfloat_t *vec3_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec3_multiply_mat3(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
+MATHC_API mfloat_t *vec3_multiply_mat3(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 {
 	mfloat_t x = v0[0];
 	mfloat_t y = v0[1];
@@ -1282,7 +2246,15 @@ mfloat_t *vec3_multiply_mat3(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *vec3_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_multiply_mat3_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT v0, mfloat_t *MATHC_RESTRICT m0)
+{
+	result[0] = m0[0] * v0[0] + m0[3] * v0[1] + m0[6] * v0[2];
+	result[1] = m0[1] * v0[0] + m0[4] * v0[1] + m0[7] * v0[2];
+	result[2] = m0[2] * v0[0] + m0[5] * v0[1] + m0[8] * v0[2];
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] / v1[0];
 	result[1] = v0[1] / v1[1];
@@ -1290,7 +2262,7 @@ mfloat_t *vec3_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec3_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] / f;
 	result[1] = v0[1] / f;
@@ -1298,7 +2270,7 @@ mfloat_t *vec3_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec3_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFLOOR(v0[0] / v1[0]) * v1[0];
 	result[1] = MFLOOR(v0[1] / v1[1]) * v1[1];
@@ -1306,7 +2278,7 @@ mfloat_t *vec3_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec3_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = MFLOOR(v0[0] / f) * f;
 	result[1] = MFLOOR(v0[1] / f) * f;
@@ -1314,7 +2286,7 @@ mfloat_t *vec3_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec3_negative(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec3_negative(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = -v0[0];
 	result[1] = -v0[1];
@@ -1322,7 +2294,7 @@ mfloat_t *vec3_negative(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec3_abs(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec3_abs(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MFABS(v0[0]);
 	result[1] = MFABS(v0[1]);
@@ -1330,7 +2302,7 @@ mfloat_t *vec3_abs(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec3_floor(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec3_floor(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MFLOOR(v0[0]);
 	result[1] = MFLOOR(v0[1]);
@@ -1338,7 +2310,7 @@ mfloat_t *vec3_floor(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec3_ceil(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec3_ceil(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MCEIL(v0[0]);
 	result[1] = MCEIL(v0[1]);
@@ -1346,7 +2318,7 @@ mfloat_t *vec3_ceil(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec3_round(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec3_round(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MROUND(v0[0]);
 	result[1] = MROUND(v0[1]);
@@ -1354,7 +2326,7 @@ mfloat_t *vec3_round(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec3_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFMAX(v0[0], v1[0]);
 	result[1] = MFMAX(v0[1], v1[1]);
@@ -1362,7 +2334,7 @@ mfloat_t *vec3_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFMIN(v0[0], v1[0]);
 	result[1] = MFMIN(v0[1], v1[1]);
@@ -1370,14 +2342,14 @@ mfloat_t *vec3_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
+MATHC_API mfloat_t *vec3_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
 {
 	vec3_min(result, v0, v1);
-	vec3_max(result, v0, v2);
+	vec3_max(result, result, v2);
 	return result;
 }
 
-mfloat_t *vec3_cross(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_cross(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	mfloat_t cross[VEC3_SIZE];
 	cross[0] = v0[1] * v1[2] - v0[2] * v1[1];
@@ -1389,7 +2361,15 @@ mfloat_t *vec3_cross(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_normalize(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec3_cross_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT v0, mfloat_t *MATHC_RESTRICT v1)
+{
+	result[0] = v0[1] * v1[2] - v0[2] * v1[1];
+	result[1] = v0[2] * v1[0] - v0[0] * v1[2];
+	result[2] = v0[0] * v1[1] - v0[1] * v1[0];
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_normalize(mfloat_t *result, mfloat_t *v0)
 {
 	mfloat_t l = MSQRT(v0[0] * v0[0] + v0[1] * v0[1] + v0[2] * v0[2]);
 	result[0] = v0[0] / l;
@@ -1398,12 +2378,44 @@ mfloat_t *vec3_normalize(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t vec3_dot(mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_normalize_fast(mfloat_t *result, mfloat_t *v0)
+{
+	mfloat_t l = mathc_fast_rsqrt(v0[0] * v0[0] + v0[1] * v0[1] + v0[2] * v0[2] + MFLT_MIN);
+	result[0] = v0[0] * l;
+	result[1] = v0[1] * l;
+	result[2] = v0[2] * l;
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_normalize_n_fast(mfloat_t *result, mfloat_t *v0, size_t count)
+{
+	mfloat_t l[MATHC_STREAM_CHUNK];
+	size_t chunk;
+	size_t i;
+	for (chunk = 0; chunk < count; chunk += MATHC_STREAM_CHUNK) {
+		mfloat_t *a = v0 + chunk * VEC3_SIZE;
+		mfloat_t *r = result + chunk * VEC3_SIZE;
+		size_t n = count - chunk < MATHC_STREAM_CHUNK ? count - chunk : MATHC_STREAM_CHUNK;
+		for (i = 0; i < n; i++) {
+			mfloat_t *v = a + i * VEC3_SIZE;
+			l[i] = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + MFLT_MIN;
+		}
+		mathc_fast_rsqrt_n(l, n);
+		for (i = 0; i < n; i++) {
+			r[i * VEC3_SIZE] = a[i * VEC3_SIZE] * l[i];
+			r[i * VEC3_SIZE + 1] = a[i * VEC3_SIZE + 1] * l[i];
+			r[i * VEC3_SIZE + 2] = a[i * VEC3_SIZE + 2] * l[i];
+		}
+	}
+	return result;
+}
+
+MATHC_API mfloat_t vec3_dot(mfloat_t *v0, mfloat_t *v1)
 {
 	return v0[0] * v1[0] + v0[1] * v1[1] + v0[2] * v1[2];
 }
 
-mfloat_t *vec3_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec3_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	mfloat_t d = vec3_dot(v1, v1);
 	mfloat_t s = vec3_dot(v0, v1) / d;
@@ -1413,7 +2425,7 @@ mfloat_t *vec3_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec3_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
+MATHC_API mfloat_t *vec3_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 {
 	mfloat_t d = vec3_dot(v0, normal);
 	result[0] = v0[0] - normal[0] * d;
@@ -1422,7 +2434,7 @@ mfloat_t *vec3_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 	return result;
 }
 
-mfloat_t *vec3_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
+MATHC_API mfloat_t *vec3_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 {
 	mfloat_t d = MFLOAT_C(2.0) * vec3_dot(v0, normal);
 	result[0] = normal[0] * d - v0[0];
@@ -1431,7 +2443,7 @@ mfloat_t *vec3_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal)
 	return result;
 }
 
-mfloat_t *vec3_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f)
+MATHC_API mfloat_t *vec3_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f)
 {
 	mfloat_t cs;
 	mfloat_t sn;
@@ -1441,8 +2453,7 @@ mfloat_t *vec3_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f)
 	mfloat_t rx;
 	mfloat_t ry;
 	mfloat_t rz;
-	cs = MCOS(f);
-	sn = MSIN(f);
+	MSINCOS(f, &sn, &cs);
 	x = v0[0];
 	y = v0[1];
 	z = v0[2];
@@ -1456,7 +2467,22 @@ mfloat_t *vec3_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec3_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
+MATHC_API mfloat_t *vec3_rotate_quat(mfloat_t *result, mfloat_t *v0, mfloat_t *q0)
+{
+	/* v + 2 * w * (u x v) + 2 * u x (u x v), with u the vector part of q0 */
+	mfloat_t x = v0[0];
+	mfloat_t y = v0[1];
+	mfloat_t z = v0[2];
+	mfloat_t tx = MFLOAT_C(2.0) * (q0[1] * z - q0[2] * y);
+	mfloat_t ty = MFLOAT_C(2.0) * (q0[2] * x - q0[0] * z);
+	mfloat_t tz = MFLOAT_C(2.0) * (q0[0] * y - q0[1] * x);
+	result[0] = x + q0[3] * tx + q0[1] * tz - q0[2] * ty;
+	result[1] = y + q0[3] * ty + q0[2] * tx - q0[0] * tz;
+	result[2] = z + q0[3] * tz + q0[0] * ty - q0[1] * tx;
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
 {
 	result[0] = v0[0] + (v1[0] - v0[0]) * f;
 	result[1] = v0[1] + (v1[1] - v0[1]) * f;
@@ -1464,7 +2490,7 @@ mfloat_t *vec3_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec3_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v) {
+MATHC_API mfloat_t *vec3_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v) {
     mfloat_t tmp0[VEC3_SIZE];
     mfloat_t tmp1[VEC3_SIZE];
     vec3_lerp(tmp0, v0, v1, u);
@@ -1473,7 +2499,7 @@ mfloat_t *vec3_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *
     return result;
 }
 
-mfloat_t *vec3_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f)
+MATHC_API mfloat_t *vec3_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f)
 {
 	mfloat_t tmp0[VEC3_SIZE];
 	mfloat_t tmp1[VEC3_SIZE];
@@ -1483,7 +2509,7 @@ mfloat_t *vec3_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v
 	return result;
 }
 
-mfloat_t *vec3_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f)
+MATHC_API mfloat_t *vec3_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f)
 {
 	mfloat_t tmp0[VEC3_SIZE];
 	mfloat_t tmp1[VEC3_SIZE];
@@ -1499,39 +2525,39 @@ mfloat_t *vec3_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v
 	return result;
 }
 
-mfloat_t vec3_length(mfloat_t *v0)
+MATHC_API mfloat_t vec3_length(mfloat_t *v0)
 {
 	return MSQRT(v0[0] * v0[0] + v0[1] * v0[1] + v0[2] * v0[2]);
 }
 
-mfloat_t vec3_length_squared(mfloat_t *v0)
+MATHC_API mfloat_t vec3_length_squared(mfloat_t *v0)
 {
 	return v0[0] * v0[0] + v0[1] * v0[1] + v0[2] * v0[2];
 }
 
-mfloat_t vec3_distance(mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t vec3_distance(mfloat_t *v0, mfloat_t *v1)
 {
 	return MSQRT((v0[0] - v1[0]) * (v0[0] - v1[0]) + (v0[1] - v1[1]) * (v0[1] - v1[1]) + (v0[2] - v1[2]) * (v0[2] - v1[2]));
 }
 
-mfloat_t vec3_distance_squared(mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t vec3_distance_squared(mfloat_t *v0, mfloat_t *v1)
 {
 	return (v0[0] - v1[0]) * (v0[0] - v1[0]) + (v0[1] - v1[1]) * (v0[1] - v1[1]) + (v0[2] - v1[2]) * (v0[2] - v1[2]);
 }
 
-bool vec3_linear_independent(mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
+MATHC_API bool vec3_linear_independent(mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
 {
 	return v0[0] * v1[1] * v2[2] + v0[1] * v1[2] * v2[0] + v0[2] * v1[0] * v2[1]
 		- v0[2] * v1[1] * v2[0] - v0[1] * v1[0] * v2[2] - v0[0] * v1[2] * v2[1];
 }
 
-mfloat_t** vec3_orthonormalization(mfloat_t result[3][3], mfloat_t basis[3][3])
+MATHC_API mfloat_t** vec3_orthonormalization(mfloat_t result[3][3], mfloat_t basis[3][3])
 {
 	mfloat_t v0[3];
 	mfloat_t v1[3];
 	mfloat_t v2[3];
 
-	for(int32_t i = 0; i < 3; ++i) {
+	for(int i = 0; i < 3; ++i) {
 		v0[i] = basis[0][i];
 		v1[i] = basis[1][i];
 		v2[i] = basis[2][i];
@@ -1546,7 +2572,7 @@ mfloat_t** vec3_orthonormalization(mfloat_t result[3][3], mfloat_t basis[3][3])
 	mfloat_t u1[3];
 	mfloat_t u2[3];
 
-	for(int32_t i = 0; i < 3; ++i) {
+	for(int i = 0; i < 3; ++i) {
 		u0[i] = v0[i];
 	}
 
@@ -1565,89 +2591,454 @@ mfloat_t** vec3_orthonormalization(mfloat_t result[3][3], mfloat_t basis[3][3])
 	return (mfloat_t**)result;
 }
 
-bool vec4_is_zero(mfloat_t *v0)
+MATHC_API struct vec3_stream *vec3_stream_add(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1)
 {
-	return MFABS(v0[0]) < MFLT_EPSILON && MFABS(v0[1]) < MFLT_EPSILON && MFABS(v0[2]) < MFLT_EPSILON && MFABS(v0[3]) < MFLT_EPSILON;
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] + v1->x[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] + v1->y[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] + v1->z[i];
+	}
+	result->count = count;
+	return result;
 }
 
-bool vec4_is_equal(mfloat_t *v0, mfloat_t *v1)
+MATHC_API struct vec3_stream *vec3_stream_add_f(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t f)
 {
-	return MFABS(v0[0] - v1[0]) < MFLT_EPSILON && MFABS(v0[1] - v1[1]) < MFLT_EPSILON && MFABS(v0[2] - v1[2]) < MFLT_EPSILON && MFABS(v0[3] - v1[3]) < MFLT_EPSILON;
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] + f;
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] + f;
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] + f;
+	}
+	result->count = count;
+	return result;
 }
 
-mfloat_t *vec4(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w)
+MATHC_API struct vec3_stream *vec3_stream_subtract(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1)
 {
-	result[0] = x;
-	result[1] = y;
-	result[2] = z;
-	result[3] = w;
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] - v1->x[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] - v1->y[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] - v1->z[i];
+	}
+	result->count = count;
 	return result;
 }
 
-mfloat_t *vec4_assign(mfloat_t *result, mfloat_t *v0)
+MATHC_API struct vec3_stream *vec3_stream_subtract_f(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t f)
 {
-	result[0] = v0[0];
-	result[1] = v0[1];
-	result[2] = v0[2];
-	result[3] = v0[3];
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] - f;
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] - f;
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] - f;
+	}
+	result->count = count;
 	return result;
 }
 
-#if defined(MATHC_USE_INT)
-mfloat_t *vec4_assign_vec4i(mfloat_t *result, mint_t *v0)
+MATHC_API struct vec3_stream *vec3_stream_multiply(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1)
 {
-	result[0] = v0[0];
-	result[1] = v0[1];
-	result[2] = v0[2];
-	result[3] = v0[3];
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] * v1->x[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] * v1->y[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] * v1->z[i];
+	}
+	result->count = count;
 	return result;
 }
-#endif
 
-mfloat_t *vec4_zero(mfloat_t *result)
+MATHC_API struct vec3_stream *vec3_stream_multiply_f(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t f)
 {
-	result[0] = MFLOAT_C(0.0);
-	result[1] = MFLOAT_C(0.0);
-	result[2] = MFLOAT_C(0.0);
-	result[3] = MFLOAT_C(0.0);
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] * f;
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] * f;
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] * f;
+	}
+	result->count = count;
 	return result;
 }
 
-mfloat_t *vec4_one(mfloat_t *result)
+MATHC_API struct vec3_stream *vec3_stream_divide(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1)
 {
-	result[0] = MFLOAT_C(1.0);
-	result[1] = MFLOAT_C(1.0);
-	result[2] = MFLOAT_C(1.0);
-	result[3] = MFLOAT_C(1.0);
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] / v1->x[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] / v1->y[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] / v1->z[i];
+	}
+	result->count = count;
 	return result;
 }
 
-mfloat_t *vec4_sign(mfloat_t *result, mfloat_t *v0)
+MATHC_API struct vec3_stream *vec3_stream_divide_f(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t f)
 {
-	if (v0[0] > MFLOAT_C(0.0)) {
-		result[0] = MFLOAT_C(1.0);
-	} else if (v0[0] < 0) {
-		result[0] = -MFLOAT_C(1.0);
-	} else {
-		result[0] = MFLOAT_C(0.0);
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] / f;
 	}
-	if (v0[1] > MFLOAT_C(0.0)) {
-		result[1] = MFLOAT_C(1.0);
-	} else if (v0[1] < 0) {
-		result[1] = -MFLOAT_C(1.0);
-	} else {
-		result[1] = MFLOAT_C(0.0);
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] / f;
 	}
-	if (v0[2] > MFLOAT_C(0.0)) {
-		result[2] = MFLOAT_C(1.0);
-	} else if (v0[2] < 0) {
-		result[2] = -MFLOAT_C(1.0);
-	} else {
-		result[2] = MFLOAT_C(0.0);
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] / f;
 	}
-	if (v0[3] > MFLOAT_C(0.0)) {
-		result[3] = MFLOAT_C(1.0);
-	} else if (v0[3] < 0) {
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_negative(struct vec3_stream *result, struct vec3_stream *v0)
+{
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = -v0->x[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = -v0->y[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = -v0->z[i];
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_abs(struct vec3_stream *result, struct vec3_stream *v0)
+{
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = MFABS(v0->x[i]);
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = MFABS(v0->y[i]);
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = MFABS(v0->z[i]);
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_max(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1)
+{
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] > v1->x[i] ? v0->x[i] : v1->x[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] > v1->y[i] ? v0->y[i] : v1->y[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] > v1->z[i] ? v0->z[i] : v1->z[i];
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_min(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1)
+{
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] < v1->x[i] ? v0->x[i] : v1->x[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] < v1->y[i] ? v0->y[i] : v1->y[i];
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] < v1->z[i] ? v0->z[i] : v1->z[i];
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_clamp(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t *v1, mfloat_t *v2)
+{
+	size_t count = v0->count;
+	mfloat_t upper[VEC3_SIZE];
+	mfloat_t lower[VEC3_SIZE];
+	size_t i;
+	/* Same order as vec3_clamp(), the minimum with v1 then the maximum with v2 */
+	vec3_assign(upper, v1);
+	vec3_assign(lower, v2);
+	for (i = 0; i < count; i++) {
+		mfloat_t x = v0->x[i] < upper[0] ? v0->x[i] : upper[0];
+		result->x[i] = x > lower[0] ? x : lower[0];
+	}
+	for (i = 0; i < count; i++) {
+		mfloat_t y = v0->y[i] < upper[1] ? v0->y[i] : upper[1];
+		result->y[i] = y > lower[1] ? y : lower[1];
+	}
+	for (i = 0; i < count; i++) {
+		mfloat_t z = v0->z[i] < upper[2] ? v0->z[i] : upper[2];
+		result->z[i] = z > lower[2] ? z : lower[2];
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_cross(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1)
+{
+	size_t count = v0->count;
+	mfloat_t x[MATHC_STREAM_CHUNK];
+	mfloat_t y[MATHC_STREAM_CHUNK];
+	mfloat_t z[MATHC_STREAM_CHUNK];
+	size_t chunk;
+	size_t i;
+	for (chunk = 0; chunk < count; chunk += MATHC_STREAM_CHUNK) {
+		mfloat_t *ax = v0->x + chunk;
+		mfloat_t *ay = v0->y + chunk;
+		mfloat_t *az = v0->z + chunk;
+		mfloat_t *bx = v1->x + chunk;
+		mfloat_t *by = v1->y + chunk;
+		mfloat_t *bz = v1->z + chunk;
+		size_t n = count - chunk < MATHC_STREAM_CHUNK ? count - chunk : MATHC_STREAM_CHUNK;
+		for (i = 0; i < n; i++) {
+			x[i] = ay[i] * bz[i] - az[i] * by[i];
+			y[i] = az[i] * bx[i] - ax[i] * bz[i];
+			z[i] = ax[i] * by[i] - ay[i] * bx[i];
+		}
+		for (i = 0; i < n; i++) {
+			result->x[chunk + i] = x[i];
+		}
+		for (i = 0; i < n; i++) {
+			result->y[chunk + i] = y[i];
+		}
+		for (i = 0; i < n; i++) {
+			result->z[chunk + i] = z[i];
+		}
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_normalize(struct vec3_stream *result, struct vec3_stream *v0)
+{
+	size_t count = v0->count;
+	mfloat_t l[MATHC_STREAM_CHUNK];
+	size_t chunk;
+	size_t i;
+	for (chunk = 0; chunk < count; chunk += MATHC_STREAM_CHUNK) {
+		mfloat_t *x = v0->x + chunk;
+		mfloat_t *y = v0->y + chunk;
+		mfloat_t *z = v0->z + chunk;
+		size_t n = count - chunk < MATHC_STREAM_CHUNK ? count - chunk : MATHC_STREAM_CHUNK;
+		for (i = 0; i < n; i++) {
+			l[i] = MFLOAT_C(1.0) / MSQRT(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+		}
+		for (i = 0; i < n; i++) {
+			result->x[chunk + i] = x[i] * l[i];
+		}
+		for (i = 0; i < n; i++) {
+			result->y[chunk + i] = y[i] * l[i];
+		}
+		for (i = 0; i < n; i++) {
+			result->z[chunk + i] = z[i] * l[i];
+		}
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_normalize_fast(struct vec3_stream *result, struct vec3_stream *v0)
+{
+	size_t count = v0->count;
+	mfloat_t l[MATHC_STREAM_CHUNK];
+	size_t chunk;
+	size_t i;
+	for (chunk = 0; chunk < count; chunk += MATHC_STREAM_CHUNK) {
+		mfloat_t *x = v0->x + chunk;
+		mfloat_t *y = v0->y + chunk;
+		mfloat_t *z = v0->z + chunk;
+		size_t n = count - chunk < MATHC_STREAM_CHUNK ? count - chunk : MATHC_STREAM_CHUNK;
+		for (i = 0; i < n; i++) {
+			l[i] = x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + MFLT_MIN;
+		}
+		mathc_fast_rsqrt_n(l, n);
+		for (i = 0; i < n; i++) {
+			result->x[chunk + i] = x[i] * l[i];
+		}
+		for (i = 0; i < n; i++) {
+			result->y[chunk + i] = y[i] * l[i];
+		}
+		for (i = 0; i < n; i++) {
+			result->z[chunk + i] = z[i] * l[i];
+		}
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API struct vec3_stream *vec3_stream_lerp(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1, mfloat_t f)
+{
+	size_t count = v0->count;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result->x[i] = v0->x[i] + (v1->x[i] - v0->x[i]) * f;
+	}
+	for (i = 0; i < count; i++) {
+		result->y[i] = v0->y[i] + (v1->y[i] - v0->y[i]) * f;
+	}
+	for (i = 0; i < count; i++) {
+		result->z[i] = v0->z[i] + (v1->z[i] - v0->z[i]) * f;
+	}
+	result->count = count;
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_stream_dot(mfloat_t *result, struct vec3_stream *v0, struct vec3_stream *v1)
+{
+	size_t i;
+	for (i = 0; i < v0->count; i++) {
+		result[i] = v0->x[i] * v1->x[i] + v0->y[i] * v1->y[i] + v0->z[i] * v1->z[i];
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_stream_length(mfloat_t *result, struct vec3_stream *v0)
+{
+	size_t i;
+	for (i = 0; i < v0->count; i++) {
+		result[i] = MSQRT(v0->x[i] * v0->x[i] + v0->y[i] * v0->y[i] + v0->z[i] * v0->z[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_stream_length_squared(mfloat_t *result, struct vec3_stream *v0)
+{
+	size_t i;
+	for (i = 0; i < v0->count; i++) {
+		result[i] = v0->x[i] * v0->x[i] + v0->y[i] * v0->y[i] + v0->z[i] * v0->z[i];
+	}
+	return result;
+}
+
+MATHC_API bool vec4_is_zero(mfloat_t *v0)
+{
+	return MFABS(v0[0]) < MFLT_EPSILON && MFABS(v0[1]) < MFLT_EPSILON && MFABS(v0[2]) < MFLT_EPSILON && MFABS(v0[3]) < MFLT_EPSILON;
+}
+
+MATHC_API bool vec4_is_equal(mfloat_t *v0, mfloat_t *v1)
+{
+	return MFABS(v0[0] - v1[0]) < MFLT_EPSILON && MFABS(v0[1] - v1[1]) < MFLT_EPSILON && MFABS(v0[2] - v1[2]) < MFLT_EPSILON && MFABS(v0[3] - v1[3]) < MFLT_EPSILON;
+}
+
+MATHC_API mfloat_t *vec4(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w)
+{
+	result[0] = x;
+	result[1] = y;
+	result[2] = z;
+	result[3] = w;
+	return result;
+}
+
+MATHC_API mfloat_t *vec4_assign(mfloat_t *result, mfloat_t *v0)
+{
+	result[0] = v0[0];
+	result[1] = v0[1];
+	result[2] = v0[2];
+	result[3] = v0[3];
+	return result;
+}
+
+#if defined(MATHC_USE_INT)
+MATHC_API mfloat_t *vec4_assign_vec4i(mfloat_t *result, mint_t *v0)
+{
+	result[0] = v0[0];
+	result[1] = v0[1];
+	result[2] = v0[2];
+	result[3] = v0[3];
+	return result;
+}
+#endif
+
+MATHC_API mfloat_t *vec4_zero(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(0.0);
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	return result;
+}
+
+MATHC_API mfloat_t *vec4_one(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(1.0);
+	result[1] = MFLOAT_C(1.0);
+	result[2] = MFLOAT_C(1.0);
+	result[3] = MFLOAT_C(1.0);
+	return result;
+}
+
+MATHC_API mfloat_t *vec4_sign(mfloat_t *result, mfloat_t *v0)
+{
+	if (v0[0] > MFLOAT_C(0.0)) {
+		result[0] = MFLOAT_C(1.0);
+	} else if (v0[0] < 0) {
+		result[0] = -MFLOAT_C(1.0);
+	} else {
+		result[0] = MFLOAT_C(0.0);
+	}
+	if (v0[1] > MFLOAT_C(0.0)) {
+		result[1] = MFLOAT_C(1.0);
+	} else if (v0[1] < 0) {
+		result[1] = -MFLOAT_C(1.0);
+	} else {
+		result[1] = MFLOAT_C(0.0);
+	}
+	if (v0[2] > MFLOAT_C(0.0)) {
+		result[2] = MFLOAT_C(1.0);
+	} else if (v0[2] < 0) {
+		result[2] = -MFLOAT_C(1.0);
+	} else {
+		result[2] = MFLOAT_C(0.0);
+	}
+	if (v0[3] > MFLOAT_C(0.0)) {
+		result[3] = MFLOAT_C(1.0);
+	} else if (v0[3] < 0) {
 		result[3] = -MFLOAT_C(1.0);
 	} else {
 		result[3] = MFLOAT_C(0.0);
@@ -1655,7 +3046,7 @@ mfloat_t *vec4_sign(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec4_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec4_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] + v1[0];
 	result[1] = v0[1] + v1[1];
@@ -1664,7 +3055,7 @@ mfloat_t *vec4_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec4_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec4_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] + f;
 	result[1] = v0[1] + f;
@@ -1673,7 +3064,7 @@ mfloat_t *vec4_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec4_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec4_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] - v1[0];
 	result[1] = v0[1] - v1[1];
@@ -1682,7 +3073,7 @@ mfloat_t *vec4_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec4_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec4_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] - f;
 	result[1] = v0[1] - f;
@@ -1691,7 +3082,7 @@ mfloat_t *vec4_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec4_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec4_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] * v1[0];
 	result[1] = v0[1] * v1[1];
@@ -1700,7 +3091,7 @@ mfloat_t *vec4_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec4_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec4_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] * f;
 	result[1] = v0[1] * f;
@@ -1709,8 +3100,17 @@ mfloat_t *vec4_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
+MATHC_API mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 {
+#if defined(MATHC_SSE)
+	__m128 v = _mm_loadu_ps(v0);
+	__m128 r = _mm_mul_ps(_mm_loadu_ps(m0), _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+	r = MATHC_SSE_MADD(_mm_loadu_ps(m0 + 4), _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+	r = MATHC_SSE_MADD(_mm_loadu_ps(m0 + 8), _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+	r = MATHC_SSE_MADD(_mm_loadu_ps(m0 + 12), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+	_mm_storeu_ps(result, r);
+	return result;
+#else
 	mfloat_t x = v0[0];
 	mfloat_t y = v0[1];
 	mfloat_t z = v0[2];
@@ -1720,9 +3120,23 @@ mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0)
 	result[2] = m0[2] * x + m0[6] * y + m0[10] * z + m0[14] * w;
 	result[3] = m0[3] * x + m0[7] * y + m0[11] * z + m0[15] * w;
 	return result;
+#endif
+}
+
+MATHC_API mfloat_t *vec4_multiply_mat4_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT v0, mfloat_t *MATHC_RESTRICT m0)
+{
+#if defined(MATHC_SSE)
+	return vec4_multiply_mat4(result, v0, m0);
+#else
+	result[0] = m0[0] * v0[0] + m0[4] * v0[1] + m0[8] * v0[2] + m0[12] * v0[3];
+	result[1] = m0[1] * v0[0] + m0[5] * v0[1] + m0[9] * v0[2] + m0[13] * v0[3];
+	result[2] = m0[2] * v0[0] + m0[6] * v0[1] + m0[10] * v0[2] + m0[14] * v0[3];
+	result[3] = m0[3] * v0[0] + m0[7] * v0[1] + m0[11] * v0[2] + m0[15] * v0[3];
+	return result;
+#endif
 }
 
-mfloat_t *vec4_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec4_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = v0[0] / v1[0];
 	result[1] = v0[1] / v1[1];
@@ -1731,7 +3145,7 @@ mfloat_t *vec4_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec4_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec4_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = v0[0] / f;
 	result[1] = v0[1] / f;
@@ -1740,7 +3154,7 @@ mfloat_t *vec4_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec4_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec4_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFLOOR(v0[0] / v1[0]) * v1[0];
 	result[1] = MFLOOR(v0[1] / v1[1]) * v1[1];
@@ -1749,7 +3163,7 @@ mfloat_t *vec4_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec4_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *vec4_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
 	result[0] = MFLOOR(v0[0] / f) * f;
 	result[1] = MFLOOR(v0[1] / f) * f;
@@ -1758,7 +3172,7 @@ mfloat_t *vec4_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec4_negative(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec4_negative(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = -v0[0];
 	result[1] = -v0[1];
@@ -1767,7 +3181,7 @@ mfloat_t *vec4_negative(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec4_abs(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec4_abs(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MFABS(v0[0]);
 	result[1] = MFABS(v0[1]);
@@ -1776,7 +3190,7 @@ mfloat_t *vec4_abs(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec4_floor(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec4_floor(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MFLOOR(v0[0]);
 	result[1] = MFLOOR(v0[1]);
@@ -1785,7 +3199,7 @@ mfloat_t *vec4_floor(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec4_ceil(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec4_ceil(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MCEIL(v0[0]);
 	result[1] = MCEIL(v0[1]);
@@ -1794,7 +3208,7 @@ mfloat_t *vec4_ceil(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec4_round(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec4_round(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = MROUND(v0[0]);
 	result[1] = MROUND(v0[1]);
@@ -1803,7 +3217,7 @@ mfloat_t *vec4_round(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *vec4_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec4_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFMAX(v0[0], v1[0]);
 	result[1] = MFMAX(v0[1], v1[1]);
@@ -1812,7 +3226,7 @@ mfloat_t *vec4_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec4_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *vec4_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	result[0] = MFMIN(v0[0], v1[0]);
 	result[1] = MFMIN(v0[1], v1[1]);
@@ -1821,14 +3235,14 @@ mfloat_t *vec4_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 	return result;
 }
 
-mfloat_t *vec4_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
+MATHC_API mfloat_t *vec4_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
 {
 	vec4_min(result, v0, v1);
-	vec4_max(result, v0, v2);
+	vec4_max(result, result, v2);
 	return result;
 }
 
-mfloat_t *vec4_normalize(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *vec4_normalize(mfloat_t *result, mfloat_t *v0)
 {
 	mfloat_t l = MSQRT(v0[0] * v0[0] + v0[1] * v0[1] + v0[2] * v0[2] + v0[3] * v0[3]);
 	result[0] = v0[0] / l;
@@ -1838,11 +3252,21 @@ mfloat_t *vec4_normalize(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t vec4_dot(mfloat_t *v0, mfloat_t *v1) {
+MATHC_API mfloat_t *vec4_normalize_fast(mfloat_t *result, mfloat_t *v0)
+{
+	mfloat_t l = mathc_fast_rsqrt(v0[0] * v0[0] + v0[1] * v0[1] + v0[2] * v0[2] + v0[3] * v0[3] + MFLT_MIN);
+	result[0] = v0[0] * l;
+	result[1] = v0[1] * l;
+	result[2] = v0[2] * l;
+	result[3] = v0[3] * l;
+	return result;
+}
+
+MATHC_API mfloat_t vec4_dot(mfloat_t *v0, mfloat_t *v1) {
     return v0[0] * v1[0] + v0[1] * v1[1] + v0[2] * v1[2] + v0[3] * v1[3];
 }
 
-mfloat_t *vec4_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
+MATHC_API mfloat_t *vec4_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
 {
 	result[0] = v0[0] + (v1[0] - v0[0]) * f;
 	result[1] = v0[1] + (v1[1] - v0[1]) * f;
@@ -1851,26 +3275,26 @@ mfloat_t *vec4_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f)
 	return result;
 }
 
-mfloat_t *vec4_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v) {
-    mfloat_t tmp0[VEC2_SIZE];
-    mfloat_t tmp1[VEC2_SIZE];
+MATHC_API mfloat_t *vec4_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v) {
+    mfloat_t tmp0[VEC4_SIZE];
+    mfloat_t tmp1[VEC4_SIZE];
     vec4_lerp(tmp0, v0, v1, u);
     vec4_lerp(tmp1, v2, v3, u);
     vec4_lerp(result, tmp0, tmp1, v);
     return result;
 }
 
-bool quat_is_zero(mfloat_t *q0)
+MATHC_API bool quat_is_zero(mfloat_t *q0)
 {
 	return MFABS(q0[0]) < MFLT_EPSILON && MFABS(q0[1]) < MFLT_EPSILON && MFABS(q0[2]) < MFLT_EPSILON && MFABS(q0[3]) < MFLT_EPSILON;
 }
 
-bool quat_is_equal(mfloat_t *q0, mfloat_t *q1)
+MATHC_API bool quat_is_equal(mfloat_t *q0, mfloat_t *q1)
 {
 	return MFABS(q0[0] - q1[0]) < MFLT_EPSILON && MFABS(q0[1] - q1[1]) < MFLT_EPSILON && MFABS(q0[2] - q1[2]) < MFLT_EPSILON && MFABS(q0[3] - q1[3]) < MFLT_EPSILON;
 }
 
-mfloat_t *quat(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w)
+MATHC_API mfloat_t *quat(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w)
 {
 	result[0] = x;
 	result[1] = y;
@@ -1879,7 +3303,7 @@ mfloat_t *quat(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w)
 	return result;
 }
 
-mfloat_t *quat_assign(mfloat_t *result, mfloat_t *q0)
+MATHC_API mfloat_t *quat_assign(mfloat_t *result, mfloat_t *q0)
 {
 	result[0] = q0[0];
 	result[1] = q0[1];
@@ -1888,7 +3312,7 @@ mfloat_t *quat_assign(mfloat_t *result, mfloat_t *q0)
 	return result;
 }
 
-mfloat_t *quat_zero(mfloat_t *result)
+MATHC_API mfloat_t *quat_zero(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(0.0);
 	result[1] = MFLOAT_C(0.0);
@@ -1897,7 +3321,7 @@ mfloat_t *quat_zero(mfloat_t *result)
 	return result;
 }
 
-mfloat_t *quat_null(mfloat_t *result)
+MATHC_API mfloat_t *quat_null(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(0.0);
 	result[1] = MFLOAT_C(0.0);
@@ -1906,16 +3330,21 @@ mfloat_t *quat_null(mfloat_t *result)
 	return result;
 }
 
-mfloat_t *quat_multiply(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
+MATHC_API mfloat_t *quat_multiply(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
 {
-	result[0] = q0[3] * q1[0] + q0[0] * q1[3] + q0[1] * q1[2] - q0[2] * q1[1];
-	result[1] = q0[3] * q1[1] + q0[1] * q1[3] + q0[2] * q1[0] - q0[0] * q1[2];
-	result[2] = q0[3] * q1[2] + q0[2] * q1[3] + q0[0] * q1[1] - q0[1] * q1[0];
-	result[3] = q0[3] * q1[3] - q0[0] * q1[0] - q0[1] * q1[1] - q0[2] * q1[2];
+	mfloat_t multiplied[QUAT_SIZE];
+	multiplied[0] = q0[3] * q1[0] + q0[0] * q1[3] + q0[1] * q1[2] - q0[2] * q1[1];
+	multiplied[1] = q0[3] * q1[1] + q0[1] * q1[3] + q0[2] * q1[0] - q0[0] * q1[2];
+	multiplied[2] = q0[3] * q1[2] + q0[2] * q1[3] + q0[0] * q1[1] - q0[1] * q1[0];
+	multiplied[3] = q0[3] * q1[3] - q0[0] * q1[0] - q0[1] * q1[1] - q0[2] * q1[2];
+	result[0] = multiplied[0];
+	result[1] = multiplied[1];
+	result[2] = multiplied[2];
+	result[3] = multiplied[3];
 	return result;
 }
 
-mfloat_t *quat_multiply_f(mfloat_t *result, mfloat_t *q0, mfloat_t f)
+MATHC_API mfloat_t *quat_multiply_f(mfloat_t *result, mfloat_t *q0, mfloat_t f)
 {
 	result[0] = q0[0] * f;
 	result[1] = q0[1] * f;
@@ -1924,16 +3353,16 @@ mfloat_t *quat_multiply_f(mfloat_t *result, mfloat_t *q0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *quat_divide(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
+MATHC_API mfloat_t *quat_divide(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
 {
 	mfloat_t x = q0[0];
 	mfloat_t y = q0[1];
 	mfloat_t z = q0[2];
 	mfloat_t w = q0[3];
-	mfloat_t ls = q1[0] * q1[0] + q1[1] * q1[1] + q1[8] * q1[8] + q1[3] * q1[3];
+	mfloat_t ls = q1[0] * q1[0] + q1[1] * q1[1] + q1[2] * q1[2] + q1[3] * q1[3];
 	mfloat_t normalized_x = -q1[0] / ls;
 	mfloat_t normalized_y = -q1[1] / ls;
-	mfloat_t normalized_z = -q1[8] / ls;
+	mfloat_t normalized_z = -q1[2] / ls;
 	mfloat_t normalized_w = q1[3] / ls;
 	result[0] = x * normalized_w + normalized_x * w + (y * normalized_z - z * normalized_y);
 	result[1] = y * normalized_w + normalized_y * w + (z * normalized_x - x * normalized_z);
@@ -1942,7 +3371,7 @@ mfloat_t *quat_divide(mfloat_t *result, mfloat_t *q0, mfloat_t *q1)
 	return result;
 }
 
-mfloat_t *quat_divide_f(mfloat_t *result, mfloat_t *q0, mfloat_t f)
+MATHC_API mfloat_t *quat_divide_f(mfloat_t *result, mfloat_t *q0, mfloat_t f)
 {
 	result[0] = q0[0] / f;
 	result[1] = q0[1] / f;
@@ -1951,7 +3380,7 @@ mfloat_t *quat_divide_f(mfloat_t *result, mfloat_t *q0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *quat_negative(mfloat_t *result, mfloat_t *q0)
+MATHC_API mfloat_t *quat_negative(mfloat_t *result, mfloat_t *q0)
 {
 	result[0] = -q0[0];
 	result[1] = -q0[1];
@@ -1960,7 +3389,7 @@ mfloat_t *quat_negative(mfloat_t *result, mfloat_t *q0)
 	return result;
 }
 
-mfloat_t *quat_conjugate(mfloat_t *result, mfloat_t *q0)
+MATHC_API mfloat_t *quat_conjugate(mfloat_t *result, mfloat_t *q0)
 {
 	result[0] = -q0[0];
 	result[1] = -q0[1];
@@ -1969,7 +3398,7 @@ mfloat_t *quat_conjugate(mfloat_t *result, mfloat_t *q0)
 	return result;
 }
 
-mfloat_t *quat_inverse(mfloat_t *result, mfloat_t *q0)
+MATHC_API mfloat_t *quat_inverse(mfloat_t *result, mfloat_t *q0)
 {
 	mfloat_t l = MFLOAT_C(1.0) / (q0[0] * q0[0] + q0[1] * q0[1] + q0[2] * q0[2] + q0[3] * q0[3]);
 	result[0] = -q0[0] * l;
@@ -1979,7 +3408,7 @@ mfloat_t *quat_inverse(mfloat_t *result, mfloat_t *q0)
 	return result;
 }
 
-mfloat_t *quat_normalize(mfloat_t *result, mfloat_t *q0)
+MATHC_API mfloat_t *quat_normalize(mfloat_t *result, mfloat_t *q0)
 {
 	mfloat_t l = MFLOAT_C(1.0) / MSQRT(q0[0] * q0[0] + q0[1] * q0[1] + q0[2] * q0[2] + q0[3] * q0[3]);
 	result[0] = q0[0] * l;
@@ -1989,89 +3418,124 @@ mfloat_t *quat_normalize(mfloat_t *result, mfloat_t *q0)
 	return result;
 }
 
-mfloat_t quat_dot(mfloat_t *q0, mfloat_t *q1)
+MATHC_API mfloat_t *quat_normalize_fast(mfloat_t *result, mfloat_t *q0)
+{
+	mfloat_t l = mathc_fast_rsqrt(q0[0] * q0[0] + q0[1] * q0[1] + q0[2] * q0[2] + q0[3] * q0[3] + MFLT_MIN);
+	result[0] = q0[0] * l;
+	result[1] = q0[1] * l;
+	result[2] = q0[2] * l;
+	result[3] = q0[3] * l;
+	return result;
+}
+
+MATHC_API mfloat_t *quat_normalize_n_fast(mfloat_t *result, mfloat_t *q0, size_t count)
+{
+	mfloat_t l[MATHC_STREAM_CHUNK];
+	size_t chunk;
+	size_t i;
+	for (chunk = 0; chunk < count; chunk += MATHC_STREAM_CHUNK) {
+		mfloat_t *a = q0 + chunk * QUAT_SIZE;
+		mfloat_t *r = result + chunk * QUAT_SIZE;
+		size_t n = count - chunk < MATHC_STREAM_CHUNK ? count - chunk : MATHC_STREAM_CHUNK;
+		for (i = 0; i < n; i++) {
+			mfloat_t *q = a + i * QUAT_SIZE;
+			l[i] = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3] + MFLT_MIN;
+		}
+		mathc_fast_rsqrt_n(l, n);
+		for (i = 0; i < n; i++) {
+			r[i * QUAT_SIZE] = a[i * QUAT_SIZE] * l[i];
+			r[i * QUAT_SIZE + 1] = a[i * QUAT_SIZE + 1] * l[i];
+			r[i * QUAT_SIZE + 2] = a[i * QUAT_SIZE + 2] * l[i];
+			r[i * QUAT_SIZE + 3] = a[i * QUAT_SIZE + 3] * l[i];
+		}
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quat_dot(mfloat_t *q0, mfloat_t *q1)
 {
 	return q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
 }
 
-mfloat_t *quat_power(mfloat_t *result, mfloat_t *q0, mfloat_t exponent)
+MATHC_API mfloat_t *quat_power(mfloat_t *result, mfloat_t *q0, mfloat_t exponent)
 {
 	if (MFABS(q0[3]) < MFLOAT_C(1.0) - MFLT_EPSILON) {
 		mfloat_t alpha = MACOS(q0[3]);
 		mfloat_t new_alpha = alpha * exponent;
 		mfloat_t s = MSIN(new_alpha) / MSIN(alpha);
-		result[0] = result[0] * s;
-		result[1] = result[1] * s;
-		result[2] = result[2] * s;
+		result[0] = q0[0] * s;
+		result[1] = q0[1] * s;
+		result[2] = q0[2] * s;
 		result[3] = MCOS(new_alpha);
 	} else {
 		result[0] = q0[0];
 		result[1] = q0[1];
-		result[2] = q0[1];
+		result[2] = q0[2];
 		result[3] = q0[3];
 	}
 	return result;
 }
 
-mfloat_t *quat_from_axis_angle(mfloat_t *result, mfloat_t *v0, mfloat_t angle)
+MATHC_API mfloat_t *quat_from_axis_angle(mfloat_t *result, mfloat_t *v0, mfloat_t angle)
 {
-	mfloat_t half = angle * MFLOAT_C(0.5);
-	mfloat_t s = MSIN(half);
+	mfloat_t s;
+	mfloat_t c;
+	MSINCOS(angle * MFLOAT_C(0.5), &s, &c);
 	result[0] = v0[0] * s;
 	result[1] = v0[1] * s;
 	result[2] = v0[2] * s;
-	result[3] = MCOS(half);
+	result[3] = c;
 	return result;
 }
 
-mfloat_t *quat_from_vec3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
+MATHC_API mfloat_t *quat_from_vec3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1)
 {
 	mfloat_t cross[VEC3_SIZE];
 	mfloat_t d = vec3_dot(v0, v1);
 	mfloat_t a_ls = vec3_length_squared(v0);
-	mfloat_t b_ls = vec3_length_squared(v0);
+	mfloat_t b_ls = vec3_length_squared(v1);
 	vec3_cross(cross, v0, v1);
-	quat(result, cross[0], cross[1], cross[1], d + MSQRT(a_ls * b_ls));
+	quat(result, cross[0], cross[1], cross[2], d + MSQRT(a_ls * b_ls));
 	quat_normalize(result, result);
 	return result;
 }
 
-mfloat_t *quat_from_mat4(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *quat_from_mat4(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t scale = m0[0] + m0[5] + m0[10];
 	if (scale > MFLOAT_C(0.0)) {
 		mfloat_t sr = MSQRT(scale + MFLOAT_C(1.0));
 		result[3] = sr * MFLOAT_C(0.5);
 		sr = MFLOAT_C(0.5) / sr;
-		result[0] = (m0[9] - m0[6]) * sr;
-		result[1] = (m0[2] - m0[8]) * sr;
-		result[2] = (m0[4] - m0[1]) * sr;
+		result[0] = (m0[6] - m0[9]) * sr;
+		result[1] = (m0[8] - m0[2]) * sr;
+		result[2] = (m0[1] - m0[4]) * sr;
 	} else if ((m0[0] >= m0[5]) && (m0[0] >= m0[10])) {
 		mfloat_t sr = MSQRT(MFLOAT_C(1.0) + m0[0] - m0[5] - m0[10]);
 		mfloat_t half = MFLOAT_C(0.5) / sr;
 		result[0] = MFLOAT_C(0.5) * sr;
 		result[1] = (m0[4] + m0[1]) * half;
 		result[2] = (m0[8] + m0[2]) * half;
-		result[3] = (m0[9] - m0[6]) * half;
+		result[3] = (m0[6] - m0[9]) * half;
 	} else if (m0[5] > m0[10]) {
 		mfloat_t sr = MSQRT(MFLOAT_C(1.0) + m0[5] - m0[0] - m0[10]);
 		mfloat_t half = MFLOAT_C(0.5) / sr;
 		result[0] = (m0[1] + m0[4]) * half;
 		result[1] = MFLOAT_C(0.5) * sr;
 		result[2] = (m0[6] + m0[9]) * half;
-		result[3] = (m0[2] - m0[8]) * half;
+		result[3] = (m0[8] - m0[2]) * half;
 	} else {
 		mfloat_t sr = MSQRT(MFLOAT_C(1.0) + m0[10] - m0[0] - m0[5]);
 		mfloat_t half = MFLOAT_C(0.5) / sr;
 		result[0] = (m0[2] + m0[8]) * half;
 		result[1] = (m0[6] + m0[9]) * half;
 		result[2] = MFLOAT_C(0.5) * sr;
-		result[3] = (m0[4] - m0[1]) * half;
+		result[3] = (m0[1] - m0[4]) * half;
 	}
 	return result;
 }
 
-mfloat_t *quat_lerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f)
+MATHC_API mfloat_t *quat_lerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f)
 {
 	result[0] = q0[0] + (q1[0] - q0[0]) * f;
 	result[1] = q0[1] + (q1[1] - q0[1]) * f;
@@ -2080,7 +3544,7 @@ mfloat_t *quat_lerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f)
 	return result;
 }
 
-mfloat_t *quat_slerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f)
+MATHC_API mfloat_t *quat_slerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f)
 {
 	mfloat_t tmp1[QUAT_SIZE];
 	mfloat_t d = quat_dot(q0, q1);
@@ -2107,24 +3571,217 @@ mfloat_t *quat_slerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f)
 	return result;
 }
 
-mfloat_t quat_length(mfloat_t *q0)
+MATHC_API mfloat_t *quat_slerp_n(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		quat_slerp(result + i * QUAT_SIZE, q0 + i * QUAT_SIZE, q1 + i * QUAT_SIZE, f);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *quat_slerp_n_fast(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f, size_t count)
+{
+	mfloat_t dots[MATHC_STREAM_CHUNK];
+	mfloat_t f0[MATHC_STREAM_CHUNK];
+	mfloat_t f1[MATHC_STREAM_CHUNK];
+	size_t i;
+	size_t j;
+	size_t n;
+	/* The weights are computed for a chunk of pairs first, so those loops run
+	 * across quaternions rather than across the components of one. Both
+	 * square roots go through mathc_fast_rsqrt_n(), since a loop calling
+	 * MSQRT only vectorizes with -fno-math-errno */
+	for (i = 0; i < count; i += n) {
+		n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			mfloat_t *a = q0 + (i + j) * QUAT_SIZE;
+			mfloat_t *b = q1 + (i + j) * QUAT_SIZE;
+			mfloat_t d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+			mfloat_t ad = MFABS(d);
+			/* The bias keeps both finite when ad reaches 1 */
+			dots[j] = d;
+			f0[j] = MFABS(MFLOAT_C(1.0) - ad) + MFLT_MIN;
+			f1[j] = MFABS(MFLOAT_C(1.0) - ad * ad) + MFLT_EPSILON * MFLT_EPSILON;
+		}
+		mathc_fast_rsqrt_n(f0, n);
+		mathc_fast_rsqrt_n(f1, n);
+		for (j = 0; j < n; j++) {
+			mfloat_t d = dots[j];
+			mfloat_t ad = MFABS(d);
+			/* Both the spherical and the linear weights are computed and
+			 * blended without branches. The linear fallback above 0.9995
+			 * matches quat_slerp() */
+			mfloat_t theta = MFABS(MFLOAT_C(1.0) - ad) * f0[j] * mathc_fast_acos_polynomial(ad);
+			mfloat_t s0 = mathc_fast_sin_half_pi((MFLOAT_C(1.0) - f) * theta) * f1[j];
+			mfloat_t s1 = mathc_fast_sin_half_pi(f * theta) * f1[j];
+			mfloat_t linear = (mfloat_t)(ad > MFLOAT_C(0.9995));
+			f0[j] = s0 + (MFLOAT_C(1.0) - f - s0) * linear;
+			f1[j] = (s1 + (f - s1) * linear) * MCOPYSIGN(MFLOAT_C(1.0), d);
+		}
+		for (j = 0; j < n; j++) {
+			mfloat_t *a = q0 + (i + j) * QUAT_SIZE;
+			mfloat_t *b = q1 + (i + j) * QUAT_SIZE;
+			mfloat_t *r = result + (i + j) * QUAT_SIZE;
+			mfloat_t x = a[0] * f0[j] + b[0] * f1[j];
+			mfloat_t y = a[1] * f0[j] + b[1] * f1[j];
+			mfloat_t z = a[2] * f0[j] + b[2] * f1[j];
+			mfloat_t w = a[3] * f0[j] + b[3] * f1[j];
+			r[0] = x;
+			r[1] = y;
+			r[2] = z;
+			r[3] = w;
+		}
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *quat_nlerp_n(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		mfloat_t *a = q0 + i * QUAT_SIZE;
+		mfloat_t *b = q1 + i * QUAT_SIZE;
+		mfloat_t *r = result + i * QUAT_SIZE;
+		mfloat_t d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+		mfloat_t f0 = MFLOAT_C(1.0) - f;
+		mfloat_t f1 = d < MFLOAT_C(0.0) ? -f : f;
+		mfloat_t x = a[0] * f0 + b[0] * f1;
+		mfloat_t y = a[1] * f0 + b[1] * f1;
+		mfloat_t z = a[2] * f0 + b[2] * f1;
+		mfloat_t w = a[3] * f0 + b[3] * f1;
+		mfloat_t l = MFLOAT_C(1.0) / MSQRT(x * x + y * y + z * z + w * w);
+		r[0] = x * l;
+		r[1] = y * l;
+		r[2] = z * l;
+		r[3] = w * l;
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quat_length(mfloat_t *q0)
 {
 	return MSQRT(q0[0] * q0[0] + q0[1] * q0[1] + q0[2] * q0[2] + q0[3] * q0[3]);
 }
 
-mfloat_t quat_length_squared(mfloat_t *q0)
+MATHC_API mfloat_t quat_length_squared(mfloat_t *q0)
 {
 	return q0[0] * q0[0] + q0[1] * q0[1] + q0[2] * q0[2] + q0[3] * q0[3];
 }
 
-mfloat_t quat_angle(mfloat_t *q0, mfloat_t *q1)
+MATHC_API mfloat_t quat_angle(mfloat_t *q0, mfloat_t *q1)
 {
 	mfloat_t s = MSQRT(quat_length_squared(q0) * quat_length_squared(q1));
 	s = MFLOAT_C(1.0) / s;
 	return MACOS(quat_dot(q0, q1) * s);
 }
 
-mfloat_t *mat2(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22)
+MATHC_API mfloat_t *trs(mfloat_t *result, mfloat_t *v0, mfloat_t *q0, mfloat_t *v1)
+{
+	result[0] = v0[0];
+	result[1] = v0[1];
+	result[2] = v0[2];
+	result[3] = q0[0];
+	result[4] = q0[1];
+	result[5] = q0[2];
+	result[6] = q0[3];
+	result[7] = v1[0];
+	result[8] = v1[1];
+	result[9] = v1[2];
+	return result;
+}
+
+MATHC_API mfloat_t *trs_identity(mfloat_t *result)
+{
+	result[0] = MFLOAT_C(0.0);
+	result[1] = MFLOAT_C(0.0);
+	result[2] = MFLOAT_C(0.0);
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(0.0);
+	result[5] = MFLOAT_C(0.0);
+	result[6] = MFLOAT_C(1.0);
+	result[7] = MFLOAT_C(1.0);
+	result[8] = MFLOAT_C(1.0);
+	result[9] = MFLOAT_C(1.0);
+	return result;
+}
+
+MATHC_API mfloat_t *trs_assign(mfloat_t *result, mfloat_t *t0)
+{
+	result[0] = t0[0];
+	result[1] = t0[1];
+	result[2] = t0[2];
+	result[3] = t0[3];
+	result[4] = t0[4];
+	result[5] = t0[5];
+	result[6] = t0[6];
+	result[7] = t0[7];
+	result[8] = t0[8];
+	result[9] = t0[9];
+	return result;
+}
+
+MATHC_API mfloat_t *trs_multiply(mfloat_t *result, mfloat_t *t0, mfloat_t *t1)
+{
+	mfloat_t translation[VEC3_SIZE];
+	mfloat_t rotation[QUAT_SIZE];
+	mfloat_t scaling[VEC3_SIZE];
+	/* The translation of t1 is scaled, rotated and moved by t0 */
+	translation[0] = t1[0] * t0[7];
+	translation[1] = t1[1] * t0[8];
+	translation[2] = t1[2] * t0[9];
+	vec3_rotate_quat(translation, translation, t0 + 3);
+	translation[0] = translation[0] + t0[0];
+	translation[1] = translation[1] + t0[1];
+	translation[2] = translation[2] + t0[2];
+	quat_multiply(rotation, t0 + 3, t1 + 3);
+	scaling[0] = t0[7] * t1[7];
+	scaling[1] = t0[8] * t1[8];
+	scaling[2] = t0[9] * t1[9];
+	return trs(result, translation, rotation, scaling);
+}
+
+MATHC_API mfloat_t *trs_inverse(mfloat_t *result, mfloat_t *t0)
+{
+	mfloat_t translation[VEC3_SIZE];
+	mfloat_t rotation[QUAT_SIZE];
+	mfloat_t scaling[VEC3_SIZE];
+	scaling[0] = MFLOAT_C(1.0) / t0[7];
+	scaling[1] = MFLOAT_C(1.0) / t0[8];
+	scaling[2] = MFLOAT_C(1.0) / t0[9];
+	quat_conjugate(rotation, t0 + 3);
+	vec3_rotate_quat(translation, t0, rotation);
+	translation[0] = -translation[0] * scaling[0];
+	translation[1] = -translation[1] * scaling[1];
+	translation[2] = -translation[2] * scaling[2];
+	return trs(result, translation, rotation, scaling);
+}
+
+MATHC_API mfloat_t *trs_lerp(mfloat_t *result, mfloat_t *t0, mfloat_t *t1, mfloat_t f)
+{
+	mfloat_t translation[VEC3_SIZE];
+	mfloat_t rotation[QUAT_SIZE];
+	mfloat_t scaling[VEC3_SIZE];
+	vec3_lerp(translation, t0, t1, f);
+	quat_slerp(rotation, t0 + 3, t1 + 3, f);
+	vec3_lerp(scaling, t0 + 7, t1 + 7, f);
+	return trs(result, translation, rotation, scaling);
+}
+
+MATHC_API mfloat_t *trs_transform_point(mfloat_t *result, mfloat_t *v0, mfloat_t *t0)
+{
+	mfloat_t scaled[VEC3_SIZE];
+	scaled[0] = v0[0] * t0[7];
+	scaled[1] = v0[1] * t0[8];
+	scaled[2] = v0[2] * t0[9];
+	vec3_rotate_quat(result, scaled, t0 + 3);
+	result[0] = result[0] + t0[0];
+	result[1] = result[1] + t0[1];
+	result[2] = result[2] + t0[2];
+	return result;
+}
+
+MATHC_API mfloat_t *mat2(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22)
 {
 	result[0] = m11;
 	result[1] = m21;
@@ -2133,7 +3790,7 @@ mfloat_t *mat2(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloa
 	return result;
 }
 
-mfloat_t *mat2_zero(mfloat_t *result)
+MATHC_API mfloat_t *mat2_zero(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(0.0);
 	result[1] = MFLOAT_C(0.0);
@@ -2142,7 +3799,7 @@ mfloat_t *mat2_zero(mfloat_t *result)
 	return result;
 }
 
-mfloat_t *mat2_identity(mfloat_t *result)
+MATHC_API mfloat_t *mat2_identity(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(1.0);
 	result[1] = MFLOAT_C(0.0);
@@ -2151,12 +3808,12 @@ mfloat_t *mat2_identity(mfloat_t *result)
 	return result;
 }
 
-mfloat_t mat2_determinant(mfloat_t *m0)
+MATHC_API mfloat_t mat2_determinant(mfloat_t *m0)
 {
 	return m0[0] * m0[3] - m0[2] * m0[1];
 }
 
-mfloat_t *mat2_assign(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat2_assign(mfloat_t *result, mfloat_t *m0)
 {
 	result[0] = m0[0];
 	result[1] = m0[1];
@@ -2165,7 +3822,7 @@ mfloat_t *mat2_assign(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat2_negative(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat2_negative(mfloat_t *result, mfloat_t *m0)
 {
 	result[0] = -m0[0];
 	result[1] = -m0[1];
@@ -2174,7 +3831,7 @@ mfloat_t *mat2_negative(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat2_transpose(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat2_transpose(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t transposed[MAT2_SIZE];
 	transposed[0] = m0[0];
@@ -2188,7 +3845,16 @@ mfloat_t *mat2_transpose(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat2_cofactor(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat2_transpose_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0)
+{
+	result[0] = m0[0];
+	result[1] = m0[2];
+	result[2] = m0[1];
+	result[3] = m0[3];
+	return result;
+}
+
+MATHC_API mfloat_t *mat2_cofactor(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t cofactor[MAT2_SIZE];
 	cofactor[0] = m0[3];
@@ -2202,7 +3868,7 @@ mfloat_t *mat2_cofactor(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat2_adjugate(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat2_adjugate(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t adjugate[MAT2_SIZE];
 	adjugate[0] = m0[3];
@@ -2216,7 +3882,7 @@ mfloat_t *mat2_adjugate(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat2_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+MATHC_API mfloat_t *mat2_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
 {
 	mfloat_t multiplied[MAT3_SIZE];
 	multiplied[0] = m0[0] * m1[0] + m0[2] * m1[1];
@@ -2230,7 +3896,16 @@ mfloat_t *mat2_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
 	return result;
 }
 
-mfloat_t *mat2_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
+MATHC_API mfloat_t *mat2_multiply_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0, mfloat_t *MATHC_RESTRICT m1)
+{
+	result[0] = m0[0] * m1[0] + m0[2] * m1[1];
+	result[1] = m0[1] * m1[0] + m0[3] * m1[1];
+	result[2] = m0[0] * m1[2] + m0[2] * m1[3];
+	result[3] = m0[1] * m1[2] + m0[3] * m1[3];
+	return result;
+}
+
+MATHC_API mfloat_t *mat2_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 {
 	result[0] = m0[0] * f;
 	result[1] = m0[1] * f;
@@ -2239,11 +3914,11 @@ mfloat_t *mat2_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat2_inverse(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat2_inverse(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t inverse[MAT2_SIZE];
 	mfloat_t det = mat2_determinant(m0);
-	mat2_cofactor(inverse, m0);
+	mat2_adjugate(inverse, m0);
 	mat2_multiply_f(inverse, inverse, MFLOAT_C(1.0) / det);
 	result[0] = inverse[0];
 	result[1] = inverse[1];
@@ -2252,24 +3927,25 @@ mfloat_t *mat2_inverse(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat2_scaling(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *mat2_scaling(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = v0[0];
 	result[3] = v0[1];
 	return result;
 }
 
-mfloat_t *mat2_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
+MATHC_API mfloat_t *mat2_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 {
 	result[0] = m0[0] * v0[0];
 	result[3] = m0[3] * v0[1];
 	return result;
 }
 
-mfloat_t *mat2_rotation_z(mfloat_t *result, mfloat_t f)
+MATHC_API mfloat_t *mat2_rotation_z(mfloat_t *result, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
+	mfloat_t c;
+	mfloat_t s;
+	MSINCOS(f, &s, &c);
 	result[0] = c;
 	result[1] = s;
 	result[2] = -s;
@@ -2277,7 +3953,7 @@ mfloat_t *mat2_rotation_z(mfloat_t *result, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat2_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
+MATHC_API mfloat_t *mat2_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
 {
 	result[0] = m0[0] + (m1[0] - m0[0]) * f;
 	result[1] = m0[1] + (m1[1] - m0[1]) * f;
@@ -2286,7 +3962,7 @@ mfloat_t *mat2_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat3(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m31, mfloat_t m32, mfloat_t m33)
+MATHC_API mfloat_t *mat3(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m31, mfloat_t m32, mfloat_t m33)
 {
 	result[0] = m11;
 	result[1] = m21;
@@ -2300,7 +3976,7 @@ mfloat_t *mat3(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloa
 	return result;
 }
 
-mfloat_t *mat3_zero(mfloat_t *result)
+MATHC_API mfloat_t *mat3_zero(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(0.0);
 	result[1] = MFLOAT_C(0.0);
@@ -2314,7 +3990,7 @@ mfloat_t *mat3_zero(mfloat_t *result)
 	return result;
 }
 
-mfloat_t *mat3_identity(mfloat_t *result)
+MATHC_API mfloat_t *mat3_identity(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(1.0);
 	result[1] = MFLOAT_C(0.0);
@@ -2328,7 +4004,7 @@ mfloat_t *mat3_identity(mfloat_t *result)
 	return result;
 }
 
-mfloat_t mat3_determinant(mfloat_t *m0)
+MATHC_API mfloat_t mat3_determinant(mfloat_t *m0)
 {
 	mfloat_t m11 = m0[0];
 	mfloat_t m21 = m0[1];
@@ -2348,7 +4024,7 @@ mfloat_t mat3_determinant(mfloat_t *m0)
 	return determinant;
 }
 
-mfloat_t *mat3_assign(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat3_assign(mfloat_t *result, mfloat_t *m0)
 {
 	result[0] = m0[0];
 	result[1] = m0[1];
@@ -2362,7 +4038,7 @@ mfloat_t *mat3_assign(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat3_negative(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat3_negative(mfloat_t *result, mfloat_t *m0)
 {
 	result[0] = -m0[0];
 	result[1] = -m0[1];
@@ -2376,7 +4052,7 @@ mfloat_t *mat3_negative(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat3_transpose(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat3_transpose(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t transposed[MAT4_SIZE];
 	transposed[0] = m0[0];
@@ -2400,7 +4076,21 @@ mfloat_t *mat3_transpose(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat3_cofactor(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat3_transpose_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0)
+{
+	result[0] = m0[0];
+	result[1] = m0[3];
+	result[2] = m0[6];
+	result[3] = m0[1];
+	result[4] = m0[4];
+	result[5] = m0[7];
+	result[6] = m0[2];
+	result[7] = m0[5];
+	result[8] = m0[8];
+	return result;
+}
+
+MATHC_API mfloat_t *mat3_cofactor(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t cofactor[MAT3_SIZE];
 	mfloat_t minor[MAT2_SIZE];
@@ -2461,7 +4151,7 @@ mfloat_t *mat3_cofactor(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat3_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+MATHC_API mfloat_t *mat3_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
 {
 	mfloat_t multiplied[MAT3_SIZE];
 	multiplied[0] = m0[0] * m1[0] + m0[3] * m1[1] + m0[6] * m1[2];
@@ -2485,7 +4175,21 @@ mfloat_t *mat3_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
 	return result;
 }
 
-mfloat_t *mat3_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
+MATHC_API mfloat_t *mat3_multiply_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0, mfloat_t *MATHC_RESTRICT m1)
+{
+	result[0] = m0[0] * m1[0] + m0[3] * m1[1] + m0[6] * m1[2];
+	result[1] = m0[1] * m1[0] + m0[4] * m1[1] + m0[7] * m1[2];
+	result[2] = m0[2] * m1[0] + m0[5] * m1[1] + m0[8] * m1[2];
+	result[3] = m0[0] * m1[3] + m0[3] * m1[4] + m0[6] * m1[5];
+	result[4] = m0[1] * m1[3] + m0[4] * m1[4] + m0[7] * m1[5];
+	result[5] = m0[2] * m1[3] + m0[5] * m1[4] + m0[8] * m1[5];
+	result[6] = m0[0] * m1[6] + m0[3] * m1[7] + m0[6] * m1[8];
+	result[7] = m0[1] * m1[6] + m0[4] * m1[7] + m0[7] * m1[8];
+	result[8] = m0[2] * m1[6] + m0[5] * m1[7] + m0[8] * m1[8];
+	return result;
+}
+
+MATHC_API mfloat_t *mat3_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 {
 	result[0] = m0[0] * f;
 	result[1] = m0[1] * f;
@@ -2499,7 +4203,7 @@ mfloat_t *mat3_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat3_inverse(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat3_inverse(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t inverse[MAT3_SIZE];
 	mfloat_t inverted_determinant;
@@ -2534,7 +4238,7 @@ mfloat_t *mat3_inverse(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat3_scaling(mfloat_t *result, mfloat_t *v0)
+MATHC_API mfloat_t *mat3_scaling(mfloat_t *result, mfloat_t *v0)
 {
 	result[0] = v0[0];
 	result[4] = v0[1];
@@ -2542,7 +4246,7 @@ mfloat_t *mat3_scaling(mfloat_t *result, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *mat3_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
+MATHC_API mfloat_t *mat3_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 {
 	result[0] = m0[0] * v0[0];
 	result[4] = m0[4] * v0[1];
@@ -2550,10 +4254,11 @@ mfloat_t *mat3_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *mat3_rotation_x(mfloat_t *result, mfloat_t f)
+MATHC_API mfloat_t *mat3_rotation_x(mfloat_t *result, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
+	mfloat_t c;
+	mfloat_t s;
+	MSINCOS(f, &s, &c);
 	result[4] = c;
 	result[5] = s;
 	result[7] = -s;
@@ -2561,10 +4266,11 @@ mfloat_t *mat3_rotation_x(mfloat_t *result, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat3_rotation_y(mfloat_t *result, mfloat_t f)
+MATHC_API mfloat_t *mat3_rotation_y(mfloat_t *result, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
+	mfloat_t c;
+	mfloat_t s;
+	MSINCOS(f, &s, &c);
 	result[0] = c;
 	result[2] = -s;
 	result[6] = s;
@@ -2572,10 +4278,11 @@ mfloat_t *mat3_rotation_y(mfloat_t *result, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat3_rotation_z(mfloat_t *result, mfloat_t f)
+MATHC_API mfloat_t *mat3_rotation_z(mfloat_t *result, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
+	mfloat_t c;
+	mfloat_t s;
+	MSINCOS(f, &s, &c);
 	result[0] = c;
 	result[1] = s;
 	result[3] = -s;
@@ -2583,11 +4290,11 @@ mfloat_t *mat3_rotation_z(mfloat_t *result, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat3_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *mat3_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
-	mfloat_t one_c = MFLOAT_C(1.0) - c;
+	mfloat_t c;
+	mfloat_t s;
+	mfloat_t one_c;
 	mfloat_t x = v0[0];
 	mfloat_t y = v0[1];
 	mfloat_t z = v0[2];
@@ -2599,6 +4306,8 @@ mfloat_t *mat3_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	mfloat_t zz = z * z;
 	mfloat_t l = xx + yy + zz;
 	mfloat_t sqrt_l = MSQRT(l);
+	MSINCOS(f, &s, &c);
+	one_c = MFLOAT_C(1.0) - c;
 	result[0] = (xx + (yy + zz) * c) / l;
 	result[1] = (xy * one_c + v0[2] * sqrt_l * s) / l;
 	result[2] = (xz * one_c - v0[1] * sqrt_l * s) / l;
@@ -2611,30 +4320,30 @@ mfloat_t *mat3_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat3_rotation_quat(mfloat_t *result, mfloat_t *q0)
+MATHC_API mfloat_t *mat3_rotation_quat(mfloat_t *result, mfloat_t *q0)
 {
 	mfloat_t xx = q0[0] * q0[0];
 	mfloat_t yy = q0[1] * q0[1];
 	mfloat_t zz = q0[2] * q0[2];
 	mfloat_t xy = q0[0] * q0[1];
 	mfloat_t zw = q0[2] * q0[3];
-	mfloat_t xz = q0[8] * q0[0];
+	mfloat_t xz = q0[0] * q0[2];
 	mfloat_t yw = q0[1] * q0[3];
 	mfloat_t yz = q0[1] * q0[2];
 	mfloat_t xw = q0[0] * q0[3];
-	result[0] = MFLOAT_C(1.0) - MFLOAT_C(2.0) * (yy - zz);
+	result[0] = MFLOAT_C(1.0) - MFLOAT_C(2.0) * (yy + zz);
 	result[1] = MFLOAT_C(2.0) * (xy + zw);
 	result[2] = MFLOAT_C(2.0) * (xz - yw);
 	result[3] = MFLOAT_C(2.0) * (xy - zw);
-	result[4] = MFLOAT_C(1.0) - MFLOAT_C(2.0) * (xx - zz);
+	result[4] = MFLOAT_C(1.0) - MFLOAT_C(2.0) * (xx + zz);
 	result[5] = MFLOAT_C(2.0) * (yz + xw);
 	result[6] = MFLOAT_C(2.0) * (xz + yw);
 	result[7] = MFLOAT_C(2.0) * (yz - xw);
-	result[8] = MFLOAT_C(1.0) - MFLOAT_C(2.0) * (xx - yy);
+	result[8] = MFLOAT_C(1.0) - MFLOAT_C(2.0) * (xx + yy);
 	return result;
 }
 
-mfloat_t *mat3_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
+MATHC_API mfloat_t *mat3_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
 {
 	result[0] = m0[0] + (m1[0] - m0[0]) * f;
 	result[1] = m0[1] + (m1[1] - m0[1]) * f;
@@ -2648,28 +4357,73 @@ mfloat_t *mat3_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat4(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34, mfloat_t m41, mfloat_t m42, mfloat_t m43, mfloat_t m44)
+MATHC_API mfloat_t *mat3_to_std140(mfloat_t *result, mfloat_t *m0)
 {
-	result[0] = m11;
-	result[1] = m21;
-	result[2] = m31;
-	result[3] = m41;
-	result[4] = m12;
-	result[5] = m22;
-	result[6] = m32;
-	result[7] = m42;
-	result[8] = m13;
-	result[9] = m23;
-	result[10] = m33;
-	result[11] = m43;
-	result[12] = m14;
-	result[13] = m24;
-	result[14] = m34;
-	result[15] = m44;
-	return result;
+	/* Each column padded to four elements, as mat3 is laid out in std140
+	 * and std430 blocks */
+	result[0] = m0[0];
+	result[1] = m0[1];
+	result[2] = m0[2];
+	result[3] = MFLOAT_C(0.0);
+	result[4] = m0[3];
+	result[5] = m0[4];
+	result[6] = m0[5];
+	result[7] = MFLOAT_C(0.0);
+	result[8] = m0[6];
+	result[9] = m0[7];
+	result[10] = m0[8];
+	result[11] = MFLOAT_C(0.0);
+	return result;
+}
+
+MATHC_API mfloat_t *mat3_from_std140(mfloat_t *result, mfloat_t *m0)
+{
+	result[0] = m0[0];
+	result[1] = m0[1];
+	result[2] = m0[2];
+	result[3] = m0[4];
+	result[4] = m0[5];
+	result[5] = m0[6];
+	result[6] = m0[8];
+	result[7] = m0[9];
+	result[8] = m0[10];
+	return result;
+}
+
+MATHC_API mfloat_t *mat3_to_std140_n(mfloat_t *result, mfloat_t *m0, size_t count, size_t stride)
+{
+	size_t i;
+	if (stride == 0) {
+		stride = MAT3_STD140_SIZE * sizeof(mfloat_t);
+	}
+	for (i = 0; i < count; i++) {
+		mat3_to_std140((mfloat_t *)((char *)result + i * stride), m0 + i * MAT3_SIZE);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *mat4(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34, mfloat_t m41, mfloat_t m42, mfloat_t m43, mfloat_t m44)
+{
+	result[0] = m11;
+	result[1] = m21;
+	result[2] = m31;
+	result[3] = m41;
+	result[4] = m12;
+	result[5] = m22;
+	result[6] = m32;
+	result[7] = m42;
+	result[8] = m13;
+	result[9] = m23;
+	result[10] = m33;
+	result[11] = m43;
+	result[12] = m14;
+	result[13] = m24;
+	result[14] = m34;
+	result[15] = m44;
+	return result;
 }
 
-mfloat_t *mat4_zero(mfloat_t *result)
+MATHC_API mfloat_t *mat4_zero(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(0.0);
 	result[1] = MFLOAT_C(0.0);
@@ -2690,7 +4444,7 @@ mfloat_t *mat4_zero(mfloat_t *result)
 	return result;
 }
 
-mfloat_t *mat4_identity(mfloat_t *result)
+MATHC_API mfloat_t *mat4_identity(mfloat_t *result)
 {
 	result[0] = MFLOAT_C(1.0);
 	result[1] = MFLOAT_C(0.0);
@@ -2711,7 +4465,7 @@ mfloat_t *mat4_identity(mfloat_t *result)
 	return result;
 }
 
-mfloat_t mat4_determinant(mfloat_t *m0)
+MATHC_API mfloat_t mat4_determinant(mfloat_t *m0)
 {
 	mfloat_t m11 = m0[0];
 	mfloat_t m21 = m0[1];
@@ -2744,7 +4498,7 @@ mfloat_t mat4_determinant(mfloat_t *m0)
 	return determinant;
 }
 
-mfloat_t *mat4_assign(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat4_assign(mfloat_t *result, mfloat_t *m0)
 {
 	result[0] = m0[0];
 	result[1] = m0[1];
@@ -2765,7 +4519,7 @@ mfloat_t *mat4_assign(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat4_negative(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat4_negative(mfloat_t *result, mfloat_t *m0)
 {
 	result[0] = -m0[0];
 	result[1] = -m0[1];
@@ -2786,8 +4540,20 @@ mfloat_t *mat4_negative(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat4_transpose(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat4_transpose(mfloat_t *result, mfloat_t *m0)
 {
+#if defined(MATHC_SSE)
+	__m128 c0 = _mm_loadu_ps(m0);
+	__m128 c1 = _mm_loadu_ps(m0 + 4);
+	__m128 c2 = _mm_loadu_ps(m0 + 8);
+	__m128 c3 = _mm_loadu_ps(m0 + 12);
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	_mm_storeu_ps(result, c0);
+	_mm_storeu_ps(result + 4, c1);
+	_mm_storeu_ps(result + 8, c2);
+	_mm_storeu_ps(result + 12, c3);
+	return result;
+#else
 	mfloat_t transposed[MAT4_SIZE];
 	transposed[0] = m0[0];
 	transposed[1] = m0[4];
@@ -2822,9 +4588,35 @@ mfloat_t *mat4_transpose(mfloat_t *result, mfloat_t *m0)
 	result[14] = transposed[14];
 	result[15] = transposed[15];
 	return result;
+#endif
+}
+
+MATHC_API mfloat_t *mat4_transpose_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0)
+{
+#if defined(MATHC_SSE)
+	return mat4_transpose(result, m0);
+#else
+	result[0] = m0[0];
+	result[1] = m0[4];
+	result[2] = m0[8];
+	result[3] = m0[12];
+	result[4] = m0[1];
+	result[5] = m0[5];
+	result[6] = m0[9];
+	result[7] = m0[13];
+	result[8] = m0[2];
+	result[9] = m0[6];
+	result[10] = m0[10];
+	result[11] = m0[14];
+	result[12] = m0[3];
+	result[13] = m0[7];
+	result[14] = m0[11];
+	result[15] = m0[15];
+	return result;
+#endif
 }
 
-mfloat_t *mat4_cofactor(mfloat_t *result, mfloat_t *m0)
+MATHC_API mfloat_t *mat4_cofactor(mfloat_t *result, mfloat_t *m0)
 {
 	mfloat_t cofactor[MAT4_SIZE];
 	mfloat_t minor[MAT3_SIZE];
@@ -3007,10 +4799,11 @@ mfloat_t *mat4_cofactor(mfloat_t *result, mfloat_t *m0)
 	return result;
 }
 
-mfloat_t *mat4_rotation_x(mfloat_t *result, mfloat_t f)
+MATHC_API mfloat_t *mat4_rotation_x(mfloat_t *result, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
+	mfloat_t c;
+	mfloat_t s;
+	MSINCOS(f, &s, &c);
 	result[5] = c;
 	result[6] = s;
 	result[9] = -s;
@@ -3018,10 +4811,11 @@ mfloat_t *mat4_rotation_x(mfloat_t *result, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat4_rotation_y(mfloat_t *result, mfloat_t f)
+MATHC_API mfloat_t *mat4_rotation_y(mfloat_t *result, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
+	mfloat_t c;
+	mfloat_t s;
+	MSINCOS(f, &s, &c);
 	result[0] = c;
 	result[2] = -s;
 	result[8] = s;
@@ -3029,10 +4823,11 @@ mfloat_t *mat4_rotation_y(mfloat_t *result, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat4_rotation_z(mfloat_t *result, mfloat_t f)
+MATHC_API mfloat_t *mat4_rotation_z(mfloat_t *result, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
+	mfloat_t c;
+	mfloat_t s;
+	MSINCOS(f, &s, &c);
 	result[0] = c;
 	result[1] = s;
 	result[4] = -s;
@@ -3040,11 +4835,11 @@ mfloat_t *mat4_rotation_z(mfloat_t *result, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat4_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
+MATHC_API mfloat_t *mat4_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 {
-	mfloat_t c = MCOS(f);
-	mfloat_t s = MSIN(f);
-	mfloat_t one_c = MFLOAT_C(1.0) - c;
+	mfloat_t c;
+	mfloat_t s;
+	mfloat_t one_c;
 	mfloat_t x = v0[0];
 	mfloat_t y = v0[1];
 	mfloat_t z = v0[2];
@@ -3056,6 +4851,8 @@ mfloat_t *mat4_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	mfloat_t zz = z * z;
 	mfloat_t l = xx + yy + zz;
 	mfloat_t sqrt_l = MSQRT(l);
+	MSINCOS(f, &s, &c);
+	one_c = MFLOAT_C(1.0) - c;
 	result[0] = (xx + (yy + zz) * c) / l;
 	result[1] = (xy * one_c + v0[2] * sqrt_l * s) / l;
 	result[2] = (xz * one_c - v0[1] * sqrt_l * s) / l;
@@ -3075,7 +4872,7 @@ mfloat_t *mat4_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat4_rotation_quat(mfloat_t *result, mfloat_t *q0)
+MATHC_API mfloat_t *mat4_rotation_quat(mfloat_t *result, mfloat_t *q0)
 {
 	mfloat_t xx = q0[0] * q0[0];
 	mfloat_t yy = q0[1] * q0[1];
@@ -3105,7 +4902,40 @@ mfloat_t *mat4_rotation_quat(mfloat_t *result, mfloat_t *q0)
 	return result;
 }
 
-mfloat_t *mat4_translation(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
+MATHC_API mfloat_t *mat4_from_trs(mfloat_t *result, mfloat_t *t0)
+{
+	mfloat_t xx = t0[3] * t0[3];
+	mfloat_t yy = t0[4] * t0[4];
+	mfloat_t zz = t0[5] * t0[5];
+	mfloat_t xy = t0[3] * t0[4];
+	mfloat_t zw = t0[5] * t0[6];
+	mfloat_t xz = t0[3] * t0[5];
+	mfloat_t yw = t0[4] * t0[6];
+	mfloat_t yz = t0[4] * t0[5];
+	mfloat_t xw = t0[3] * t0[6];
+	mfloat_t sx = t0[7];
+	mfloat_t sy = t0[8];
+	mfloat_t sz = t0[9];
+	result[0] = (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (yy + zz)) * sx;
+	result[1] = MFLOAT_C(2.0) * (xy + zw) * sx;
+	result[2] = MFLOAT_C(2.0) * (xz - yw) * sx;
+	result[3] = MFLOAT_C(0.0);
+	result[4] = MFLOAT_C(2.0) * (xy - zw) * sy;
+	result[5] = (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (xx + zz)) * sy;
+	result[6] = MFLOAT_C(2.0) * (yz + xw) * sy;
+	result[7] = MFLOAT_C(0.0);
+	result[8] = MFLOAT_C(2.0) * (xz + yw) * sz;
+	result[9] = MFLOAT_C(2.0) * (yz - xw) * sz;
+	result[10] = (MFLOAT_C(1.0) - MFLOAT_C(2.0) * (xx + yy)) * sz;
+	result[11] = MFLOAT_C(0.0);
+	result[12] = t0[0];
+	result[13] = t0[1];
+	result[14] = t0[2];
+	result[15] = MFLOAT_C(1.0);
+	return result;
+}
+
+MATHC_API mfloat_t *mat4_translation(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 {
 	result[0] = m0[0];
 	result[1] = m0[1];
@@ -3126,7 +4956,7 @@ mfloat_t *mat4_translation(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *mat4_translate(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
+MATHC_API mfloat_t *mat4_translate(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 {
 	result[0] = m0[0];
 	result[1] = m0[1];
@@ -3147,7 +4977,7 @@ mfloat_t *mat4_translate(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *mat4_scaling(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
+MATHC_API mfloat_t *mat4_scaling(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 {
 	result[0] = v0[0];
 	result[1] = m0[1];
@@ -3168,7 +4998,7 @@ mfloat_t *mat4_scaling(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *mat4_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
+MATHC_API mfloat_t *mat4_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 {
 	result[0] = m0[0] * v0[0];
 	result[1] = m0[1];
@@ -3189,8 +5019,29 @@ mfloat_t *mat4_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0)
 	return result;
 }
 
-mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+MATHC_API mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
 {
+#if defined(MATHC_SSE)
+	__m128 a0 = _mm_loadu_ps(m0);
+	__m128 a1 = _mm_loadu_ps(m0 + 4);
+	__m128 a2 = _mm_loadu_ps(m0 + 8);
+	__m128 a3 = _mm_loadu_ps(m0 + 12);
+	__m128 multiplied[4];
+	int i;
+	for (i = 0; i < 4; i++) {
+		__m128 b = _mm_loadu_ps(m1 + i * 4);
+		__m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = MATHC_SSE_MADD(a1, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = MATHC_SSE_MADD(a2, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = MATHC_SSE_MADD(a3, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		multiplied[i] = r;
+	}
+	_mm_storeu_ps(result, multiplied[0]);
+	_mm_storeu_ps(result + 4, multiplied[1]);
+	_mm_storeu_ps(result + 8, multiplied[2]);
+	_mm_storeu_ps(result + 12, multiplied[3]);
+	return result;
+#else
 	mfloat_t multiplied[MAT4_SIZE];
 	multiplied[0] = m0[0] * m1[0] + m0[4] * m1[1] + m0[8] * m1[2] + m0[12] * m1[3];
 	multiplied[1] = m0[1] * m1[0] + m0[5] * m1[1] + m0[9] * m1[2] + m0[13] * m1[3];
@@ -3225,9 +5076,315 @@ mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
 	result[14] = multiplied[14];
 	result[15] = multiplied[15];
 	return result;
+#endif
+}
+
+MATHC_API mfloat_t *mat4_multiply_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0, mfloat_t *MATHC_RESTRICT m1)
+{
+#if defined(MATHC_SSE)
+	return mat4_multiply(result, m0, m1);
+#else
+	result[0] = m0[0] * m1[0] + m0[4] * m1[1] + m0[8] * m1[2] + m0[12] * m1[3];
+	result[1] = m0[1] * m1[0] + m0[5] * m1[1] + m0[9] * m1[2] + m0[13] * m1[3];
+	result[2] = m0[2] * m1[0] + m0[6] * m1[1] + m0[10] * m1[2] + m0[14] * m1[3];
+	result[3] = m0[3] * m1[0] + m0[7] * m1[1] + m0[11] * m1[2] + m0[15] * m1[3];
+	result[4] = m0[0] * m1[4] + m0[4] * m1[5] + m0[8] * m1[6] + m0[12] * m1[7];
+	result[5] = m0[1] * m1[4] + m0[5] * m1[5] + m0[9] * m1[6] + m0[13] * m1[7];
+	result[6] = m0[2] * m1[4] + m0[6] * m1[5] + m0[10] * m1[6] + m0[14] * m1[7];
+	result[7] = m0[3] * m1[4] + m0[7] * m1[5] + m0[11] * m1[6] + m0[15] * m1[7];
+	result[8] = m0[0] * m1[8] + m0[4] * m1[9] + m0[8] * m1[10] + m0[12] * m1[11];
+	result[9] = m0[1] * m1[8] + m0[5] * m1[9] + m0[9] * m1[10] + m0[13] * m1[11];
+	result[10] = m0[2] * m1[8] + m0[6] * m1[9] + m0[10] * m1[10] + m0[14] * m1[11];
+	result[11] = m0[3] * m1[8] + m0[7] * m1[9] + m0[11] * m1[10] + m0[15] * m1[11];
+	result[12] = m0[0] * m1[12] + m0[4] * m1[13] + m0[8] * m1[14] + m0[12] * m1[15];
+	result[13] = m0[1] * m1[12] + m0[5] * m1[13] + m0[9] * m1[14] + m0[13] * m1[15];
+	result[14] = m0[2] * m1[12] + m0[6] * m1[13] + m0[10] * m1[14] + m0[14] * m1[15];
+	result[15] = m0[3] * m1[12] + m0[7] * m1[13] + m0[11] * m1[14] + m0[15] * m1[15];
+	return result;
+#endif
+}
+
+MATHC_API mfloat_t *mat4_multiply_affine(mfloat_t *result, mfloat_t *m0, mfloat_t *m1)
+{
+	/* The last row of m1 is (0, 0, 0, 1), so each column of m0 contributes
+	 * to at most one term */
+#if defined(MATHC_SSE)
+	__m128 a0 = _mm_loadu_ps(m0);
+	__m128 a1 = _mm_loadu_ps(m0 + 4);
+	__m128 a2 = _mm_loadu_ps(m0 + 8);
+	__m128 a3 = _mm_loadu_ps(m0 + 12);
+	__m128 multiplied[4];
+	int i;
+	for (i = 0; i < 4; i++) {
+		__m128 b = _mm_loadu_ps(m1 + i * 4);
+		__m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = MATHC_SSE_MADD(a1, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = MATHC_SSE_MADD(a2, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		multiplied[i] = r;
+	}
+	multiplied[3] = _mm_add_ps(multiplied[3], a3);
+	_mm_storeu_ps(result, multiplied[0]);
+	_mm_storeu_ps(result + 4, multiplied[1]);
+	_mm_storeu_ps(result + 8, multiplied[2]);
+	_mm_storeu_ps(result + 12, multiplied[3]);
+	return result;
+#else
+	mfloat_t multiplied[MAT4_SIZE];
+	multiplied[0] = m0[0] * m1[0] + m0[4] * m1[1] + m0[8] * m1[2];
+	multiplied[1] = m0[1] * m1[0] + m0[5] * m1[1] + m0[9] * m1[2];
+	multiplied[2] = m0[2] * m1[0] + m0[6] * m1[1] + m0[10] * m1[2];
+	multiplied[3] = m0[3] * m1[0] + m0[7] * m1[1] + m0[11] * m1[2];
+	multiplied[4] = m0[0] * m1[4] + m0[4] * m1[5] + m0[8] * m1[6];
+	multiplied[5] = m0[1] * m1[4] + m0[5] * m1[5] + m0[9] * m1[6];
+	multiplied[6] = m0[2] * m1[4] + m0[6] * m1[5] + m0[10] * m1[6];
+	multiplied[7] = m0[3] * m1[4] + m0[7] * m1[5] + m0[11] * m1[6];
+	multiplied[8] = m0[0] * m1[8] + m0[4] * m1[9] + m0[8] * m1[10];
+	multiplied[9] = m0[1] * m1[8] + m0[5] * m1[9] + m0[9] * m1[10];
+	multiplied[10] = m0[2] * m1[8] + m0[6] * m1[9] + m0[10] * m1[10];
+	multiplied[11] = m0[3] * m1[8] + m0[7] * m1[9] + m0[11] * m1[10];
+	multiplied[12] = m0[0] * m1[12] + m0[4] * m1[13] + m0[8] * m1[14] + m0[12];
+	multiplied[13] = m0[1] * m1[12] + m0[5] * m1[13] + m0[9] * m1[14] + m0[13];
+	multiplied[14] = m0[2] * m1[12] + m0[6] * m1[13] + m0[10] * m1[14] + m0[14];
+	multiplied[15] = m0[3] * m1[12] + m0[7] * m1[13] + m0[11] * m1[14] + m0[15];
+	result[0] = multiplied[0];
+	result[1] = multiplied[1];
+	result[2] = multiplied[2];
+	result[3] = multiplied[3];
+	result[4] = multiplied[4];
+	result[5] = multiplied[5];
+	result[6] = multiplied[6];
+	result[7] = multiplied[7];
+	result[8] = multiplied[8];
+	result[9] = multiplied[9];
+	result[10] = multiplied[10];
+	result[11] = multiplied[11];
+	result[12] = multiplied[12];
+	result[13] = multiplied[13];
+	result[14] = multiplied[14];
+	result[15] = multiplied[15];
+	return result;
+#endif
+}
+
+MATHC_API mfloat_t *mat4_multiply_n(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, size_t count)
+{
+	size_t i;
+	int column;
+	/* The left operand is loaded before any store and each column of the
+	 * right operand is loaded before the matching column is written, so
+	 * result may alias m0 or m1 without a temporary matrix */
+	for (i = 0; i < count; i++) {
+		mfloat_t *r = result + i * MAT4_SIZE;
+		mfloat_t *b = m1 + i * MAT4_SIZE;
+#if defined(MATHC_SSE)
+		__m128 a0 = _mm_loadu_ps(m0 + i * MAT4_SIZE);
+		__m128 a1 = _mm_loadu_ps(m0 + i * MAT4_SIZE + 4);
+		__m128 a2 = _mm_loadu_ps(m0 + i * MAT4_SIZE + 8);
+		__m128 a3 = _mm_loadu_ps(m0 + i * MAT4_SIZE + 12);
+		for (column = 0; column < 4; column++) {
+			__m128 c = _mm_loadu_ps(b + column * 4);
+			__m128 v = _mm_mul_ps(a0, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0)));
+			v = MATHC_SSE_MADD(a1, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)), v);
+			v = MATHC_SSE_MADD(a2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2)), v);
+			v = MATHC_SSE_MADD(a3, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3)), v);
+			_mm_storeu_ps(r + column * 4, v);
+		}
+#else
+		mfloat_t a[MAT4_SIZE];
+		int k;
+		for (k = 0; k < MAT4_SIZE; k++) {
+			a[k] = m0[i * MAT4_SIZE + k];
+		}
+		for (column = 0; column < 4; column++) {
+			mfloat_t b0 = b[column * 4];
+			mfloat_t b1 = b[column * 4 + 1];
+			mfloat_t b2 = b[column * 4 + 2];
+			mfloat_t b3 = b[column * 4 + 3];
+			r[column * 4] = a[0] * b0 + a[4] * b1 + a[8] * b2 + a[12] * b3;
+			r[column * 4 + 1] = a[1] * b0 + a[5] * b1 + a[9] * b2 + a[13] * b3;
+			r[column * 4 + 2] = a[2] * b0 + a[6] * b1 + a[10] * b2 + a[14] * b3;
+			r[column * 4 + 3] = a[3] * b0 + a[7] * b1 + a[11] * b2 + a[15] * b3;
+		}
+#endif
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *mat4_multiply_n_left(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, size_t count)
+{
+	size_t i;
+	int column;
+	/* The shared operand is loaded once before the loop, it may be part of
+	 * the result array, and each column of the right operand is loaded
+	 * before the matching column is written */
+#if defined(MATHC_SSE)
+	__m128 a0 = _mm_loadu_ps(m0);
+	__m128 a1 = _mm_loadu_ps(m0 + 4);
+	__m128 a2 = _mm_loadu_ps(m0 + 8);
+	__m128 a3 = _mm_loadu_ps(m0 + 12);
+	for (i = 0; i < count; i++) {
+		mfloat_t *r = result + i * MAT4_SIZE;
+		mfloat_t *b = m1 + i * MAT4_SIZE;
+		for (column = 0; column < 4; column++) {
+			__m128 c = _mm_loadu_ps(b + column * 4);
+			__m128 v = _mm_mul_ps(a0, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0)));
+			v = MATHC_SSE_MADD(a1, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)), v);
+			v = MATHC_SSE_MADD(a2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2)), v);
+			v = MATHC_SSE_MADD(a3, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3)), v);
+			_mm_storeu_ps(r + column * 4, v);
+		}
+	}
+#else
+	mfloat_t a[MAT4_SIZE];
+	mat4_assign(a, m0);
+	for (i = 0; i < count; i++) {
+		mfloat_t *r = result + i * MAT4_SIZE;
+		mfloat_t *b = m1 + i * MAT4_SIZE;
+		for (column = 0; column < 4; column++) {
+			mfloat_t b0 = b[column * 4];
+			mfloat_t b1 = b[column * 4 + 1];
+			mfloat_t b2 = b[column * 4 + 2];
+			mfloat_t b3 = b[column * 4 + 3];
+			r[column * 4] = a[0] * b0 + a[4] * b1 + a[8] * b2 + a[12] * b3;
+			r[column * 4 + 1] = a[1] * b0 + a[5] * b1 + a[9] * b2 + a[13] * b3;
+			r[column * 4 + 2] = a[2] * b0 + a[6] * b1 + a[10] * b2 + a[14] * b3;
+			r[column * 4 + 3] = a[3] * b0 + a[7] * b1 + a[11] * b2 + a[15] * b3;
+		}
+	}
+#endif
+	return result;
+}
+
+MATHC_API mfloat_t *mat4_multiply_n_right(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, size_t count)
+{
+	size_t i;
+	int column;
+	/* The shared operand is loaded once before the loop, it may be part of
+	 * the result array, and the left operand is loaded before any store */
+#if defined(MATHC_SSE)
+	__m128 b[4];
+	for (column = 0; column < 4; column++) {
+		b[column] = _mm_loadu_ps(m1 + column * 4);
+	}
+	for (i = 0; i < count; i++) {
+		mfloat_t *r = result + i * MAT4_SIZE;
+		__m128 a0 = _mm_loadu_ps(m0 + i * MAT4_SIZE);
+		__m128 a1 = _mm_loadu_ps(m0 + i * MAT4_SIZE + 4);
+		__m128 a2 = _mm_loadu_ps(m0 + i * MAT4_SIZE + 8);
+		__m128 a3 = _mm_loadu_ps(m0 + i * MAT4_SIZE + 12);
+		for (column = 0; column < 4; column++) {
+			__m128 c = b[column];
+			__m128 v = _mm_mul_ps(a0, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0)));
+			v = MATHC_SSE_MADD(a1, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)), v);
+			v = MATHC_SSE_MADD(a2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2)), v);
+			v = MATHC_SSE_MADD(a3, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3)), v);
+			_mm_storeu_ps(r + column * 4, v);
+		}
+	}
+#else
+	mfloat_t b[MAT4_SIZE];
+	mat4_assign(b, m1);
+	for (i = 0; i < count; i++) {
+		mfloat_t *r = result + i * MAT4_SIZE;
+		mfloat_t a[MAT4_SIZE];
+		int k;
+		for (k = 0; k < MAT4_SIZE; k++) {
+			a[k] = m0[i * MAT4_SIZE + k];
+		}
+		for (column = 0; column < 4; column++) {
+			mfloat_t b0 = b[column * 4];
+			mfloat_t b1 = b[column * 4 + 1];
+			mfloat_t b2 = b[column * 4 + 2];
+			mfloat_t b3 = b[column * 4 + 3];
+			r[column * 4] = a[0] * b0 + a[4] * b1 + a[8] * b2 + a[12] * b3;
+			r[column * 4 + 1] = a[1] * b0 + a[5] * b1 + a[9] * b2 + a[13] * b3;
+			r[column * 4 + 2] = a[2] * b0 + a[6] * b1 + a[10] * b2 + a[14] * b3;
+			r[column * 4 + 3] = a[3] * b0 + a[7] * b1 + a[11] * b2 + a[15] * b3;
+		}
+	}
+#endif
+	return result;
+}
+
+MATHC_API mfloat_t **mat4_multiply_soa(mfloat_t *result[MAT4_SIZE], mfloat_t *m0[MAT4_SIZE], mfloat_t *m1[MAT4_SIZE], size_t count)
+{
+	mfloat_t multiplied[MAT4_SIZE];
+	size_t i;
+	int row;
+	int column;
+	for (i = 0; i < count; i++) {
+		for (column = 0; column < 4; column++) {
+			for (row = 0; row < 4; row++) {
+				multiplied[column * 4 + row] = m0[row][i] * m1[column * 4][i]
+					+ m0[4 + row][i] * m1[column * 4 + 1][i]
+					+ m0[8 + row][i] * m1[column * 4 + 2][i]
+					+ m0[12 + row][i] * m1[column * 4 + 3][i];
+			}
+		}
+		for (row = 0; row < MAT4_SIZE; row++) {
+			result[row][i] = multiplied[row];
+		}
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *mat4_transform_points(mfloat_t *result, mfloat_t *v0, size_t count, size_t stride, mfloat_t *m0)
+{
+	mfloat_t m[MAT4_SIZE];
+	size_t i;
+	if (stride == 0) {
+		stride = VEC3_SIZE * sizeof(mfloat_t);
+	}
+	mat4_assign(m, m0);
+	if (m[3] == MFLOAT_C(0.0) && m[7] == MFLOAT_C(0.0) && m[11] == MFLOAT_C(0.0) && m[15] == MFLOAT_C(1.0)) {
+		for (i = 0; i < count; i++) {
+			mfloat_t *in = (mfloat_t *)((char *)v0 + i * stride);
+			mfloat_t *out = (mfloat_t *)((char *)result + i * stride);
+			mfloat_t x = in[0];
+			mfloat_t y = in[1];
+			mfloat_t z = in[2];
+			out[0] = m[0] * x + m[4] * y + m[8] * z + m[12];
+			out[1] = m[1] * x + m[5] * y + m[9] * z + m[13];
+			out[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+		}
+	} else {
+		for (i = 0; i < count; i++) {
+			mfloat_t *in = (mfloat_t *)((char *)v0 + i * stride);
+			mfloat_t *out = (mfloat_t *)((char *)result + i * stride);
+			mfloat_t x = in[0];
+			mfloat_t y = in[1];
+			mfloat_t z = in[2];
+			mfloat_t w = MFLOAT_C(1.0) / (m[3] * x + m[7] * y + m[11] * z + m[15]);
+			out[0] = (m[0] * x + m[4] * y + m[8] * z + m[12]) * w;
+			out[1] = (m[1] * x + m[5] * y + m[9] * z + m[13]) * w;
+			out[2] = (m[2] * x + m[6] * y + m[10] * z + m[14]) * w;
+		}
+	}
+	return result;
 }
 
-mfloat_t *mat4_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
+MATHC_API mfloat_t *mat4_transform_directions(mfloat_t *result, mfloat_t *v0, size_t count, size_t stride, mfloat_t *m0)
+{
+	mfloat_t m[MAT4_SIZE];
+	size_t i;
+	if (stride == 0) {
+		stride = VEC3_SIZE * sizeof(mfloat_t);
+	}
+	mat4_assign(m, m0);
+	for (i = 0; i < count; i++) {
+		mfloat_t *in = (mfloat_t *)((char *)v0 + i * stride);
+		mfloat_t *out = (mfloat_t *)((char *)result + i * stride);
+		mfloat_t x = in[0];
+		mfloat_t y = in[1];
+		mfloat_t z = in[2];
+		out[0] = m[0] * x + m[4] * y + m[8] * z;
+		out[1] = m[1] * x + m[5] * y + m[9] * z;
+		out[2] = m[2] * x + m[6] * y + m[10] * z;
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *mat4_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 {
 	result[0] = m0[0] * f;
 	result[1] = m0[1] * f;
@@ -3248,8 +5405,48 @@ mfloat_t *mat4_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f)
 	return result;
 }
 
-mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0)
-{
+MATHC_API mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0)
+{
+#if defined(MATHC_SSE)
+	/* Block-wise inverse using the 2x2 sub-matrices A, B, C and D */
+	__m128 c0 = _mm_loadu_ps(m0);
+	__m128 c1 = _mm_loadu_ps(m0 + 4);
+	__m128 c2 = _mm_loadu_ps(m0 + 8);
+	__m128 c3 = _mm_loadu_ps(m0 + 12);
+	__m128 a = _mm_movelh_ps(c0, c1);
+	__m128 b = _mm_movehl_ps(c1, c0);
+	__m128 c = _mm_movelh_ps(c2, c3);
+	__m128 d = _mm_movehl_ps(c3, c2);
+	__m128 determinants = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+	__m128 det_a = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 det_b = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 det_c = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 det_d = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(3, 3, 3, 3));
+	__m128 d_c = MATHC_SSE_MAT2_ADJ_MULTIPLY(d, c);
+	__m128 a_b = MATHC_SSE_MAT2_ADJ_MULTIPLY(a, b);
+	__m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), MATHC_SSE_MAT2_MULTIPLY(b, d_c));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), MATHC_SSE_MAT2_MULTIPLY(c, a_b));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), MATHC_SSE_MAT2_MULTIPLY_ADJ(d, a_b));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), MATHC_SSE_MAT2_MULTIPLY_ADJ(a, d_c));
+	__m128 det_m = _mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c));
+	__m128 trace = _mm_mul_ps(a_b, _mm_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+	__m128 inverted_determinant;
+	trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+	trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+	det_m = _mm_sub_ps(det_m, trace);
+	inverted_determinant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det_m);
+	x = _mm_mul_ps(x, inverted_determinant);
+	y = _mm_mul_ps(y, inverted_determinant);
+	z = _mm_mul_ps(z, inverted_determinant);
+	w = _mm_mul_ps(w, inverted_determinant);
+	_mm_storeu_ps(result, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(result + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_storeu_ps(result + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(result + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+	return result;
+#else
 	mfloat_t inverse[MAT4_SIZE];
 	mfloat_t inverted_determinant;
 	mfloat_t m11 = m0[0];
@@ -3382,10 +5579,111 @@ mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0)
 	result[14] = inverse[14] * inverted_determinant;
 	result[15] = inverse[15] * inverted_determinant;
 	return result;
+#endif
+}
+
+MATHC_API mfloat_t *mat4_inverse_affine(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t inverse[MAT4_SIZE];
+	mfloat_t inverted_determinant;
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m12 = m0[4];
+	mfloat_t m22 = m0[5];
+	mfloat_t m32 = m0[6];
+	mfloat_t m13 = m0[8];
+	mfloat_t m23 = m0[9];
+	mfloat_t m33 = m0[10];
+	mfloat_t m14 = m0[12];
+	mfloat_t m24 = m0[13];
+	mfloat_t m34 = m0[14];
+	/* Inverse of the upper-left 3x3 */
+	inverse[0] = m22 * m33 - m32 * m23;
+	inverse[1] = m31 * m23 - m21 * m33;
+	inverse[2] = m21 * m32 - m31 * m22;
+	inverse[4] = m32 * m13 - m12 * m33;
+	inverse[5] = m11 * m33 - m31 * m13;
+	inverse[6] = m31 * m12 - m11 * m32;
+	inverse[8] = m12 * m23 - m22 * m13;
+	inverse[9] = m21 * m13 - m11 * m23;
+	inverse[10] = m11 * m22 - m21 * m12;
+	inverted_determinant = MFLOAT_C(1.0) / (m11 * inverse[0] + m12 * inverse[1] + m13 * inverse[2]);
+	inverse[0] = inverse[0] * inverted_determinant;
+	inverse[1] = inverse[1] * inverted_determinant;
+	inverse[2] = inverse[2] * inverted_determinant;
+	inverse[4] = inverse[4] * inverted_determinant;
+	inverse[5] = inverse[5] * inverted_determinant;
+	inverse[6] = inverse[6] * inverted_determinant;
+	inverse[8] = inverse[8] * inverted_determinant;
+	inverse[9] = inverse[9] * inverted_determinant;
+	inverse[10] = inverse[10] * inverted_determinant;
+	/* The translation is moved back by the inverted 3x3 */
+	result[0] = inverse[0];
+	result[1] = inverse[1];
+	result[2] = inverse[2];
+	result[3] = MFLOAT_C(0.0);
+	result[4] = inverse[4];
+	result[5] = inverse[5];
+	result[6] = inverse[6];
+	result[7] = MFLOAT_C(0.0);
+	result[8] = inverse[8];
+	result[9] = inverse[9];
+	result[10] = inverse[10];
+	result[11] = MFLOAT_C(0.0);
+	result[12] = -(inverse[0] * m14 + inverse[4] * m24 + inverse[8] * m34);
+	result[13] = -(inverse[1] * m14 + inverse[5] * m24 + inverse[9] * m34);
+	result[14] = -(inverse[2] * m14 + inverse[6] * m24 + inverse[10] * m34);
+	result[15] = MFLOAT_C(1.0);
+	return result;
+}
+
+MATHC_API mfloat_t *mat4_inverse_rigid(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t m11 = m0[0];
+	mfloat_t m21 = m0[1];
+	mfloat_t m31 = m0[2];
+	mfloat_t m12 = m0[4];
+	mfloat_t m22 = m0[5];
+	mfloat_t m32 = m0[6];
+	mfloat_t m13 = m0[8];
+	mfloat_t m23 = m0[9];
+	mfloat_t m33 = m0[10];
+	mfloat_t m14 = m0[12];
+	mfloat_t m24 = m0[13];
+	mfloat_t m34 = m0[14];
+	/* The inverse of a rotation is its transpose */
+	result[0] = m11;
+	result[1] = m12;
+	result[2] = m13;
+	result[3] = MFLOAT_C(0.0);
+	result[4] = m21;
+	result[5] = m22;
+	result[6] = m23;
+	result[7] = MFLOAT_C(0.0);
+	result[8] = m31;
+	result[9] = m32;
+	result[10] = m33;
+	result[11] = MFLOAT_C(0.0);
+	result[12] = -(m11 * m14 + m21 * m24 + m31 * m34);
+	result[13] = -(m12 * m14 + m22 * m24 + m32 * m34);
+	result[14] = -(m13 * m14 + m23 * m24 + m33 * m34);
+	result[15] = MFLOAT_C(1.0);
+	return result;
 }
 
-mfloat_t *mat4_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
+MATHC_API mfloat_t *mat4_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
 {
+#if defined(MATHC_SSE)
+	__m128 t = _mm_set1_ps(f);
+	int i;
+	for (i = 0; i < MAT4_SIZE; i += 4) {
+		__m128 a = _mm_loadu_ps(m0 + i);
+		__m128 b = _mm_loadu_ps(m1 + i);
+		_mm_storeu_ps(result + i, MATHC_SSE_MADD(_mm_sub_ps(b, a), t, a));
+	}
+	return result;
+#else
 	result[0] = m0[0] + (m1[0] - m0[0]) * f;
 	result[1] = m0[1] + (m1[1] - m0[1]) * f;
 	result[2] = m0[2] + (m1[2] - m0[2]) * f;
@@ -3403,9 +5701,10 @@ mfloat_t *mat4_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f)
 	result[14] = m0[14] + (m1[14] - m0[14]) * f;
 	result[15] = m0[15] + (m1[15] - m0[15]) * f;
 	return result;
+#endif
 }
 
-mfloat_t *mat4_look_at(mfloat_t *result, mfloat_t *position, mfloat_t *target, mfloat_t *up)
+MATHC_API mfloat_t *mat4_look_at(mfloat_t *result, mfloat_t *position, mfloat_t *target, mfloat_t *up)
 {
 	mfloat_t tmp_forward[VEC3_SIZE];
 	mfloat_t tmp_side[VEC3_SIZE];
@@ -3434,7 +5733,7 @@ mfloat_t *mat4_look_at(mfloat_t *result, mfloat_t *position, mfloat_t *target, m
 	return result;
 }
 
-mfloat_t *mat4_ortho(mfloat_t *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f)
+MATHC_API mfloat_t *mat4_ortho(mfloat_t *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f)
 {
 	result[0] = MFLOAT_C(2.0) / (r - l);
 	result[1] = MFLOAT_C(0.0);
@@ -3455,7 +5754,7 @@ mfloat_t *mat4_ortho(mfloat_t *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloa
 	return result;
 }
 
-mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f)
+MATHC_API mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f)
 {
 	mfloat_t tan_half_fov_y = MFLOAT_C(1.0) / MTAN(fov_y * MFLOAT_C(0.5));
 	result[0] = MFLOAT_C(1.0) / aspect * tan_half_fov_y;
@@ -3463,7 +5762,7 @@ mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mf
 	result[2] = MFLOAT_C(0.0);
 	result[3] = MFLOAT_C(0.0);
 	result[4] = MFLOAT_C(0.0);
-	result[5] = MFLOAT_C(1.0) / tan_half_fov_y;
+	result[5] = tan_half_fov_y;
 	result[6] = MFLOAT_C(0.0);
 	result[7] = MFLOAT_C(0.0);
 	result[8] = MFLOAT_C(0.0);
@@ -3477,7 +5776,7 @@ mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mf
 	return result;
 }
 
-mfloat_t *mat4_perspective_fov(mfloat_t *result, mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f)
+MATHC_API mfloat_t *mat4_perspective_fov(mfloat_t *result, mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f)
 {
 	mfloat_t h2 = MCOS(fov * MFLOAT_C(0.5)) / MSIN(fov * MFLOAT_C(0.5));
 	mfloat_t w2 = h2 * h / w;
@@ -3500,7 +5799,7 @@ mfloat_t *mat4_perspective_fov(mfloat_t *result, mfloat_t fov, mfloat_t w, mfloa
 	return result;
 }
 
-mfloat_t *mat4_perspective_infinite(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n)
+MATHC_API mfloat_t *mat4_perspective_infinite(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n)
 {
 	mfloat_t range = MTAN(fov_y * MFLOAT_C(0.5)) * n;
 	mfloat_t left = -range * aspect;
@@ -3525,125 +5824,1285 @@ mfloat_t *mat4_perspective_infinite(mfloat_t *result, mfloat_t fov_y, mfloat_t a
 	result[15] = MFLOAT_C(0.0);
 	return result;
 }
-#endif
 
-#if defined(MATHC_USE_FLOATING_POINT) && defined(MATHC_USE_EASING_FUNCTIONS)
-mfloat_t quadratic_ease_out(mfloat_t f)
+MATHC_API struct mat4_hierarchy *mat4_hierarchy_set_local(struct mat4_hierarchy *result, size_t index, mfloat_t *m0)
 {
-	return -f * (f - MFLOAT_C(2.0));
+	mat4_assign(result->local + index * MAT4_SIZE, m0);
+	result->dirty[index] = true;
+	return result;
 }
 
-mfloat_t quadratic_ease_in(mfloat_t f)
+MATHC_API struct mat4_hierarchy *mat4_hierarchy_update(struct mat4_hierarchy *result)
 {
-	return f * f;
+	int *parents = result->parents;
+	mfloat_t *local = result->local;
+	mfloat_t *world = result->world;
+	bool *dirty = result->dirty;
+	size_t count = result->count;
+	size_t i;
+	/* Parents come before their children, so a dirty flag reaches the whole
+	 * subtree in the same pass and only the nodes below a change are multiplied */
+	for (i = 0; i < count; i++) {
+		int parent = parents[i];
+		if (parent >= 0 && dirty[parent]) {
+			dirty[i] = true;
+		}
+		if (dirty[i]) {
+			if (parent < 0) {
+				mat4_assign(world + i * MAT4_SIZE, local + i * MAT4_SIZE);
+			} else {
+				mat4_multiply(world + i * MAT4_SIZE, world + (size_t)parent * MAT4_SIZE, local + i * MAT4_SIZE);
+			}
+		}
+	}
+	for (i = 0; i < count; i++) {
+		dirty[i] = false;
+	}
+	return result;
 }
 
-mfloat_t quadratic_ease_in_out(mfloat_t f)
+MATHC_API mfloat_t *frustum_from_mat4(mfloat_t *result, mfloat_t *m0)
 {
-	mfloat_t a = MFLOAT_C(0.0);
-	if (f < MFLOAT_C(0.5)) {
-		a = MFLOAT_C(2.0) * f * f;
-	} else {
-		a = -MFLOAT_C(2.0) * f * f + MFLOAT_C(4.0) * f - MFLOAT_C(1.0);
+	int i;
+	/* Left, right, bottom, top, near and far planes, as the fourth row of the
+	 * matrix plus or minus each of the other rows */
+	for (i = 0; i < 3; i++) {
+		result[i * 8] = m0[3] + m0[i];
+		result[i * 8 + 1] = m0[7] + m0[4 + i];
+		result[i * 8 + 2] = m0[11] + m0[8 + i];
+		result[i * 8 + 3] = m0[15] + m0[12 + i];
+		result[i * 8 + 4] = m0[3] - m0[i];
+		result[i * 8 + 5] = m0[7] - m0[4 + i];
+		result[i * 8 + 6] = m0[11] - m0[8 + i];
+		result[i * 8 + 7] = m0[15] - m0[12 + i];
 	}
-	return a;
+	for (i = 0; i < 6; i++) {
+		mfloat_t *plane = result + i * VEC4_SIZE;
+		mfloat_t l = MSQRT(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+		/* The far plane of mat4_perspective_infinite() has no normal and a
+		 * positive distance, so it is kept as is and accepts everything */
+		if (l > MFLOAT_C(0.0)) {
+			plane[0] = plane[0] / l;
+			plane[1] = plane[1] / l;
+			plane[2] = plane[2] / l;
+			plane[3] = plane[3] / l;
+		}
+	}
+	return result;
 }
 
-mfloat_t cubic_ease_out(mfloat_t f)
+MATHC_API bool frustum_intersects_sphere(mfloat_t *f0, mfloat_t *v0, mfloat_t r)
 {
-	mfloat_t a = f - MFLOAT_C(1.0);
-	return a * a * a + MFLOAT_C(1.0);
+	int i;
+	for (i = 0; i < 6; i++) {
+		mfloat_t *plane = f0 + i * VEC4_SIZE;
+		if (plane[0] * v0[0] + plane[1] * v0[1] + plane[2] * v0[2] + plane[3] < -r) {
+			return false;
+		}
+	}
+	return true;
 }
 
-mfloat_t cubic_ease_in(mfloat_t f)
+MATHC_API bool frustum_intersects_aabb(mfloat_t *f0, mfloat_t *v0, mfloat_t *v1)
 {
-	return f * f * f;
+	int i;
+	for (i = 0; i < 6; i++) {
+		mfloat_t *plane = f0 + i * VEC4_SIZE;
+		mfloat_t x = plane[0] > MFLOAT_C(0.0) ? v1[0] : v0[0];
+		mfloat_t y = plane[1] > MFLOAT_C(0.0) ? v1[1] : v0[1];
+		mfloat_t z = plane[2] > MFLOAT_C(0.0) ? v1[2] : v0[2];
+		if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < MFLOAT_C(0.0)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+MATHC_API uint32_t *frustum_intersects_sphere_n(uint32_t *result, mfloat_t *f0, mfloat_t *v0, size_t count)
+{
+	mfloat_t x[MATHC_MASK_BITS];
+	mfloat_t y[MATHC_MASK_BITS];
+	mfloat_t z[MATHC_MASK_BITS];
+	mfloat_t radius[MATHC_MASK_BITS];
+	size_t chunk;
+	size_t i;
+	for (chunk = 0; chunk < count; chunk += MATHC_MASK_BITS) {
+		mfloat_t *s = v0 + chunk * VEC4_SIZE;
+		size_t n = count - chunk < MATHC_MASK_BITS ? count - chunk : MATHC_MASK_BITS;
+		for (i = 0; i < n; i++) {
+			x[i] = s[i * VEC4_SIZE];
+			y[i] = s[i * VEC4_SIZE + 1];
+			z[i] = s[i * VEC4_SIZE + 2];
+			radius[i] = s[i * VEC4_SIZE + 3];
+		}
+		result[chunk / MATHC_MASK_BITS] = mathc_frustum_spheres(f0, x, y, z, radius, n);
+	}
+	return result;
 }
 
-mfloat_t cubic_ease_in_out(mfloat_t f)
-{
-	mfloat_t a = MFLOAT_C(0.0);
-	if (f < MFLOAT_C(0.5)) {
-		a = MFLOAT_C(4.0) * f * f * f;
-	} else {
-		a = MFLOAT_C(2.0) * f - MFLOAT_C(2.0);
-		a = MFLOAT_C(0.5) * a * a * a + MFLOAT_C(1.0);
+MATHC_API uint32_t *frustum_intersects_aabb_n(uint32_t *result, mfloat_t *f0, mfloat_t *v0, mfloat_t *v1, size_t count)
+{
+	mfloat_t min_x[MATHC_MASK_BITS];
+	mfloat_t min_y[MATHC_MASK_BITS];
+	mfloat_t min_z[MATHC_MASK_BITS];
+	mfloat_t max_x[MATHC_MASK_BITS];
+	mfloat_t max_y[MATHC_MASK_BITS];
+	mfloat_t max_z[MATHC_MASK_BITS];
+	size_t chunk;
+	size_t i;
+	for (chunk = 0; chunk < count; chunk += MATHC_MASK_BITS) {
+		mfloat_t *a = v0 + chunk * VEC3_SIZE;
+		mfloat_t *b = v1 + chunk * VEC3_SIZE;
+		size_t n = count - chunk < MATHC_MASK_BITS ? count - chunk : MATHC_MASK_BITS;
+		for (i = 0; i < n; i++) {
+			min_x[i] = a[i * VEC3_SIZE];
+			min_y[i] = a[i * VEC3_SIZE + 1];
+			min_z[i] = a[i * VEC3_SIZE + 2];
+			max_x[i] = b[i * VEC3_SIZE];
+			max_y[i] = b[i * VEC3_SIZE + 1];
+			max_z[i] = b[i * VEC3_SIZE + 2];
+		}
+		result[chunk / MATHC_MASK_BITS] = mathc_frustum_aabbs(f0, min_x, min_y, min_z, max_x, max_y, max_z, n);
 	}
-	return a;
+	return result;
 }
 
-mfloat_t quartic_ease_out(mfloat_t f)
+MATHC_API uint32_t *frustum_intersects_sphere_stream(uint32_t *result, mfloat_t *f0, struct vec3_stream *v0, mfloat_t *radius)
 {
-	mfloat_t a = f - MFLOAT_C(1.0);
-	return a * a * a * (MFLOAT_C(1.0) - f) + MFLOAT_C(1.0);
+	size_t chunk;
+	for (chunk = 0; chunk < v0->count; chunk += MATHC_MASK_BITS) {
+		size_t n = v0->count - chunk < MATHC_MASK_BITS ? v0->count - chunk : MATHC_MASK_BITS;
+		result[chunk / MATHC_MASK_BITS] = mathc_frustum_spheres(f0, v0->x + chunk, v0->y + chunk, v0->z + chunk, radius + chunk, n);
+	}
+	return result;
 }
 
-mfloat_t quartic_ease_in(mfloat_t f)
+MATHC_API uint32_t *frustum_intersects_aabb_stream(uint32_t *result, mfloat_t *f0, struct vec3_stream *v0, struct vec3_stream *v1)
 {
-	return f * f * f * f;
+	size_t chunk;
+	for (chunk = 0; chunk < v0->count; chunk += MATHC_MASK_BITS) {
+		size_t n = v0->count - chunk < MATHC_MASK_BITS ? v0->count - chunk : MATHC_MASK_BITS;
+		result[chunk / MATHC_MASK_BITS] = mathc_frustum_aabbs(f0, v0->x + chunk, v0->y + chunk, v0->z + chunk, v1->x + chunk, v1->y + chunk, v1->z + chunk, n);
+	}
+	return result;
+}
+
+MATHC_API bool ray_intersect_triangle(mfloat_t *result, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
+{
+	mfloat_t e1[VEC3_SIZE];
+	mfloat_t e2[VEC3_SIZE];
+	mfloat_t p[VEC3_SIZE];
+	mfloat_t q[VEC3_SIZE];
+	mfloat_t s[VEC3_SIZE];
+	mfloat_t det;
+	mfloat_t inverse;
+	mfloat_t u;
+	mfloat_t v;
+	mfloat_t t;
+	/* Moller-Trumbore */
+	vec3_subtract(e1, v1, v0);
+	vec3_subtract(e2, v2, v0);
+	vec3_cross(p, direction, e2);
+	det = vec3_dot(e1, p);
+	if (det == MFLOAT_C(0.0)) {
+		return false;
+	}
+	inverse = MFLOAT_C(1.0) / det;
+	vec3_subtract(s, origin, v0);
+	u = vec3_dot(s, p) * inverse;
+	if (u < MFLOAT_C(0.0) || u > MFLOAT_C(1.0)) {
+		return false;
+	}
+	vec3_cross(q, s, e1);
+	v = vec3_dot(direction, q) * inverse;
+	if (v < MFLOAT_C(0.0) || u + v > MFLOAT_C(1.0)) {
+		return false;
+	}
+	t = vec3_dot(e2, q) * inverse;
+	if (t < MFLOAT_C(0.0)) {
+		return false;
+	}
+	*result = t;
+	return true;
+}
+
+MATHC_API bool ray_intersect_aabb(mfloat_t *result, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0, mfloat_t *v1)
+{
+	mfloat_t t_near = MFLOAT_C(0.0);
+	mfloat_t t_far = MFLOAT_C(0.0);
+	int i;
+	/* Slabs, with a zero direction component giving infinite distances */
+	for (i = 0; i < 3; i++) {
+		mfloat_t inverse = MFLOAT_C(1.0) / direction[i];
+		mfloat_t t0 = (v0[i] - origin[i]) * inverse;
+		mfloat_t t1 = (v1[i] - origin[i]) * inverse;
+		mfloat_t t_min = t0 < t1 ? t0 : t1;
+		mfloat_t t_max = t0 < t1 ? t1 : t0;
+		if (i == 0 || t_min > t_near) {
+			t_near = t_min;
+		}
+		if (i == 0 || t_max < t_far) {
+			t_far = t_max;
+		}
+	}
+	if (t_far < MFLOAT_C(0.0) || t_near > t_far) {
+		return false;
+	}
+	*result = t_near > MFLOAT_C(0.0) ? t_near : MFLOAT_C(0.0);
+	return true;
+}
+
+MATHC_API bool ray_intersect_sphere(mfloat_t *result, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0, mfloat_t r)
+{
+	mfloat_t oc[VEC3_SIZE];
+	mfloat_t a;
+	mfloat_t b;
+	mfloat_t c;
+	mfloat_t discriminant;
+	mfloat_t root;
+	mfloat_t t;
+	vec3_subtract(oc, origin, v0);
+	a = vec3_dot(direction, direction);
+	b = vec3_dot(oc, direction);
+	c = vec3_dot(oc, oc) - r * r;
+	discriminant = b * b - a * c;
+	if (discriminant < MFLOAT_C(0.0)) {
+		return false;
+	}
+	root = MSQRT(discriminant);
+	/* Nearest intersection in front of the origin, the far one when the
+	 * origin is inside the sphere */
+	t = (-b - root) / a;
+	if (t < MFLOAT_C(0.0)) {
+		t = (-b + root) / a;
+	}
+	if (t < MFLOAT_C(0.0)) {
+		return false;
+	}
+	*result = t;
+	return true;
 }
 
-mfloat_t quartic_ease_in_out(mfloat_t f)
+MATHC_API bool ray_intersect_plane(mfloat_t *result, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0)
 {
-	mfloat_t a = MFLOAT_C(0.0);
-	if (f < MFLOAT_C(0.5)) {
-		a = MFLOAT_C(8.0) * f * f * f * f;
-	} else {
-		a = f - MFLOAT_C(1.0);
-		a = -MFLOAT_C(8.0) * a * a * a * a + MFLOAT_C(1.0);
+	mfloat_t denominator = vec3_dot(v0, direction);
+	mfloat_t t;
+	if (denominator == MFLOAT_C(0.0)) {
+		return false;
 	}
-	return a;
+	t = -(vec3_dot(v0, origin) + v0[3]) / denominator;
+	if (t < MFLOAT_C(0.0)) {
+		return false;
+	}
+	*result = t;
+	return true;
+}
+
+MATHC_API uint32_t ray_intersect_triangle_packet(mfloat_t *result, struct vec3_stream *origins, struct vec3_stream *directions, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
+{
+	mfloat_t distance[MATHC_MASK_BITS];
+	mfloat_t margin[MATHC_MASK_BITS];
+	mfloat_t e1x = v1[0] - v0[0];
+	mfloat_t e1y = v1[1] - v0[1];
+	mfloat_t e1z = v1[2] - v0[2];
+	mfloat_t e2x = v2[0] - v0[0];
+	mfloat_t e2y = v2[1] - v0[1];
+	mfloat_t e2z = v2[2] - v0[2];
+	size_t count = origins->count < MATHC_MASK_BITS ? origins->count : MATHC_MASK_BITS;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		mfloat_t dx = directions->x[i];
+		mfloat_t dy = directions->y[i];
+		mfloat_t dz = directions->z[i];
+		mfloat_t sx = origins->x[i] - v0[0];
+		mfloat_t sy = origins->y[i] - v0[1];
+		mfloat_t sz = origins->z[i] - v0[2];
+		mfloat_t px = dy * e2z - dz * e2y;
+		mfloat_t py = dz * e2x - dx * e2z;
+		mfloat_t pz = dx * e2y - dy * e2x;
+		mfloat_t qx = sy * e1z - sz * e1y;
+		mfloat_t qy = sz * e1x - sx * e1z;
+		mfloat_t qz = sx * e1y - sy * e1x;
+		mfloat_t det = e1x * px + e1y * py + e1z * pz;
+		mfloat_t inverse = MFLOAT_C(1.0) / det;
+		mfloat_t u = (sx * px + sy * py + sz * pz) * inverse;
+		mfloat_t v = (dx * qx + dy * qy + dz * qz) * inverse;
+		mfloat_t t = (e2x * qx + e2y * qy + e2z * qz) * inverse;
+		/* The smallest of the terms that must not be negative for a hit,
+		 * starting with the determinant so a parallel ray always misses */
+		mfloat_t m = MFABS(det) - MFLT_MIN;
+		m = u < m ? u : m;
+		m = v < m ? v : m;
+		m = MFLOAT_C(1.0) - u - v < m ? MFLOAT_C(1.0) - u - v : m;
+		m = t < m ? t : m;
+		m = result[i] - t < m ? result[i] - t : m;
+		distance[i] = t;
+		margin[i] = m;
+	}
+	return mathc_ray_packet_hits(result, distance, margin, count);
+}
+
+MATHC_API uint32_t ray_intersect_aabb_packet(mfloat_t *result, struct vec3_stream *origins, struct vec3_stream *directions, mfloat_t *v0, mfloat_t *v1)
+{
+	mfloat_t distance[MATHC_MASK_BITS];
+	mfloat_t margin[MATHC_MASK_BITS];
+	size_t count = origins->count < MATHC_MASK_BITS ? origins->count : MATHC_MASK_BITS;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		mfloat_t ix = MFLOAT_C(1.0) / directions->x[i];
+		mfloat_t iy = MFLOAT_C(1.0) / directions->y[i];
+		mfloat_t iz = MFLOAT_C(1.0) / directions->z[i];
+		mfloat_t x0 = (v0[0] - origins->x[i]) * ix;
+		mfloat_t x1 = (v1[0] - origins->x[i]) * ix;
+		mfloat_t y0 = (v0[1] - origins->y[i]) * iy;
+		mfloat_t y1 = (v1[1] - origins->y[i]) * iy;
+		mfloat_t z0 = (v0[2] - origins->z[i]) * iz;
+		mfloat_t z1 = (v1[2] - origins->z[i]) * iz;
+		mfloat_t t_near = x0 < x1 ? x0 : x1;
+		mfloat_t t_far = x0 < x1 ? x1 : x0;
+		mfloat_t y_near = y0 < y1 ? y0 : y1;
+		mfloat_t y_far = y0 < y1 ? y1 : y0;
+		mfloat_t z_near = z0 < z1 ? z0 : z1;
+		mfloat_t z_far = z0 < z1 ? z1 : z0;
+		mfloat_t m;
+		t_near = y_near > t_near ? y_near : t_near;
+		t_near = z_near > t_near ? z_near : t_near;
+		t_near = t_near > MFLOAT_C(0.0) ? t_near : MFLOAT_C(0.0);
+		t_far = y_far < t_far ? y_far : t_far;
+		t_far = z_far < t_far ? z_far : t_far;
+		m = t_far - t_near;
+		m = result[i] - t_near < m ? result[i] - t_near : m;
+		distance[i] = t_near;
+		margin[i] = m;
+	}
+	return mathc_ray_packet_hits(result, distance, margin, count);
+}
+
+MATHC_API uint32_t ray_intersect_sphere_packet(mfloat_t *result, struct vec3_stream *origins, struct vec3_stream *directions, mfloat_t *v0, mfloat_t r)
+{
+	mfloat_t distance[MATHC_MASK_BITS];
+	mfloat_t margin[MATHC_MASK_BITS];
+	size_t count = origins->count < MATHC_MASK_BITS ? origins->count : MATHC_MASK_BITS;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		mfloat_t dx = directions->x[i];
+		mfloat_t dy = directions->y[i];
+		mfloat_t dz = directions->z[i];
+		mfloat_t ox = origins->x[i] - v0[0];
+		mfloat_t oy = origins->y[i] - v0[1];
+		mfloat_t oz = origins->z[i] - v0[2];
+		mfloat_t a = dx * dx + dy * dy + dz * dz;
+		mfloat_t b = ox * dx + oy * dy + oz * dz;
+		mfloat_t c = ox * ox + oy * oy + oz * oz - r * r;
+		mfloat_t discriminant = b * b - a * c;
+		/* A negative discriminant gives a negative margin, whatever the root */
+		mfloat_t root = MSQRT(MFABS(discriminant));
+		mfloat_t t0 = (-b - root) / a;
+		/* The far intersection when the near one is behind the origin */
+		mfloat_t t = (-b - MCOPYSIGN(root, t0)) / a;
+		mfloat_t m = discriminant;
+		m = t < m ? t : m;
+		m = result[i] - t < m ? result[i] - t : m;
+		distance[i] = t;
+		margin[i] = m;
+	}
+	return mathc_ray_packet_hits(result, distance, margin, count);
+}
+
+MATHC_API uint32_t ray_intersect_plane_packet(mfloat_t *result, struct vec3_stream *origins, struct vec3_stream *directions, mfloat_t *v0)
+{
+	mfloat_t distance[MATHC_MASK_BITS];
+	mfloat_t margin[MATHC_MASK_BITS];
+	size_t count = origins->count < MATHC_MASK_BITS ? origins->count : MATHC_MASK_BITS;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		mfloat_t denominator = v0[0] * directions->x[i] + v0[1] * directions->y[i] + v0[2] * directions->z[i];
+		mfloat_t t = -(v0[0] * origins->x[i] + v0[1] * origins->y[i] + v0[2] * origins->z[i] + v0[3]) / denominator;
+		mfloat_t m = result[i] - t < t ? result[i] - t : t;
+		/* A ray parallel to the plane misses, even with an infinite distance */
+		distance[i] = t;
+		margin[i] = denominator != MFLOAT_C(0.0) ? m : MFLOAT_C(-1.0);
+	}
+	return mathc_ray_packet_hits(result, distance, margin, count);
 }
 
-mfloat_t quintic_ease_out(mfloat_t f)
+MATHC_API struct bvh *bvh_build(struct bvh *result, mfloat_t *v0, mfloat_t *v1, size_t count)
 {
-	mfloat_t a = f - MFLOAT_C(1.0);
-	return a * a * a * a * a + MFLOAT_C(1.0);
+	struct mathc_bvh_source source;
+	source.min = v0;
+	source.max = v1;
+	source.triangles = NULL;
+	return mathc_bvh_build(result, &source, count);
 }
 
-mfloat_t quintic_ease_in(mfloat_t f)
+MATHC_API struct bvh *bvh_build_triangles(struct bvh *result, mfloat_t *v0, size_t count)
 {
-	return f * f * f * f * f;
+	struct mathc_bvh_source source;
+	source.min = NULL;
+	source.max = NULL;
+	source.triangles = v0;
+	return mathc_bvh_build(result, &source, count);
 }
 
-mfloat_t quintic_ease_in_out(mfloat_t f)
+MATHC_API int bvh_intersect_ray(mfloat_t *result, struct bvh *b0, mfloat_t *origin, mfloat_t *direction, bool (*func)(void *data, int index, mfloat_t *result, mfloat_t *origin, mfloat_t *direction), void *data)
 {
-	mfloat_t a = MFLOAT_C(0.0);
-	if (f < MFLOAT_C(0.5)) {
-		a = MFLOAT_C(16.0) * f * f * f * f * f;
-	} else {
-		a = MFLOAT_C(2.0) * f - MFLOAT_C(2.0);
-		a = MFLOAT_C(0.5) * a * a * a * a * a + MFLOAT_C(1.0);
+	int stack[MATHC_BVH_STACK_SIZE];
+	mfloat_t stack_distance[MATHC_BVH_STACK_SIZE];
+	mfloat_t inverse[VEC3_SIZE];
+	mfloat_t distance;
+	struct bvh_node *node;
+	int top = 0;
+	int hit = -1;
+	int i;
+	inverse[0] = MFLOAT_C(1.0) / direction[0];
+	inverse[1] = MFLOAT_C(1.0) / direction[1];
+	inverse[2] = MFLOAT_C(1.0) / direction[2];
+	if (b0->node_count == 0 || !mathc_bvh_ray_box(b0->nodes, origin, inverse, *result, &distance)) {
+		return -1;
 	}
-	return a;
+	node = b0->nodes;
+	while (node != NULL) {
+		if (node->count > 0) {
+			for (i = 0; i < node->count; i++) {
+				int index = b0->indices[node->first + i];
+				if (func(data, index, result, origin, direction)) {
+					hit = index;
+				}
+			}
+			node = NULL;
+		} else {
+			struct bvh_node *near = b0->nodes + node->first;
+			struct bvh_node *far = near + 1;
+			mfloat_t near_distance;
+			mfloat_t far_distance;
+			bool near_hit = mathc_bvh_ray_box(near, origin, inverse, *result, &near_distance);
+			bool far_hit = mathc_bvh_ray_box(far, origin, inverse, *result, &far_distance);
+			node = NULL;
+			if (near_hit && far_hit) {
+				/* Visit the closer child first, the other one may be skipped
+				 * once a hit is found in front of it */
+				if (far_distance < near_distance) {
+					struct bvh_node *swap = near;
+					near = far;
+					far = swap;
+					far_distance = near_distance;
+				}
+				stack[top] = (int)(far - b0->nodes);
+				stack_distance[top] = far_distance;
+				top = top + 1;
+				node = near;
+			} else if (near_hit) {
+				node = near;
+			} else if (far_hit) {
+				node = far;
+			}
+		}
+		while (node == NULL && top > 0) {
+			top = top - 1;
+			if (stack_distance[top] <= *result) {
+				node = b0->nodes + stack[top];
+			}
+		}
+	}
+	return hit;
 }
 
-mfloat_t sine_ease_out(mfloat_t f)
+MATHC_API int bvh_intersect_ray_triangles(mfloat_t *result, struct bvh *b0, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0)
 {
-	return MSIN(f * MPI_2);
+	return bvh_intersect_ray(result, b0, origin, direction, mathc_bvh_triangle, v0);
 }
 
-mfloat_t sine_ease_in(mfloat_t f)
+MATHC_API size_t bvh_query_frustum(struct bvh *b0, mfloat_t *f0, void (*func)(void *data, int index), void *data)
 {
-	return MSIN((f - MFLOAT_C(1.0)) * MPI_2) + MFLOAT_C(1.0);
+	int stack[MATHC_BVH_STACK_SIZE];
+	size_t found = 0;
+	int top = 0;
+	int i;
+	if (b0->node_count > 0) {
+		stack[0] = 0;
+		top = 1;
+	}
+	while (top > 0) {
+		struct bvh_node *node;
+		top = top - 1;
+		node = b0->nodes + stack[top];
+		if (!frustum_intersects_aabb(f0, node->min, node->max)) {
+			continue;
+		}
+		if (node->count > 0) {
+			for (i = 0; i < node->count; i++) {
+				func(data, b0->indices[node->first + i]);
+			}
+			found = found + (size_t)node->count;
+		} else {
+			stack[top] = node->first + 1;
+			stack[top + 1] = node->first;
+			top = top + 2;
+		}
+	}
+	return found;
+}
+
+MATHC_API struct aligned_buffer *aligned_buffer(struct aligned_buffer *result, void *memory, size_t size, size_t alignment, size_t stride)
+{
+	/* Skip to the first multiple of the alignment, which is a power of two */
+	size_t offset = (alignment - (size_t)((uintptr_t)memory & (alignment - 1))) & (alignment - 1);
+	result->data = (mfloat_t *)((char *)memory + offset);
+	result->stride = stride;
+	result->capacity = size > offset && stride > 0 ? (size - offset) / stride : 0;
+	return result;
+}
+
+MATHC_API mfloat_t *aligned_buffer_at(struct aligned_buffer *b0, size_t index)
+{
+	return (mfloat_t *)((char *)b0->data + index * b0->stride);
+}
+
+MATHC_API size_t aligned_buffer_size(struct aligned_buffer *b0, size_t count)
+{
+	return count * b0->stride;
+}
+
+MATHC_API mfloat_t *mat4_skin_points(mfloat_t *result, mfloat_t *v0, size_t count, size_t stride, int *bones, mfloat_t *weights, mfloat_t *m0)
+{
+	size_t i;
+	if (stride == 0) {
+		stride = VEC3_SIZE * sizeof(mfloat_t);
+	}
+	for (i = 0; i < count; i++) {
+		mfloat_t *in = (mfloat_t *)((char *)v0 + i * stride);
+		mfloat_t *out = (mfloat_t *)((char *)result + i * stride);
+		mathc_skin_mat4(out, in[0], in[1], in[2], bones + i * 4, weights + i * 4, m0);
+	}
+	return result;
+}
+
+MATHC_API struct vec3_stream *mat4_skin_stream(struct vec3_stream *result, struct vec3_stream *v0, int *bones, mfloat_t *weights, mfloat_t *m0)
+{
+	mfloat_t skinned[VEC3_SIZE];
+	size_t i;
+	for (i = 0; i < v0->count; i++) {
+		mathc_skin_mat4(skinned, v0->x[i], v0->y[i], v0->z[i], bones + i * 4, weights + i * 4, m0);
+		result->x[i] = skinned[0];
+		result->y[i] = skinned[1];
+		result->z[i] = skinned[2];
+	}
+	result->count = v0->count;
+	return result;
+}
+
+MATHC_API mfloat_t *dualquat_from_quat_vec3(mfloat_t *result, mfloat_t *q0, mfloat_t *v0)
+{
+	mfloat_t translation[QUAT_SIZE];
+	mfloat_t real[QUAT_SIZE];
+	translation[0] = v0[0] * MFLOAT_C(0.5);
+	translation[1] = v0[1] * MFLOAT_C(0.5);
+	translation[2] = v0[2] * MFLOAT_C(0.5);
+	translation[3] = MFLOAT_C(0.0);
+	quat_assign(real, q0);
+	quat_multiply(result + QUAT_SIZE, translation, real);
+	quat_assign(result, real);
+	return result;
+}
+
+MATHC_API mfloat_t *dualquat_from_mat4(mfloat_t *result, mfloat_t *m0)
+{
+	mfloat_t rotation[QUAT_SIZE];
+	quat_from_mat4(rotation, m0);
+	return dualquat_from_quat_vec3(result, rotation, m0 + 12);
+}
+
+MATHC_API mfloat_t *dualquat_skin_points(mfloat_t *result, mfloat_t *v0, size_t count, size_t stride, int *bones, mfloat_t *weights, mfloat_t *d0)
+{
+	size_t i;
+	if (stride == 0) {
+		stride = VEC3_SIZE * sizeof(mfloat_t);
+	}
+	for (i = 0; i < count; i++) {
+		mfloat_t *in = (mfloat_t *)((char *)v0 + i * stride);
+		mfloat_t *out = (mfloat_t *)((char *)result + i * stride);
+		mathc_skin_dualquat(out, in[0], in[1], in[2], bones + i * 4, weights + i * 4, d0);
+	}
+	return result;
+}
+
+MATHC_API struct vec3_stream *dualquat_skin_stream(struct vec3_stream *result, struct vec3_stream *v0, int *bones, mfloat_t *weights, mfloat_t *d0)
+{
+	mfloat_t skinned[VEC3_SIZE];
+	size_t i;
+	for (i = 0; i < v0->count; i++) {
+		mathc_skin_dualquat(skinned, v0->x[i], v0->y[i], v0->z[i], bones + i * 4, weights + i * 4, d0);
+		result->x[i] = skinned[0];
+		result->y[i] = skinned[1];
+		result->z[i] = skinned[2];
+	}
+	result->count = v0->count;
+	return result;
+}
+
+MATHC_API mfloat_t *animation_track_sample(mfloat_t *result, struct animation_track *t0, mfloat_t time)
+{
+	int size = t0->size;
+	size_t stride = (size_t)size;
+	size_t offset = 0;
+	size_t key;
+	mfloat_t *v0;
+	mfloat_t *v1;
+	mfloat_t f;
+	int i;
+	if (t0->interpolation == ANIMATION_CUBIC) {
+		stride = stride * 3;
+		offset = (size_t)size;
+	}
+	if (t0->count < 2 || time <= t0->times[0]) {
+		v0 = t0->values + offset;
+		for (i = 0; i < size; i++) {
+			result[i] = v0[i];
+		}
+		return result;
+	}
+	if (time >= t0->times[t0->count - 1]) {
+		v0 = t0->values + (t0->count - 1) * stride + offset;
+		for (i = 0; i < size; i++) {
+			result[i] = v0[i];
+		}
+		return result;
+	}
+	key = mathc_animation_key(t0, time);
+	f = (time - t0->times[key]) / (t0->times[key + 1] - t0->times[key]);
+	v0 = t0->values + key * stride;
+	v1 = v0 + stride;
+	if (t0->interpolation == ANIMATION_STEP) {
+		for (i = 0; i < size; i++) {
+			result[i] = v0[i];
+		}
+	} else if (t0->interpolation == ANIMATION_SLERP) {
+		quat_slerp(result, v0, v1, f);
+	} else if (t0->interpolation == ANIMATION_CUBIC) {
+		/* Bezier segment from the value of the key through its out control
+		 * point and the in control point of the next key */
+		mfloat_t g = MFLOAT_C(1.0) - f;
+		mfloat_t f0 = g * g * g;
+		mfloat_t f1 = MFLOAT_C(3.0) * g * g * f;
+		mfloat_t f2 = MFLOAT_C(3.0) * g * f * f;
+		mfloat_t f3 = f * f * f;
+		for (i = 0; i < size; i++) {
+			result[i] = v0[size + i] * f0 + v0[size * 2 + i] * f1 + v1[i] * f2 + v1[size + i] * f3;
+		}
+	} else {
+		for (i = 0; i < size; i++) {
+			result[i] = v0[i] + (v1[i] - v0[i]) * f;
+		}
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *animation_track_sample_n(mfloat_t *result, struct animation_track *t0, size_t count, mfloat_t time)
+{
+	mfloat_t *out = result;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		animation_track_sample(out, t0 + i, time);
+		out = out + t0[i].size;
+	}
+	return result;
+}
+
+MATHC_API uint32_t *quat_encode_32(uint32_t *result, mfloat_t *q0)
+{
+	uint32_t v[3];
+	int largest = mathc_quat_smallest_three(v, q0, 1023);
+	result[0] = ((uint32_t)largest << 30) | (v[0] << 20) | (v[1] << 10) | v[2];
+	return result;
+}
+
+MATHC_API mfloat_t *quat_decode_32(mfloat_t *result, uint32_t *v0)
+{
+	uint32_t v[3];
+	v[0] = (v0[0] >> 20) & 1023;
+	v[1] = (v0[0] >> 10) & 1023;
+	v[2] = v0[0] & 1023;
+	return mathc_quat_from_smallest_three(result, (int)(v0[0] >> 30), v, 1023);
+}
+
+MATHC_API uint32_t *quat_encode_32_n(uint32_t *result, mfloat_t *q0, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		quat_encode_32(result + i, q0 + i * QUAT_SIZE);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *quat_decode_32_n(mfloat_t *result, uint32_t *v0, size_t count)
+{
+	mfloat_t a[MATHC_STREAM_CHUNK];
+	mfloat_t b[MATHC_STREAM_CHUNK];
+	mfloat_t c[MATHC_STREAM_CHUNK];
+	uint32_t largest[MATHC_STREAM_CHUNK];
+	mfloat_t scale = MFLOAT_C(1.41421356237309504880) / MFLOAT_C(1023.0);
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			uint32_t v = v0[i + j];
+			largest[j] = v >> 30;
+			a[j] = (mfloat_t)((v >> 20) & 1023) * scale - MFLOAT_C(0.70710678118654752440);
+			b[j] = (mfloat_t)((v >> 10) & 1023) * scale - MFLOAT_C(0.70710678118654752440);
+			c[j] = (mfloat_t)(v & 1023) * scale - MFLOAT_C(0.70710678118654752440);
+		}
+		mathc_quat_from_smallest_three_n(result + i * QUAT_SIZE, largest, a, b, c, n);
+	}
+	return result;
+}
+
+MATHC_API uint16_t *quat_encode_48(uint16_t *result, mfloat_t *q0)
+{
+	uint32_t v[3];
+	int largest = mathc_quat_smallest_three(v, q0, 32767);
+	/* The index of the largest component goes in the top bits of the first
+	 * two integers */
+	result[0] = (uint16_t)(((uint32_t)(largest >> 1) << 15) | v[0]);
+	result[1] = (uint16_t)(((uint32_t)(largest & 1) << 15) | v[1]);
+	result[2] = (uint16_t)v[2];
+	return result;
+}
+
+MATHC_API mfloat_t *quat_decode_48(mfloat_t *result, uint16_t *v0)
+{
+	uint32_t v[3];
+	int largest = ((v0[0] >> 15) << 1) | (v0[1] >> 15);
+	v[0] = v0[0] & 32767u;
+	v[1] = v0[1] & 32767u;
+	v[2] = v0[2] & 32767u;
+	return mathc_quat_from_smallest_three(result, largest, v, 32767);
+}
+
+MATHC_API uint16_t *quat_encode_48_n(uint16_t *result, mfloat_t *q0, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		quat_encode_48(result + i * 3, q0 + i * QUAT_SIZE);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *quat_decode_48_n(mfloat_t *result, uint16_t *v0, size_t count)
+{
+	mfloat_t a[MATHC_STREAM_CHUNK];
+	mfloat_t b[MATHC_STREAM_CHUNK];
+	mfloat_t c[MATHC_STREAM_CHUNK];
+	uint32_t largest[MATHC_STREAM_CHUNK];
+	mfloat_t scale = MFLOAT_C(1.41421356237309504880) / MFLOAT_C(32767.0);
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			uint16_t *v = v0 + (i + j) * 3;
+			largest[j] = ((uint32_t)(v[0] >> 15) << 1) | (uint32_t)(v[1] >> 15);
+			a[j] = (mfloat_t)(v[0] & 32767) * scale - MFLOAT_C(0.70710678118654752440);
+			b[j] = (mfloat_t)(v[1] & 32767) * scale - MFLOAT_C(0.70710678118654752440);
+			c[j] = (mfloat_t)(v[2] & 32767) * scale - MFLOAT_C(0.70710678118654752440);
+		}
+		mathc_quat_from_smallest_three_n(result + i * QUAT_SIZE, largest, a, b, c, n);
+	}
+	return result;
+}
+
+MATHC_API mhalf_t *vec3_encode_half(mhalf_t *result, mfloat_t *v0)
+{
+	result[0] = mathc_half_from_float((float)v0[0]);
+	result[1] = mathc_half_from_float((float)v0[1]);
+	result[2] = mathc_half_from_float((float)v0[2]);
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_decode_half(mfloat_t *result, mhalf_t *v0)
+{
+	result[0] = (mfloat_t)mathc_float_from_half(v0[0]);
+	result[1] = (mfloat_t)mathc_float_from_half(v0[1]);
+	result[2] = (mfloat_t)mathc_float_from_half(v0[2]);
+	return result;
+}
+
+MATHC_API mhalf_t *vec3_encode_half_n(mhalf_t *result, mfloat_t *v0, size_t count)
+{
+	return half_encode_n(result, v0, count * VEC3_SIZE);
 }
 
-mfloat_t sine_ease_in_out(mfloat_t f)
+MATHC_API mfloat_t *vec3_decode_half_n(mfloat_t *result, mhalf_t *v0, size_t count)
+{
+	return half_decode_n(result, v0, count * VEC3_SIZE);
+}
+
+MATHC_API uint16_t *vec3_encode_range(uint16_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2)
+{
+	return vec3_encode_range_n(result, v0, v1, v2, 1);
+}
+
+MATHC_API mfloat_t *vec3_decode_range(mfloat_t *result, uint16_t *v0, mfloat_t *v1, mfloat_t *v2)
+{
+	return vec3_decode_range_n(result, v0, v1, v2, 1);
+}
+
+MATHC_API uint16_t *vec3_encode_range_n(uint16_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count)
+{
+	mfloat_t minimum[VEC3_SIZE];
+	mfloat_t scale[VEC3_SIZE];
+	size_t i;
+	int j;
+	for (j = 0; j < 3; j++) {
+		minimum[j] = v1[j];
+		scale[j] = v2[j] > v1[j] ? MFLOAT_C(65535.0) / (v2[j] - v1[j]) : MFLOAT_C(0.0);
+	}
+	for (i = 0; i < count; i++) {
+		for (j = 0; j < 3; j++) {
+			mfloat_t u = (v0[i * VEC3_SIZE + j] - minimum[j]) * scale[j] + MFLOAT_C(0.5);
+			u = u > MFLOAT_C(0.0) ? u : MFLOAT_C(0.0);
+			u = u < MFLOAT_C(65535.0) ? u : MFLOAT_C(65535.0);
+			result[i * VEC3_SIZE + j] = (uint16_t)u;
+		}
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *vec3_decode_range_n(mfloat_t *result, uint16_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count)
+{
+	mfloat_t minimum[VEC3_SIZE];
+	mfloat_t scale[VEC3_SIZE];
+	size_t i;
+	int j;
+	for (j = 0; j < 3; j++) {
+		minimum[j] = v1[j];
+		scale[j] = (v2[j] - v1[j]) / MFLOAT_C(65535.0);
+	}
+	for (i = 0; i < count; i++) {
+		for (j = 0; j < 3; j++) {
+			result[i * VEC3_SIZE + j] = minimum[j] + (mfloat_t)v0[i * VEC3_SIZE + j] * scale[j];
+		}
+	}
+	return result;
+}
+
+MATHC_API mhalf_t *half_encode_n(mhalf_t *result, mfloat_t *v0, size_t count)
+{
+	size_t i = 0;
+#if defined(MATHC_F16C)
+	for (; i + 4 <= count; i += 4) {
+		_mm_storel_epi64((__m128i *)(result + i), _mm_cvtps_ph(_mm_loadu_ps(v0 + i), _MM_FROUND_TO_NEAREST_INT));
+	}
+#endif
+	for (; i < count; i++) {
+		result[i] = mathc_half_from_float((float)v0[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *half_decode_n(mfloat_t *result, mhalf_t *v0, size_t count)
+{
+	size_t i = 0;
+#if defined(MATHC_F16C)
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(result + i, _mm_cvtph_ps(_mm_loadl_epi64((__m128i *)(v0 + i))));
+	}
+#endif
+	for (; i < count; i++) {
+		result[i] = (mfloat_t)mathc_float_from_half(v0[i]);
+	}
+	return result;
+}
+
+MATHC_API mbfloat16_t *bfloat16_encode_n(mbfloat16_t *result, mfloat_t *v0, size_t count)
+{
+	union {
+		float f;
+		uint32_t i;
+	} bits;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		bits.f = (float)v0[i];
+		if ((bits.i & UINT32_C(0x7fffffff)) > UINT32_C(0x7f800000)) {
+			/* Keep NaNs quiet, the low bits of the mantissa are dropped */
+			result[i] = (mbfloat16_t)((bits.i >> 16) | 0x40);
+		} else {
+			result[i] = (mbfloat16_t)((bits.i + UINT32_C(0x7fff) + ((bits.i >> 16) & 1)) >> 16);
+		}
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *bfloat16_decode_n(mfloat_t *result, mbfloat16_t *v0, size_t count)
+{
+	union {
+		float f;
+		uint32_t i;
+	} bits;
+	size_t i;
+	for (i = 0; i < count; i++) {
+		bits.i = (uint32_t)v0[i] << 16;
+		result[i] = (mfloat_t)bits.f;
+	}
+	return result;
+}
+
+MATHC_API mfloat_t *mat4_transform_points_half(mfloat_t *result, mhalf_t *v0, size_t count, size_t stride, mfloat_t *m0)
+{
+	mhalf_t packed[MATHC_STREAM_CHUNK * VEC3_SIZE];
+	mfloat_t points[MATHC_STREAM_CHUNK * VEC3_SIZE];
+	mfloat_t m[MAT4_SIZE];
+	size_t i;
+	size_t j;
+	if (stride == 0) {
+		stride = VEC3_SIZE * sizeof(mhalf_t);
+	}
+	/* Keep a copy of the matrix, it may be part of the result array */
+	mat4_assign(m, m0);
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		mhalf_t *in = (mhalf_t *)((char *)v0 + i * stride);
+		if (stride != VEC3_SIZE * sizeof(mhalf_t)) {
+			/* Gather the interleaved positions first */
+			for (j = 0; j < n; j++) {
+				mhalf_t *position = (mhalf_t *)((char *)in + j * stride);
+				packed[j * VEC3_SIZE] = position[0];
+				packed[j * VEC3_SIZE + 1] = position[1];
+				packed[j * VEC3_SIZE + 2] = position[2];
+			}
+			in = packed;
+		}
+		half_decode_n(points, in, n * VEC3_SIZE);
+		mat4_transform_points(result + i * VEC3_SIZE, points, n, 0, m);
+	}
+	return result;
+}
+
+#endif
+
+#if defined(MATHC_USE_FLOATING_POINT) && defined(MATHC_USE_EASING_FUNCTIONS)
+/* Select lower where f is below edge and upper elsewhere, once both have
+ * been computed, so that the loops of the piecewise easing functions
+ * vectorize */
+static void mathc_ease_select(mfloat_t *result, mfloat_t *f, mfloat_t *lower, mfloat_t *upper, mfloat_t edge, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		mfloat_t x = f[i];
+		mfloat_t a = lower[i];
+		mfloat_t b = upper[i];
+		result[i] = x < edge ? a : b;
+	}
+}
+
+MATHC_API mfloat_t quadratic_ease_out(mfloat_t f)
+{
+	return -f * (f - MFLOAT_C(2.0));
+}
+
+MATHC_API mfloat_t *quadratic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = quadratic_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quadratic_ease_in(mfloat_t f)
+{
+	return f * f;
+}
+
+MATHC_API mfloat_t *quadratic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = quadratic_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quadratic_ease_in_out(mfloat_t f)
+{
+	mfloat_t a = MFLOAT_C(0.0);
+	if (f < MFLOAT_C(0.5)) {
+		a = MFLOAT_C(2.0) * f * f;
+	} else {
+		a = -MFLOAT_C(2.0) * f * f + MFLOAT_C(4.0) * f - MFLOAT_C(1.0);
+	}
+	return a;
+}
+
+MATHC_API mfloat_t *quadratic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	mfloat_t lower[MATHC_STREAM_CHUNK];
+	mfloat_t upper[MATHC_STREAM_CHUNK];
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			mfloat_t x = f[i + j];
+			lower[j] = MFLOAT_C(2.0) * x * x;
+			upper[j] = -MFLOAT_C(2.0) * x * x + MFLOAT_C(4.0) * x - MFLOAT_C(1.0);
+		}
+		mathc_ease_select(result + i, f + i, lower, upper, MFLOAT_C(0.5), n);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t cubic_ease_out(mfloat_t f)
+{
+	mfloat_t a = f - MFLOAT_C(1.0);
+	return a * a * a + MFLOAT_C(1.0);
+}
+
+MATHC_API mfloat_t *cubic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = cubic_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t cubic_ease_in(mfloat_t f)
+{
+	return f * f * f;
+}
+
+MATHC_API mfloat_t *cubic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = cubic_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t cubic_ease_in_out(mfloat_t f)
+{
+	mfloat_t a = MFLOAT_C(0.0);
+	if (f < MFLOAT_C(0.5)) {
+		a = MFLOAT_C(4.0) * f * f * f;
+	} else {
+		a = MFLOAT_C(2.0) * f - MFLOAT_C(2.0);
+		a = MFLOAT_C(0.5) * a * a * a + MFLOAT_C(1.0);
+	}
+	return a;
+}
+
+MATHC_API mfloat_t *cubic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	mfloat_t lower[MATHC_STREAM_CHUNK];
+	mfloat_t upper[MATHC_STREAM_CHUNK];
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			mfloat_t x = f[i + j];
+			mfloat_t a = MFLOAT_C(2.0) * x - MFLOAT_C(2.0);
+			lower[j] = MFLOAT_C(4.0) * x * x * x;
+			upper[j] = MFLOAT_C(0.5) * a * a * a + MFLOAT_C(1.0);
+		}
+		mathc_ease_select(result + i, f + i, lower, upper, MFLOAT_C(0.5), n);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quartic_ease_out(mfloat_t f)
+{
+	mfloat_t a = f - MFLOAT_C(1.0);
+	return a * a * a * (MFLOAT_C(1.0) - f) + MFLOAT_C(1.0);
+}
+
+MATHC_API mfloat_t *quartic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = quartic_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quartic_ease_in(mfloat_t f)
+{
+	return f * f * f * f;
+}
+
+MATHC_API mfloat_t *quartic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = quartic_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quartic_ease_in_out(mfloat_t f)
+{
+	mfloat_t a = MFLOAT_C(0.0);
+	if (f < MFLOAT_C(0.5)) {
+		a = MFLOAT_C(8.0) * f * f * f * f;
+	} else {
+		a = f - MFLOAT_C(1.0);
+		a = -MFLOAT_C(8.0) * a * a * a * a + MFLOAT_C(1.0);
+	}
+	return a;
+}
+
+MATHC_API mfloat_t *quartic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	mfloat_t lower[MATHC_STREAM_CHUNK];
+	mfloat_t upper[MATHC_STREAM_CHUNK];
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			mfloat_t x = f[i + j];
+			mfloat_t a = x - MFLOAT_C(1.0);
+			lower[j] = MFLOAT_C(8.0) * x * x * x * x;
+			upper[j] = -MFLOAT_C(8.0) * a * a * a * a + MFLOAT_C(1.0);
+		}
+		mathc_ease_select(result + i, f + i, lower, upper, MFLOAT_C(0.5), n);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quintic_ease_out(mfloat_t f)
+{
+	mfloat_t a = f - MFLOAT_C(1.0);
+	return a * a * a * a * a + MFLOAT_C(1.0);
+}
+
+MATHC_API mfloat_t *quintic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = quintic_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quintic_ease_in(mfloat_t f)
+{
+	return f * f * f * f * f;
+}
+
+MATHC_API mfloat_t *quintic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = quintic_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t quintic_ease_in_out(mfloat_t f)
+{
+	mfloat_t a = MFLOAT_C(0.0);
+	if (f < MFLOAT_C(0.5)) {
+		a = MFLOAT_C(16.0) * f * f * f * f * f;
+	} else {
+		a = MFLOAT_C(2.0) * f - MFLOAT_C(2.0);
+		a = MFLOAT_C(0.5) * a * a * a * a * a + MFLOAT_C(1.0);
+	}
+	return a;
+}
+
+MATHC_API mfloat_t *quintic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	mfloat_t lower[MATHC_STREAM_CHUNK];
+	mfloat_t upper[MATHC_STREAM_CHUNK];
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			mfloat_t x = f[i + j];
+			mfloat_t a = MFLOAT_C(2.0) * x - MFLOAT_C(2.0);
+			lower[j] = MFLOAT_C(16.0) * x * x * x * x * x;
+			upper[j] = MFLOAT_C(0.5) * a * a * a * a * a + MFLOAT_C(1.0);
+		}
+		mathc_ease_select(result + i, f + i, lower, upper, MFLOAT_C(0.5), n);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t sine_ease_out(mfloat_t f)
+{
+	return MSIN(f * MPI_2);
+}
+
+MATHC_API mfloat_t *sine_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = sine_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t sine_ease_in(mfloat_t f)
+{
+	return MSIN((f - MFLOAT_C(1.0)) * MPI_2) + MFLOAT_C(1.0);
+}
+
+MATHC_API mfloat_t *sine_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = sine_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t sine_ease_in_out(mfloat_t f)
 {
 	return MFLOAT_C(0.5) * (MFLOAT_C(1.0) - MCOS(f * MPI));
 }
 
-mfloat_t circular_ease_out(mfloat_t f)
+MATHC_API mfloat_t *sine_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = sine_ease_in_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t circular_ease_out(mfloat_t f)
 {
 	return MSQRT((MFLOAT_C(2.0) - f) * f);
 }
 
-mfloat_t circular_ease_in(mfloat_t f)
+MATHC_API mfloat_t *circular_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = circular_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t circular_ease_in(mfloat_t f)
 {
 	return MFLOAT_C(1.0) - MSQRT(MFLOAT_C(1.0) - (f * f));
 }
 
-mfloat_t circular_ease_in_out(mfloat_t f)
+MATHC_API mfloat_t *circular_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = circular_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t circular_ease_in_out(mfloat_t f)
 {
 	mfloat_t a = MFLOAT_C(0.0);
 	if (f < MFLOAT_C(0.5)) {
@@ -3654,7 +7113,16 @@ mfloat_t circular_ease_in_out(mfloat_t f)
 	return a;
 }
 
-mfloat_t exponential_ease_out(mfloat_t f)
+MATHC_API mfloat_t *circular_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = circular_ease_in_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t exponential_ease_out(mfloat_t f)
 {
 	mfloat_t a = f;
 	if (MFABS(a) > MFLT_EPSILON) {
@@ -3663,7 +7131,16 @@ mfloat_t exponential_ease_out(mfloat_t f)
 	return a;
 }
 
-mfloat_t exponential_ease_in(mfloat_t f)
+MATHC_API mfloat_t *exponential_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = exponential_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t exponential_ease_in(mfloat_t f)
 {
 	mfloat_t a = f;
 	if (MFABS(a) > MFLT_EPSILON) {
@@ -3672,7 +7149,16 @@ mfloat_t exponential_ease_in(mfloat_t f)
 	return a;
 }
 
-mfloat_t exponential_ease_in_out(mfloat_t f)
+MATHC_API mfloat_t *exponential_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = exponential_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t exponential_ease_in_out(mfloat_t f)
 {
 	mfloat_t a = f;
 	if (f < MFLOAT_C(0.5)) {
@@ -3683,17 +7169,44 @@ mfloat_t exponential_ease_in_out(mfloat_t f)
 	return a;
 }
 
-mfloat_t elastic_ease_out(mfloat_t f)
+MATHC_API mfloat_t *exponential_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = exponential_ease_in_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t elastic_ease_out(mfloat_t f)
 {
 	return MSIN(-MFLOAT_C(13.0) * MPI_2 * (f + MFLOAT_C(1.0))) * MPOW(MFLOAT_C(2.0), -MFLOAT_C(10.0) * f) + MFLOAT_C(1.0);
 }
 
-mfloat_t elastic_ease_in(mfloat_t f)
+MATHC_API mfloat_t *elastic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = elastic_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t elastic_ease_in(mfloat_t f)
 {
 	return MSIN(MFLOAT_C(13.0) * MPI_2 * f) * MPOW(MFLOAT_C(2.0), MFLOAT_C(10.0) * (f - MFLOAT_C(1.0)));
 }
 
-mfloat_t elastic_ease_in_out(mfloat_t f)
+MATHC_API mfloat_t *elastic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = elastic_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t elastic_ease_in_out(mfloat_t f)
 {
 	mfloat_t a = MFLOAT_C(0.0);
 	if (f < MFLOAT_C(0.5)) {
@@ -3704,18 +7217,45 @@ mfloat_t elastic_ease_in_out(mfloat_t f)
 	return a;
 }
 
-mfloat_t back_ease_out(mfloat_t f)
+MATHC_API mfloat_t *elastic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = elastic_ease_in_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t back_ease_out(mfloat_t f)
 {
 	mfloat_t a = MFLOAT_C(1.0) - f;
 	return MFLOAT_C(1.0) - (a * a * a - a * MSIN(a * MPI));
 }
 
-mfloat_t back_ease_in(mfloat_t f)
+MATHC_API mfloat_t *back_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = back_ease_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t back_ease_in(mfloat_t f)
 {
 	return f * f * f - f * MSIN(f * MPI);
 }
 
-mfloat_t back_ease_in_out(mfloat_t f)
+MATHC_API mfloat_t *back_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = back_ease_in(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t back_ease_in_out(mfloat_t f)
 {
 	mfloat_t a = MFLOAT_C(0.0);
 	if (f < MFLOAT_C(0.5)) {
@@ -3723,12 +7263,21 @@ mfloat_t back_ease_in_out(mfloat_t f)
 		a = MFLOAT_C(0.5) * (a * a * a - a * MSIN(a * MPI));
 	} else {
 		a = (MFLOAT_C(1.0) - (MFLOAT_C(2.0) * f - MFLOAT_C(1.0)));
-		a = MFLOAT_C(0.5) * (MFLOAT_C(1.0) - (a * a * a - a * MSIN(f * MPI))) + MFLOAT_C(0.5);
+		a = MFLOAT_C(0.5) * (MFLOAT_C(1.0) - (a * a * a - a * MSIN(a * MPI))) + MFLOAT_C(0.5);
 	}
 	return a;
 }
 
-mfloat_t bounce_ease_out(mfloat_t f)
+MATHC_API mfloat_t *back_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		result[i] = back_ease_in_out(f[i]);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t bounce_ease_out(mfloat_t f)
 {
 	mfloat_t a = MFLOAT_C(0.0);
 	if (f < MFLOAT_C(4.0) / MFLOAT_C(11.0)) {
@@ -3743,12 +7292,60 @@ mfloat_t bounce_ease_out(mfloat_t f)
 	return a;
 }
 
-mfloat_t bounce_ease_in(mfloat_t f)
+MATHC_API mfloat_t *bounce_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	mfloat_t piece[MATHC_STREAM_CHUNK];
+	mfloat_t value[MATHC_STREAM_CHUNK];
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		/* Every piece of the curve is computed, then selected from the last
+		 * one to the first */
+		for (j = 0; j < n; j++) {
+			mfloat_t x = f[i + j];
+			value[j] = (MFLOAT_C(54.0) / MFLOAT_C(5.0) * x * x) - (MFLOAT_C(513.0) / MFLOAT_C(25.0) * x) + MFLOAT_C(268.0) / MFLOAT_C(25.0);
+			piece[j] = (MFLOAT_C(4356.0) / MFLOAT_C(361.0) * x * x) - (MFLOAT_C(35442.0) / MFLOAT_C(1805.0) * x) + MFLOAT_C(16061.0) / MFLOAT_C(1805.0);
+		}
+		mathc_ease_select(value, f + i, piece, value, MFLOAT_C(9.0) / MFLOAT_C(10.0), n);
+		for (j = 0; j < n; j++) {
+			mfloat_t x = f[i + j];
+			piece[j] = (MFLOAT_C(363.0) / MFLOAT_C(40.0) * x * x) - (MFLOAT_C(99.0) / MFLOAT_C(10.0) * x) + MFLOAT_C(17.0) / MFLOAT_C(5.0);
+		}
+		mathc_ease_select(value, f + i, piece, value, MFLOAT_C(8.0) / MFLOAT_C(11.0), n);
+		for (j = 0; j < n; j++) {
+			mfloat_t x = f[i + j];
+			piece[j] = (MFLOAT_C(121.0) * x * x) / MFLOAT_C(16.0);
+		}
+		mathc_ease_select(result + i, f + i, piece, value, MFLOAT_C(4.0) / MFLOAT_C(11.0), n);
+	}
+	return result;
+}
+
+MATHC_API mfloat_t bounce_ease_in(mfloat_t f)
 {
 	return MFLOAT_C(1.0) - bounce_ease_out(MFLOAT_C(1.0) - f);
 }
 
-mfloat_t bounce_ease_in_out(mfloat_t f)
+MATHC_API mfloat_t *bounce_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	mfloat_t g[MATHC_STREAM_CHUNK];
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			g[j] = MFLOAT_C(1.0) - f[i + j];
+		}
+		bounce_ease_out_n(result + i, g, n);
+		for (j = 0; j < n; j++) {
+			result[i + j] = MFLOAT_C(1.0) - result[i + j];
+		}
+	}
+	return result;
+}
+
+MATHC_API mfloat_t bounce_ease_in_out(mfloat_t f)
 {
 	mfloat_t a = MFLOAT_C(0.0);
 	if (f < MFLOAT_C(0.5)) {
@@ -3758,4 +7355,95 @@ mfloat_t bounce_ease_in_out(mfloat_t f)
 	}
 	return a;
 }
+
+MATHC_API mfloat_t *bounce_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count)
+{
+	mfloat_t g[MATHC_STREAM_CHUNK];
+	mfloat_t lower[MATHC_STREAM_CHUNK];
+	mfloat_t upper[MATHC_STREAM_CHUNK];
+	size_t i;
+	size_t j;
+	for (i = 0; i < count; i += MATHC_STREAM_CHUNK) {
+		size_t n = count - i < MATHC_STREAM_CHUNK ? count - i : MATHC_STREAM_CHUNK;
+		for (j = 0; j < n; j++) {
+			g[j] = MFLOAT_C(1.0) - f[i + j] * MFLOAT_C(2.0);
+		}
+		bounce_ease_out_n(lower, g, n);
+		for (j = 0; j < n; j++) {
+			lower[j] = MFLOAT_C(0.5) * (MFLOAT_C(1.0) - lower[j]);
+			g[j] = f[i + j] * MFLOAT_C(2.0) - MFLOAT_C(1.0);
+		}
+		bounce_ease_out_n(upper, g, n);
+		for (j = 0; j < n; j++) {
+			upper[j] = MFLOAT_C(0.5) * upper[j] + MFLOAT_C(0.5);
+		}
+		mathc_ease_select(result + i, f + i, lower, upper, MFLOAT_C(0.5), n);
+	}
+	return result;
+}
+
+MATHC_API struct ease_table *ease_table(struct ease_table *result, mfloat_t (*func)(mfloat_t f), mfloat_t *values, size_t count, bool cubic)
+{
+	size_t i;
+	for (i = 0; i < count; i++) {
+		values[i + 1] = func((mfloat_t)i / (mfloat_t)(count - 1));
+	}
+	/* One sample past each end, extrapolated from the parabola through the
+	 * last three, so that the cubic interpolation needs no special case */
+	values[0] = MFLOAT_C(3.0) * (values[1] - values[2]) + values[3];
+	values[count + 1] = MFLOAT_C(3.0) * (values[count] - values[count - 1]) + values[count - 2];
+	result->values = values;
+	result->count = count;
+	result->cubic = cubic;
+	return result;
+}
+
+MATHC_API mfloat_t ease_table_sample(struct ease_table *t0, mfloat_t f)
+{
+	mfloat_t result;
+	ease_table_sample_n(&result, t0, &f, 1);
+	return result;
+}
+
+MATHC_API mfloat_t *ease_table_sample_n(mfloat_t *result, struct ease_table *t0, mfloat_t *f, size_t count)
+{
+	mfloat_t *v = t0->values;
+	mfloat_t scale = (mfloat_t)(t0->count - 1);
+	mfloat_t end = (mfloat_t)(t0->count - 2);
+	size_t i;
+	if (t0->cubic) {
+		for (i = 0; i < count; i++) {
+			mfloat_t x = f[i] * scale;
+			int k;
+			mfloat_t t;
+			mfloat_t p0;
+			mfloat_t p1;
+			mfloat_t p2;
+			mfloat_t p3;
+			x = x > MFLOAT_C(0.0) ? x : MFLOAT_C(0.0);
+			x = x < scale ? x : scale;
+			k = (int)(x < end ? x : end);
+			t = x - (mfloat_t)k;
+			/* Catmull-Rom spline through the four samples around x */
+			p0 = v[k];
+			p1 = v[k + 1];
+			p2 = v[k + 2];
+			p3 = v[k + 3];
+			result[i] = p1 + MFLOAT_C(0.5) * t * (p2 - p0 + t * (MFLOAT_C(2.0) * p0 - MFLOAT_C(5.0) * p1 + MFLOAT_C(4.0) * p2 - p3
+				+ t * (MFLOAT_C(3.0) * (p1 - p2) + p3 - p0)));
+		}
+	} else {
+		for (i = 0; i < count; i++) {
+			mfloat_t x = f[i] * scale;
+			int k;
+			mfloat_t t;
+			x = x > MFLOAT_C(0.0) ? x : MFLOAT_C(0.0);
+			x = x < scale ? x : scale;
+			k = (int)(x < end ? x : end);
+			t = x - (mfloat_t)k;
+			result[i] = v[k + 1] + (v[k + 2] - v[k + 1]) * t;
+		}
+	}
+	return result;
+}
 #endif
@@ -23,6 +23,7 @@ the following restrictions:
 #define MATHC_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <math.h>
 
 #define MATHC_VERSION_YYYY 2019
@@ -41,9 +42,7 @@ the following restrictions:
 #define MATHC_USE_EASING_FUNCTIONS
 #endif
 
-#if defined(MATHC_USE_INT)
 #include <stdint.h>
-#endif
 #if defined(MATHC_USE_FLOATING_POINT)
 #include <float.h>
 #endif
@@ -54,7 +53,16 @@ the following restrictions:
 #define QUAT_SIZE 4
 #define MAT2_SIZE 4
 #define MAT3_SIZE 9
+#define MAT3_STD140_SIZE 12
 #define MAT4_SIZE 16
+#define DUALQUAT_SIZE 8
+#define TRS_SIZE 10
+#define FRUSTUM_SIZE 24
+
+#define ANIMATION_STEP 0
+#define ANIMATION_LINEAR 1
+#define ANIMATION_SLERP 2
+#define ANIMATION_CUBIC 3
 
 #if defined(MATHC_USE_INT)
 #if defined(MATHC_INT_TYPE)
@@ -108,7 +116,9 @@ typedef float mfloat_t;
 #define MPI_2 1.5707963268f
 #define MPI_4 0.7853981634f
 #define MFLT_EPSILON FLT_EPSILON
+#define MFLT_MIN FLT_MIN
 #define MFABS fabsf
+#define MCOPYSIGN copysignf
 #define MFMIN fminf
 #define MFMAX fmaxf
 #define MSQRT sqrtf
@@ -132,7 +142,9 @@ typedef double mfloat_t;
 #define MPI_2 1.57079632679489661923
 #define MPI_4 0.78539816339744830962
 #define MFLT_EPSILON DBL_EPSILON
+#define MFLT_MIN DBL_MIN
 #define MFABS fabs
+#define MCOPYSIGN copysign
 #define MFMIN fmin
 #define MFMAX fmax
 #define MSQRT sqrt
@@ -148,346 +160,652 @@ typedef double mfloat_t;
 #define MROUND round
 #define MFLOAT_C(c) c
 #endif
+/* Storage only 16-bit floating-point values, converted to and from mfloat_t
+ * in bulk */
+typedef uint16_t mhalf_t;
+typedef uint16_t mbfloat16_t;
+#endif
+
+#if !defined(MATHC_RESTRICT)
+#if defined(__cplusplus)
+#define MATHC_RESTRICT __restrict
+#else
+#define MATHC_RESTRICT restrict
+#endif
+#endif
+
+#if !defined(MATHC_FAST_ACCURACY)
+#define MATHC_FAST_ACCURACY 6
+#endif
+
+#if defined(MATHC_USE_FLOATING_POINT) && defined(MATHC_FAST_MATH)
+#undef MSIN
+#undef MCOS
+#undef MACOS
+#undef MATAN2
+#define MSIN mathc_sin
+#define MCOS mathc_cos
+#define MACOS mathc_acos
+#define MATAN2 mathc_atan2
+#endif
+
+/* Sine and cosine of the same angle, stored through the pointers s and c */
+#if defined(MATHC_USE_FLOATING_POINT) && !defined(MSINCOS)
+#if defined(MATHC_FAST_MATH)
+#define MSINCOS(x, s, c) mathc_sincos((x), (s), (c))
+#else
+#define MSINCOS(x, s, c) (*(s) = MSIN(x), *(c) = MCOS(x))
+#endif
+#endif
+
+#if defined(MATHC_INLINE)
+#define MATHC_API static inline
+#else
+#define MATHC_API
+#endif
+
+#if defined(MATHC_USE_SSE) && defined(MATHC_USE_SINGLE_FLOATING_POINT) && !defined(MATHC_FLOATING_POINT_TYPE)
+#define MATHC_SSE
+#endif
+
+#if defined(MATHC_USE_FLOATING_POINT)
+/* Structure-of-arrays vec3, with one array of count elements per component.
+ * The stream functions process the count elements of their first input
+ * stream and set the count of a result stream to it */
+struct vec3_stream {
+	mfloat_t *x;
+	mfloat_t *y;
+	mfloat_t *z;
+	size_t count;
+};
+
+/* Flat transform hierarchy of count nodes. The parent of a node is stored
+ * before it (parents[i] < i), or is -1 for a root. local and world hold
+ * count matrices each, and dirty marks the nodes whose local matrix changed */
+struct mat4_hierarchy {
+	int *parents;
+	mfloat_t *local;
+	mfloat_t *world;
+	bool *dirty;
+	size_t count;
+};
+
+/* Node of a struct bvh, 32 bytes with float. An interior node has a count
+ * of 0 and its two children at first and first + 1, a leaf holds the count
+ * primitives listed from indices[first] */
+struct bvh_node {
+	mfloat_t min[VEC3_SIZE];
+	mfloat_t max[VEC3_SIZE];
+	int first;
+	int count;
+};
+
+/* Bounding volume hierarchy over count primitives. nodes must have room
+ * for 2 * count - 1 nodes and indices for count indices */
+struct bvh {
+	struct bvh_node *nodes;
+	int *indices;
+	size_t count;
+	size_t node_count;
+};
+
+/* Elements of stride bytes each, starting at an aligned address inside
+ * memory provided by the caller. capacity is the number of elements that
+ * fit after the alignment */
+struct aligned_buffer {
+	mfloat_t *data;
+	size_t stride;
+	size_t capacity;
+};
+
+/* Keyframes of one animated value of size elements. times holds count
+ * increasing key times and values the keys one after another, each as an
+ * in control point, the value and an out control point with
+ * ANIMATION_CUBIC. cursor is the key found by the last sample */
+struct animation_track {
+	mfloat_t *times;
+	mfloat_t *values;
+	size_t count;
+	int size;
+	int interpolation;
+	size_t cursor;
+};
+#endif
+
+#if defined(MATHC_USE_THREADS)
+#include <pthread.h>
+#if !defined(MATHC_MAX_THREADS)
+#define MATHC_MAX_THREADS 64
+#endif
+/* Worker threads owned by the caller, started once and woken by each
+ * dispatch. threads is the number of workers that were started, the
+ * thread that dispatches not included. The other members hold the
+ * range of the current dispatch */
+struct mathc_thread_pool {
+	pthread_mutex_t mutex;
+	pthread_cond_t wake;
+	pthread_cond_t done;
+	pthread_t workers[MATHC_MAX_THREADS];
+	int threads;
+	int busy;
+	unsigned long generation;
+	bool stop;
+	size_t next;
+	size_t count;
+	size_t grain;
+	void (*func)(void *data, size_t begin, size_t end);
+	void *data;
+};
+
+MATHC_API struct mathc_thread_pool *mathc_thread_pool_create(struct mathc_thread_pool *result, int threads);
+MATHC_API void mathc_thread_pool_dispatch(struct mathc_thread_pool *pool, size_t count, size_t grain, void (*func)(void *data, size_t begin, size_t end), void *data);
+MATHC_API void mathc_thread_pool_destroy(struct mathc_thread_pool *pool);
+MATHC_API void mathc_parallel_for(size_t count, size_t grain, void (*func)(void *data, size_t begin, size_t end), void *data, int threads);
 #endif
 
 #if defined(MATHC_USE_INT)
-mint_t clampi(mint_t value, mint_t min, mint_t max);
+MATHC_API mint_t clampi(mint_t value, mint_t min, mint_t max);
 #endif
 
 #if defined(MATHC_USE_FLOATING_POINT)
 #define MRADIANS(degrees) (degrees * MPI / MFLOAT_C(180.0))
 #define MDEGREES(radians) (radians * MFLOAT_C(180.0) / MPI)
-bool nearly_equal(mfloat_t a, mfloat_t b, mfloat_t epsilon);
-mfloat_t to_radians(mfloat_t degrees);
-mfloat_t to_degrees(mfloat_t radians);
-mfloat_t clampf(mfloat_t value, mfloat_t min, mfloat_t max);
+MATHC_API bool nearly_equal(mfloat_t a, mfloat_t b, mfloat_t epsilon);
+MATHC_API mfloat_t to_radians(mfloat_t degrees);
+MATHC_API mfloat_t to_degrees(mfloat_t radians);
+MATHC_API mfloat_t clampf(mfloat_t value, mfloat_t min, mfloat_t max);
+MATHC_API mfloat_t mathc_sin(mfloat_t x);
+MATHC_API mfloat_t mathc_cos(mfloat_t x);
+MATHC_API void mathc_sincos(mfloat_t x, mfloat_t *s, mfloat_t *c);
+MATHC_API mfloat_t mathc_acos(mfloat_t x);
+MATHC_API mfloat_t mathc_atan2(mfloat_t y, mfloat_t x);
 #endif
 
 #if defined(MATHC_USE_INT)
-bool vec2i_is_zero(mint_t *v0);
-bool vec2i_is_equal(mint_t *v0, mint_t *v1);
-mint_t *vec2i(mint_t *result, mint_t x, mint_t y);
-mint_t *vec2i_assign(mint_t *result, mint_t *v0);
+MATHC_API bool vec2i_is_zero(mint_t *v0);
+MATHC_API bool vec2i_is_equal(mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec2i(mint_t *result, mint_t x, mint_t y);
+MATHC_API mint_t *vec2i_assign(mint_t *result, mint_t *v0);
 #if defined(MATHC_USE_FLOATING_POINT)
-mint_t *vec2i_assign_vec2(mint_t *result, mfloat_t *v0);
-#endif
-mint_t *vec2i_zero(mint_t *result);
-mint_t *vec2i_one(mint_t *result);
-mint_t *vec2i_sign(mint_t *result, mint_t *v0);
-mint_t *vec2i_add(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec2i_add_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec2i_subtract(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec2i_subtract_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec2i_multiply(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec2i_multiply_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec2i_divide(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec2i_divide_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec2i_snap(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec2i_snap_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec2i_negative(mint_t *result, mint_t *v0);
-mint_t *vec2i_abs(mint_t *result, mint_t *v0);
-mint_t *vec2i_max(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec2i_min(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec2i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2);
-mint_t *vec2i_tangent(mint_t *result, mint_t *v0);
-bool vec3i_is_zero(mint_t *v0);
-bool vec3i_is_equal(mint_t *v0, mint_t *v1);
-mint_t *vec3i(mint_t *result, mint_t x, mint_t y, mint_t z);
-mint_t *vec3i_assign(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec2i_assign_vec2(mint_t *result, mfloat_t *v0);
+#endif
+MATHC_API mint_t *vec2i_zero(mint_t *result);
+MATHC_API mint_t *vec2i_one(mint_t *result);
+MATHC_API mint_t *vec2i_sign(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec2i_add(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec2i_add_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec2i_subtract(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec2i_subtract_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec2i_multiply(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec2i_multiply_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec2i_divide(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec2i_divide_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec2i_snap(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec2i_snap_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec2i_negative(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec2i_abs(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec2i_max(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec2i_min(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec2i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2);
+MATHC_API mint_t *vec2i_tangent(mint_t *result, mint_t *v0);
+MATHC_API bool vec3i_is_zero(mint_t *v0);
+MATHC_API bool vec3i_is_equal(mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i(mint_t *result, mint_t x, mint_t y, mint_t z);
+MATHC_API mint_t *vec3i_assign(mint_t *result, mint_t *v0);
 #if defined(MATHC_USE_FLOATING_POINT)
-mint_t *vec3i_assign_vec3(mint_t *result, mfloat_t *v0);
-#endif
-mint_t *vec3i_zero(mint_t *result);
-mint_t *vec3i_one(mint_t *result);
-mint_t *vec3i_sign(mint_t *result, mint_t *v0);
-mint_t *vec3i_add(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec3i_add_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec3i_subtract(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec3i_subtract_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec3i_multiply(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec3i_multiply_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec3i_divide(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec3i_divide_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec3i_snap(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec3i_snap_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec3i_cross(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec3i_negative(mint_t *result, mint_t *v0);
-mint_t *vec3i_abs(mint_t *result, mint_t *v0);
-mint_t *vec3i_max(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec3i_min(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec3i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2);
-bool vec4i_is_zero(mint_t *v0);
-bool vec4i_is_equal(mint_t *v0, mint_t *v1);
-mint_t *vec4i(mint_t *result, mint_t x, mint_t y, mint_t z, mint_t w);
-mint_t *vec4i_assign(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec3i_assign_vec3(mint_t *result, mfloat_t *v0);
+#endif
+MATHC_API mint_t *vec3i_zero(mint_t *result);
+MATHC_API mint_t *vec3i_one(mint_t *result);
+MATHC_API mint_t *vec3i_sign(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec3i_add(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i_add_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec3i_subtract(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i_subtract_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec3i_multiply(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i_multiply_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec3i_divide(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i_divide_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec3i_snap(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i_snap_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec3i_cross(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i_negative(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec3i_abs(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec3i_max(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i_min(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec3i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2);
+MATHC_API bool vec4i_is_zero(mint_t *v0);
+MATHC_API bool vec4i_is_equal(mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec4i(mint_t *result, mint_t x, mint_t y, mint_t z, mint_t w);
+MATHC_API mint_t *vec4i_assign(mint_t *result, mint_t *v0);
 #if defined(MATHC_USE_FLOATING_POINT)
-mint_t *vec4i_assign_vec4(mint_t *result, mfloat_t *v0);
-#endif
-mint_t *vec4i_zero(mint_t *result);
-mint_t *vec4i_one(mint_t *result);
-mint_t *vec4i_sign(mint_t *result, mint_t *v0);
-mint_t *vec4i_add(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec4i_add_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec4i_subtract(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec4i_subtract_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec4i_multiply(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec4i_multiply_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec4i_divide(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec4i_divide_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec4i_snap(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec4i_snap_i(mint_t *result, mint_t *v0, mint_t i);
-mint_t *vec4i_negative(mint_t *result, mint_t *v0);
-mint_t *vec4i_abs(mint_t *result, mint_t *v0);
-mint_t *vec4i_max(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec4i_min(mint_t *result, mint_t *v0, mint_t *v1);
-mint_t *vec4i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2);
+MATHC_API mint_t *vec4i_assign_vec4(mint_t *result, mfloat_t *v0);
+#endif
+MATHC_API mint_t *vec4i_zero(mint_t *result);
+MATHC_API mint_t *vec4i_one(mint_t *result);
+MATHC_API mint_t *vec4i_sign(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec4i_add(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec4i_add_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec4i_subtract(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec4i_subtract_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec4i_multiply(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec4i_multiply_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec4i_divide(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec4i_divide_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec4i_snap(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec4i_snap_i(mint_t *result, mint_t *v0, mint_t i);
+MATHC_API mint_t *vec4i_negative(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec4i_abs(mint_t *result, mint_t *v0);
+MATHC_API mint_t *vec4i_max(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec4i_min(mint_t *result, mint_t *v0, mint_t *v1);
+MATHC_API mint_t *vec4i_clamp(mint_t *result, mint_t *v0, mint_t *v1, mint_t *v2);
 #endif
 #if defined(MATHC_USE_FLOATING_POINT)
-bool vec2_is_zero(mfloat_t *v0);
-bool vec2_is_equal(mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2(mfloat_t *result, mfloat_t x, mfloat_t y);
-mfloat_t *vec2_assign(mfloat_t *result, mfloat_t *v0);
+MATHC_API bool vec2_is_zero(mfloat_t *v0);
+MATHC_API bool vec2_is_equal(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2(mfloat_t *result, mfloat_t x, mfloat_t y);
+MATHC_API mfloat_t *vec2_assign(mfloat_t *result, mfloat_t *v0);
 #if defined(MATHC_USE_INT)
-mfloat_t *vec2_assign_vec2i(mfloat_t *result, mint_t *v0);
-#endif
-mfloat_t *vec2_zero(mfloat_t *result);
-mfloat_t *vec2_one(mfloat_t *result);
-mfloat_t *vec2_sign(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec2_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec2_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec2_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec2_multiply_mat2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
-mfloat_t *vec2_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec2_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec2_negative(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec2_abs(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec2_floor(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec2_ceil(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec2_round(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec2_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
-mfloat_t vec2_cross(mfloat_t *v0, mfloat_t* v1);
-mfloat_t *vec2_normalize(mfloat_t *result, mfloat_t *v0);
-mfloat_t vec2_dot(mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec2_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
-mfloat_t *vec2_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
-mfloat_t *vec2_tangent(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec2_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec2_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f);
-mfloat_t *vec2_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v);
-mfloat_t *vec2_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f);
-mfloat_t *vec2_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f);
-mfloat_t vec2_angle(mfloat_t *v0);
-mfloat_t vec2_length(mfloat_t *v0);
-mfloat_t vec2_length_squared(mfloat_t *v0);
-mfloat_t vec2_distance(mfloat_t *v0, mfloat_t *v1);
-mfloat_t vec2_distance_squared(mfloat_t *v0, mfloat_t *v1);
-bool vec2_linear_independent(mfloat_t *v0, mfloat_t *v1);
-mfloat_t** vec2_orthonormalization(mfloat_t result[2][2], mfloat_t basis[2][2]);
-bool vec3_is_zero(mfloat_t *v0);
-bool vec3_is_equal(mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z);
-mfloat_t *vec3_assign(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_assign_vec2i(mfloat_t *result, mint_t *v0);
+#endif
+MATHC_API mfloat_t *vec2_zero(mfloat_t *result);
+MATHC_API mfloat_t *vec2_one(mfloat_t *result);
+MATHC_API mfloat_t *vec2_sign(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec2_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec2_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec2_multiply_mat2(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
+MATHC_API mfloat_t *vec2_multiply_mat2_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT v0, mfloat_t *MATHC_RESTRICT m0);
+MATHC_API mfloat_t *vec2_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec2_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec2_negative(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_abs(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_floor(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_ceil(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_round(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API mfloat_t vec2_cross(mfloat_t *v0, mfloat_t* v1);
+MATHC_API mfloat_t *vec2_normalize(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_normalize_fast(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t vec2_dot(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec2_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
+MATHC_API mfloat_t *vec2_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
+MATHC_API mfloat_t *vec2_tangent(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec2_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec2_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f);
+MATHC_API mfloat_t *vec2_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v);
+MATHC_API mfloat_t *vec2_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f);
+MATHC_API mfloat_t *vec2_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f);
+MATHC_API mfloat_t vec2_angle(mfloat_t *v0);
+MATHC_API mfloat_t vec2_length(mfloat_t *v0);
+MATHC_API mfloat_t vec2_length_squared(mfloat_t *v0);
+MATHC_API mfloat_t vec2_distance(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t vec2_distance_squared(mfloat_t *v0, mfloat_t *v1);
+MATHC_API bool vec2_linear_independent(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t** vec2_orthonormalization(mfloat_t result[2][2], mfloat_t basis[2][2]);
+MATHC_API bool vec3_is_zero(mfloat_t *v0);
+MATHC_API bool vec3_is_equal(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z);
+MATHC_API mfloat_t *vec3_assign(mfloat_t *result, mfloat_t *v0);
 #if defined(MATHC_USE_INT)
-mfloat_t *vec3_assign_vec3i(mfloat_t *result, mint_t *v0);
-#endif
-mfloat_t *vec3_zero(mfloat_t *result);
-mfloat_t *vec3_one(mfloat_t *result);
-mfloat_t *vec3_sign(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec3_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec3_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec3_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec3_multiply_mat3(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
-mfloat_t *vec3_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec3_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec3_negative(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec3_abs(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec3_floor(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec3_ceil(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec3_round(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec3_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
-mfloat_t *vec3_cross(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_normalize(mfloat_t *result, mfloat_t *v0);
-mfloat_t vec3_dot(mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec3_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
-mfloat_t *vec3_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
-mfloat_t *vec3_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f);
-mfloat_t *vec3_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f);
-mfloat_t *vec3_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v);
-mfloat_t *vec3_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f);
-mfloat_t *vec3_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f);
-mfloat_t vec3_length(mfloat_t *v0);
-mfloat_t vec3_length_squared(mfloat_t *v0);
-mfloat_t vec3_distance(mfloat_t *v0, mfloat_t *v1);
-mfloat_t vec3_distance_squared(mfloat_t *v0, mfloat_t *v1);
-bool vec3_linear_independent(mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
-mfloat_t** vec3_orthonormalization(mfloat_t result[3][3], mfloat_t basis[3][3]);
-bool vec4_is_zero(mfloat_t *v0);
-bool vec4_is_equal(mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w);
-mfloat_t *vec4_assign(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_assign_vec3i(mfloat_t *result, mint_t *v0);
+#endif
+MATHC_API mfloat_t *vec3_zero(mfloat_t *result);
+MATHC_API mfloat_t *vec3_one(mfloat_t *result);
+MATHC_API mfloat_t *vec3_sign(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec3_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec3_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec3_multiply_mat3(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
+MATHC_API mfloat_t *vec3_multiply_mat3_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT v0, mfloat_t *MATHC_RESTRICT m0);
+MATHC_API mfloat_t *vec3_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec3_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec3_negative(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_abs(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_floor(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_ceil(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_round(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API mfloat_t *vec3_cross(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_cross_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT v0, mfloat_t *MATHC_RESTRICT v1);
+MATHC_API mfloat_t *vec3_normalize(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_normalize_fast(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_normalize_n_fast(mfloat_t *result, mfloat_t *v0, size_t count);
+MATHC_API mfloat_t vec3_dot(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_project(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec3_slide(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
+MATHC_API mfloat_t *vec3_reflect(mfloat_t *result, mfloat_t *v0, mfloat_t *normal);
+MATHC_API mfloat_t *vec3_rotate(mfloat_t *result, mfloat_t *v0, mfloat_t *ra, mfloat_t f);
+MATHC_API mfloat_t *vec3_rotate_quat(mfloat_t *result, mfloat_t *v0, mfloat_t *q0);
+MATHC_API mfloat_t *vec3_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f);
+MATHC_API mfloat_t *vec3_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v);
+MATHC_API mfloat_t *vec3_bezier3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t f);
+MATHC_API mfloat_t *vec3_bezier4(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t f);
+MATHC_API mfloat_t vec3_length(mfloat_t *v0);
+MATHC_API mfloat_t vec3_length_squared(mfloat_t *v0);
+MATHC_API mfloat_t vec3_distance(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t vec3_distance_squared(mfloat_t *v0, mfloat_t *v1);
+MATHC_API bool vec3_linear_independent(mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API mfloat_t** vec3_orthonormalization(mfloat_t result[3][3], mfloat_t basis[3][3]);
+MATHC_API struct vec3_stream *vec3_stream_add(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API struct vec3_stream *vec3_stream_add_f(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t f);
+MATHC_API struct vec3_stream *vec3_stream_subtract(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API struct vec3_stream *vec3_stream_subtract_f(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t f);
+MATHC_API struct vec3_stream *vec3_stream_multiply(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API struct vec3_stream *vec3_stream_multiply_f(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t f);
+MATHC_API struct vec3_stream *vec3_stream_divide(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API struct vec3_stream *vec3_stream_divide_f(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t f);
+MATHC_API struct vec3_stream *vec3_stream_negative(struct vec3_stream *result, struct vec3_stream *v0);
+MATHC_API struct vec3_stream *vec3_stream_abs(struct vec3_stream *result, struct vec3_stream *v0);
+MATHC_API struct vec3_stream *vec3_stream_max(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API struct vec3_stream *vec3_stream_min(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API struct vec3_stream *vec3_stream_clamp(struct vec3_stream *result, struct vec3_stream *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API struct vec3_stream *vec3_stream_cross(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API struct vec3_stream *vec3_stream_normalize(struct vec3_stream *result, struct vec3_stream *v0);
+MATHC_API struct vec3_stream *vec3_stream_normalize_fast(struct vec3_stream *result, struct vec3_stream *v0);
+MATHC_API struct vec3_stream *vec3_stream_lerp(struct vec3_stream *result, struct vec3_stream *v0, struct vec3_stream *v1, mfloat_t f);
+MATHC_API mfloat_t *vec3_stream_dot(mfloat_t *result, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API mfloat_t *vec3_stream_length(mfloat_t *result, struct vec3_stream *v0);
+MATHC_API mfloat_t *vec3_stream_length_squared(mfloat_t *result, struct vec3_stream *v0);
+MATHC_API bool vec4_is_zero(mfloat_t *v0);
+MATHC_API bool vec4_is_equal(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w);
+MATHC_API mfloat_t *vec4_assign(mfloat_t *result, mfloat_t *v0);
 #if defined(MATHC_USE_INT)
-mfloat_t *vec4_assign_vec4i(mfloat_t *result, mint_t *v0);
-#endif
-mfloat_t *vec4_zero(mfloat_t *result);
-mfloat_t *vec4_one(mfloat_t *result);
-mfloat_t *vec4_sign(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec4_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec4_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec4_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
-mfloat_t *vec4_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec4_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *vec4_negative(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec4_abs(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec4_floor(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec4_ceil(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec4_round(mfloat_t *result, mfloat_t *v0);
-mfloat_t *vec4_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
-mfloat_t *vec4_normalize(mfloat_t *result, mfloat_t *v0);
-mfloat_t vec4_dot(mfloat_t *v0, mfloat_t *v1);
-mfloat_t *vec4_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f);
-mfloat_t *vec4_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v);
-bool quat_is_zero(mfloat_t *q0);
-bool quat_is_equal(mfloat_t *q0, mfloat_t *q1);
-mfloat_t *quat(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w);
-mfloat_t *quat_assign(mfloat_t *result, mfloat_t *q0);
-mfloat_t *quat_zero(mfloat_t *result);
-mfloat_t *quat_null(mfloat_t *result);
-mfloat_t *quat_multiply(mfloat_t *result, mfloat_t *q0, mfloat_t *q1);
-mfloat_t *quat_multiply_f(mfloat_t *result, mfloat_t *q0, mfloat_t f);
-mfloat_t *quat_divide(mfloat_t *result, mfloat_t *q0, mfloat_t *q1);
-mfloat_t *quat_divide_f(mfloat_t *result, mfloat_t *q0, mfloat_t f);
-mfloat_t *quat_negative(mfloat_t *result, mfloat_t *q0);
-mfloat_t *quat_conjugate(mfloat_t *result, mfloat_t *q0);
-mfloat_t *quat_inverse(mfloat_t *result, mfloat_t *q0);
-mfloat_t *quat_normalize(mfloat_t *result, mfloat_t *q0);
-mfloat_t quat_dot(mfloat_t *q0, mfloat_t *q1);
-mfloat_t *quat_power(mfloat_t *result, mfloat_t *q0, mfloat_t exponent);
-mfloat_t *quat_from_axis_angle(mfloat_t *result, mfloat_t *v0, mfloat_t angle);
-mfloat_t *quat_from_vec3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
-mfloat_t *quat_from_mat4(mfloat_t *result, mfloat_t *m0);
-mfloat_t *quat_lerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f);
-mfloat_t *quat_slerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f);
-mfloat_t quat_length(mfloat_t *q0);
-mfloat_t quat_length_squared(mfloat_t *q0);
-mfloat_t quat_angle(mfloat_t *q0, mfloat_t *q1);
-mfloat_t *mat2(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22);
-mfloat_t *mat2_zero(mfloat_t *result);
-mfloat_t *mat2_identity(mfloat_t *result);
-mfloat_t mat2_determinant(mfloat_t *m0);
-mfloat_t *mat2_assign(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat2_negative(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat2_transpose(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat2_cofactor(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat2_adjugate(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat2_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
-mfloat_t *mat2_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f);
-mfloat_t *mat2_inverse(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat2_scaling(mfloat_t *result, mfloat_t *v0);
-mfloat_t *mat2_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
-mfloat_t *mat2_rotation_z(mfloat_t *result, mfloat_t f);
-mfloat_t *mat2_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f);
-mfloat_t *mat3(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m31, mfloat_t m32, mfloat_t m33);
-mfloat_t *mat3_zero(mfloat_t *result);
-mfloat_t *mat3_identity(mfloat_t *result);
-mfloat_t mat3_determinant(mfloat_t *m0);
-mfloat_t *mat3_assign(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat3_negative(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat3_transpose(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat3_cofactor(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat3_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
-mfloat_t *mat3_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f);
-mfloat_t *mat3_inverse(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat3_scaling(mfloat_t *result, mfloat_t *v0);
-mfloat_t *mat3_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
-mfloat_t *mat3_rotation_x(mfloat_t *result, mfloat_t f);
-mfloat_t *mat3_rotation_y(mfloat_t *result, mfloat_t f);
-mfloat_t *mat3_rotation_z(mfloat_t *result, mfloat_t f);
-mfloat_t *mat3_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *mat3_rotation_quat(mfloat_t *result, mfloat_t *q0);
-mfloat_t *mat3_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f);
-mfloat_t *mat4(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34, mfloat_t m41, mfloat_t m42, mfloat_t m43, mfloat_t m44);
-mfloat_t *mat4_zero(mfloat_t *result);
-mfloat_t *mat4_identity(mfloat_t *result);
-mfloat_t mat4_determinant(mfloat_t *m0);
-mfloat_t *mat4_assign(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat4_negative(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat4_transpose(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat4_cofactor(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat4_rotation_x(mfloat_t *result, mfloat_t f);
-mfloat_t *mat4_rotation_y(mfloat_t *result, mfloat_t f);
-mfloat_t *mat4_rotation_z(mfloat_t *result, mfloat_t f);
-mfloat_t *mat4_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f);
-mfloat_t *mat4_rotation_quat(mfloat_t *result, mfloat_t *q0);
-mfloat_t *mat4_translation(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
-mfloat_t *mat4_translate(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
-mfloat_t *mat4_scaling(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
-mfloat_t *mat4_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
-mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
-mfloat_t *mat4_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f);
-mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0);
-mfloat_t *mat4_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f);
-mfloat_t *mat4_look_at(mfloat_t *result, mfloat_t *position, mfloat_t *target, mfloat_t *up);
-mfloat_t *mat4_ortho(mfloat_t *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f);
-mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f);
-mfloat_t *mat4_perspective_fov(mfloat_t *result, mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f);
-mfloat_t *mat4_perspective_infinite(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n);
+MATHC_API mfloat_t *vec4_assign_vec4i(mfloat_t *result, mint_t *v0);
+#endif
+MATHC_API mfloat_t *vec4_zero(mfloat_t *result);
+MATHC_API mfloat_t *vec4_one(mfloat_t *result);
+MATHC_API mfloat_t *vec4_sign(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec4_add(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4_add_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec4_subtract(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4_subtract_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec4_multiply(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4_multiply_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec4_multiply_mat4(mfloat_t *result, mfloat_t *v0, mfloat_t *m0);
+MATHC_API mfloat_t *vec4_multiply_mat4_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT v0, mfloat_t *MATHC_RESTRICT m0);
+MATHC_API mfloat_t *vec4_divide(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4_divide_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec4_snap(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4_snap_f(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *vec4_negative(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec4_abs(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec4_floor(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec4_ceil(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec4_round(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec4_max(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4_min(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4_clamp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API mfloat_t *vec4_normalize(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec4_normalize_fast(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t vec4_dot(mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *vec4_lerp(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t f);
+MATHC_API mfloat_t *vec4_bilinear(mfloat_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, mfloat_t *v3, mfloat_t u, mfloat_t v);
+MATHC_API bool quat_is_zero(mfloat_t *q0);
+MATHC_API bool quat_is_equal(mfloat_t *q0, mfloat_t *q1);
+MATHC_API mfloat_t *quat(mfloat_t *result, mfloat_t x, mfloat_t y, mfloat_t z, mfloat_t w);
+MATHC_API mfloat_t *quat_assign(mfloat_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *quat_zero(mfloat_t *result);
+MATHC_API mfloat_t *quat_null(mfloat_t *result);
+MATHC_API mfloat_t *quat_multiply(mfloat_t *result, mfloat_t *q0, mfloat_t *q1);
+MATHC_API mfloat_t *quat_multiply_f(mfloat_t *result, mfloat_t *q0, mfloat_t f);
+MATHC_API mfloat_t *quat_divide(mfloat_t *result, mfloat_t *q0, mfloat_t *q1);
+MATHC_API mfloat_t *quat_divide_f(mfloat_t *result, mfloat_t *q0, mfloat_t f);
+MATHC_API mfloat_t *quat_negative(mfloat_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *quat_conjugate(mfloat_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *quat_inverse(mfloat_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *quat_normalize(mfloat_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *quat_normalize_fast(mfloat_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *quat_normalize_n_fast(mfloat_t *result, mfloat_t *q0, size_t count);
+MATHC_API mfloat_t quat_dot(mfloat_t *q0, mfloat_t *q1);
+MATHC_API mfloat_t *quat_power(mfloat_t *result, mfloat_t *q0, mfloat_t exponent);
+MATHC_API mfloat_t *quat_from_axis_angle(mfloat_t *result, mfloat_t *v0, mfloat_t angle);
+MATHC_API mfloat_t *quat_from_vec3(mfloat_t *result, mfloat_t *v0, mfloat_t *v1);
+MATHC_API mfloat_t *quat_from_mat4(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *quat_lerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f);
+MATHC_API mfloat_t *quat_slerp(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f);
+MATHC_API mfloat_t *quat_slerp_n(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f, size_t count);
+MATHC_API mfloat_t *quat_slerp_n_fast(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f, size_t count);
+MATHC_API mfloat_t *quat_nlerp_n(mfloat_t *result, mfloat_t *q0, mfloat_t *q1, mfloat_t f, size_t count);
+MATHC_API mfloat_t quat_length(mfloat_t *q0);
+MATHC_API mfloat_t quat_length_squared(mfloat_t *q0);
+MATHC_API mfloat_t quat_angle(mfloat_t *q0, mfloat_t *q1);
+MATHC_API mfloat_t *trs(mfloat_t *result, mfloat_t *v0, mfloat_t *q0, mfloat_t *v1);
+MATHC_API mfloat_t *trs_identity(mfloat_t *result);
+MATHC_API mfloat_t *trs_assign(mfloat_t *result, mfloat_t *t0);
+MATHC_API mfloat_t *trs_multiply(mfloat_t *result, mfloat_t *t0, mfloat_t *t1);
+MATHC_API mfloat_t *trs_inverse(mfloat_t *result, mfloat_t *t0);
+MATHC_API mfloat_t *trs_lerp(mfloat_t *result, mfloat_t *t0, mfloat_t *t1, mfloat_t f);
+MATHC_API mfloat_t *trs_transform_point(mfloat_t *result, mfloat_t *v0, mfloat_t *t0);
+MATHC_API mfloat_t *mat2(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m21, mfloat_t m22);
+MATHC_API mfloat_t *mat2_zero(mfloat_t *result);
+MATHC_API mfloat_t *mat2_identity(mfloat_t *result);
+MATHC_API mfloat_t mat2_determinant(mfloat_t *m0);
+MATHC_API mfloat_t *mat2_assign(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat2_negative(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat2_transpose(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat2_transpose_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0);
+MATHC_API mfloat_t *mat2_cofactor(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat2_adjugate(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat2_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
+MATHC_API mfloat_t *mat2_multiply_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0, mfloat_t *MATHC_RESTRICT m1);
+MATHC_API mfloat_t *mat2_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f);
+MATHC_API mfloat_t *mat2_inverse(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat2_scaling(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *mat2_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
+MATHC_API mfloat_t *mat2_rotation_z(mfloat_t *result, mfloat_t f);
+MATHC_API mfloat_t *mat2_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f);
+MATHC_API mfloat_t *mat3(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m31, mfloat_t m32, mfloat_t m33);
+MATHC_API mfloat_t *mat3_zero(mfloat_t *result);
+MATHC_API mfloat_t *mat3_identity(mfloat_t *result);
+MATHC_API mfloat_t mat3_determinant(mfloat_t *m0);
+MATHC_API mfloat_t *mat3_assign(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat3_negative(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat3_transpose(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat3_transpose_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0);
+MATHC_API mfloat_t *mat3_cofactor(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat3_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
+MATHC_API mfloat_t *mat3_multiply_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0, mfloat_t *MATHC_RESTRICT m1);
+MATHC_API mfloat_t *mat3_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f);
+MATHC_API mfloat_t *mat3_inverse(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat3_scaling(mfloat_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *mat3_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
+MATHC_API mfloat_t *mat3_rotation_x(mfloat_t *result, mfloat_t f);
+MATHC_API mfloat_t *mat3_rotation_y(mfloat_t *result, mfloat_t f);
+MATHC_API mfloat_t *mat3_rotation_z(mfloat_t *result, mfloat_t f);
+MATHC_API mfloat_t *mat3_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *mat3_rotation_quat(mfloat_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *mat3_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f);
+MATHC_API mfloat_t *mat3_to_std140(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat3_from_std140(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat3_to_std140_n(mfloat_t *result, mfloat_t *m0, size_t count, size_t stride);
+MATHC_API mfloat_t *mat4(mfloat_t *result, mfloat_t m11, mfloat_t m12, mfloat_t m13, mfloat_t m14, mfloat_t m21, mfloat_t m22, mfloat_t m23, mfloat_t m24, mfloat_t m31, mfloat_t m32, mfloat_t m33, mfloat_t m34, mfloat_t m41, mfloat_t m42, mfloat_t m43, mfloat_t m44);
+MATHC_API mfloat_t *mat4_zero(mfloat_t *result);
+MATHC_API mfloat_t *mat4_identity(mfloat_t *result);
+MATHC_API mfloat_t mat4_determinant(mfloat_t *m0);
+MATHC_API mfloat_t *mat4_assign(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_negative(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_transpose(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_transpose_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0);
+MATHC_API mfloat_t *mat4_cofactor(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_rotation_x(mfloat_t *result, mfloat_t f);
+MATHC_API mfloat_t *mat4_rotation_y(mfloat_t *result, mfloat_t f);
+MATHC_API mfloat_t *mat4_rotation_z(mfloat_t *result, mfloat_t f);
+MATHC_API mfloat_t *mat4_rotation_axis(mfloat_t *result, mfloat_t *v0, mfloat_t f);
+MATHC_API mfloat_t *mat4_rotation_quat(mfloat_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *mat4_from_trs(mfloat_t *result, mfloat_t *t0);
+MATHC_API mfloat_t *mat4_translation(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
+MATHC_API mfloat_t *mat4_translate(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
+MATHC_API mfloat_t *mat4_scaling(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
+MATHC_API mfloat_t *mat4_scale(mfloat_t *result, mfloat_t *m0, mfloat_t *v0);
+MATHC_API mfloat_t *mat4_multiply(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
+MATHC_API mfloat_t *mat4_multiply_nr(mfloat_t *MATHC_RESTRICT result, mfloat_t *MATHC_RESTRICT m0, mfloat_t *MATHC_RESTRICT m1);
+MATHC_API mfloat_t *mat4_multiply_affine(mfloat_t *result, mfloat_t *m0, mfloat_t *m1);
+MATHC_API mfloat_t *mat4_multiply_n(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, size_t count);
+MATHC_API mfloat_t *mat4_multiply_n_left(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, size_t count);
+MATHC_API mfloat_t *mat4_multiply_n_right(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, size_t count);
+MATHC_API mfloat_t **mat4_multiply_soa(mfloat_t *result[MAT4_SIZE], mfloat_t *m0[MAT4_SIZE], mfloat_t *m1[MAT4_SIZE], size_t count);
+MATHC_API mfloat_t *mat4_transform_points(mfloat_t *result, mfloat_t *v0, size_t count, size_t stride, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_transform_directions(mfloat_t *result, mfloat_t *v0, size_t count, size_t stride, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_multiply_f(mfloat_t *result, mfloat_t *m0, mfloat_t f);
+MATHC_API mfloat_t *mat4_inverse(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_inverse_affine(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_inverse_rigid(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *mat4_lerp(mfloat_t *result, mfloat_t *m0, mfloat_t *m1, mfloat_t f);
+MATHC_API mfloat_t *mat4_look_at(mfloat_t *result, mfloat_t *position, mfloat_t *target, mfloat_t *up);
+MATHC_API mfloat_t *mat4_ortho(mfloat_t *result, mfloat_t l, mfloat_t r, mfloat_t b, mfloat_t t, mfloat_t n, mfloat_t f);
+MATHC_API mfloat_t *mat4_perspective(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n, mfloat_t f);
+MATHC_API mfloat_t *mat4_perspective_fov(mfloat_t *result, mfloat_t fov, mfloat_t w, mfloat_t h, mfloat_t n, mfloat_t f);
+MATHC_API mfloat_t *mat4_perspective_infinite(mfloat_t *result, mfloat_t fov_y, mfloat_t aspect, mfloat_t n);
+MATHC_API struct mat4_hierarchy *mat4_hierarchy_set_local(struct mat4_hierarchy *result, size_t index, mfloat_t *m0);
+MATHC_API struct mat4_hierarchy *mat4_hierarchy_update(struct mat4_hierarchy *result);
+MATHC_API mfloat_t *frustum_from_mat4(mfloat_t *result, mfloat_t *m0);
+MATHC_API bool frustum_intersects_sphere(mfloat_t *f0, mfloat_t *v0, mfloat_t r);
+MATHC_API bool frustum_intersects_aabb(mfloat_t *f0, mfloat_t *v0, mfloat_t *v1);
+MATHC_API uint32_t *frustum_intersects_sphere_n(uint32_t *result, mfloat_t *f0, mfloat_t *v0, size_t count);
+MATHC_API uint32_t *frustum_intersects_aabb_n(uint32_t *result, mfloat_t *f0, mfloat_t *v0, mfloat_t *v1, size_t count);
+MATHC_API uint32_t *frustum_intersects_sphere_stream(uint32_t *result, mfloat_t *f0, struct vec3_stream *v0, mfloat_t *radius);
+MATHC_API uint32_t *frustum_intersects_aabb_stream(uint32_t *result, mfloat_t *f0, struct vec3_stream *v0, struct vec3_stream *v1);
+MATHC_API bool ray_intersect_triangle(mfloat_t *result, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API bool ray_intersect_aabb(mfloat_t *result, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0, mfloat_t *v1);
+MATHC_API bool ray_intersect_sphere(mfloat_t *result, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0, mfloat_t r);
+MATHC_API bool ray_intersect_plane(mfloat_t *result, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0);
+MATHC_API uint32_t ray_intersect_triangle_packet(mfloat_t *result, struct vec3_stream *origins, struct vec3_stream *directions, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API uint32_t ray_intersect_aabb_packet(mfloat_t *result, struct vec3_stream *origins, struct vec3_stream *directions, mfloat_t *v0, mfloat_t *v1);
+MATHC_API uint32_t ray_intersect_sphere_packet(mfloat_t *result, struct vec3_stream *origins, struct vec3_stream *directions, mfloat_t *v0, mfloat_t r);
+MATHC_API uint32_t ray_intersect_plane_packet(mfloat_t *result, struct vec3_stream *origins, struct vec3_stream *directions, mfloat_t *v0);
+MATHC_API struct bvh *bvh_build(struct bvh *result, mfloat_t *v0, mfloat_t *v1, size_t count);
+MATHC_API struct bvh *bvh_build_triangles(struct bvh *result, mfloat_t *v0, size_t count);
+MATHC_API int bvh_intersect_ray(mfloat_t *result, struct bvh *b0, mfloat_t *origin, mfloat_t *direction, bool (*func)(void *data, int index, mfloat_t *result, mfloat_t *origin, mfloat_t *direction), void *data);
+MATHC_API int bvh_intersect_ray_triangles(mfloat_t *result, struct bvh *b0, mfloat_t *origin, mfloat_t *direction, mfloat_t *v0);
+MATHC_API size_t bvh_query_frustum(struct bvh *b0, mfloat_t *f0, void (*func)(void *data, int index), void *data);
+MATHC_API struct aligned_buffer *aligned_buffer(struct aligned_buffer *result, void *memory, size_t size, size_t alignment, size_t stride);
+MATHC_API mfloat_t *aligned_buffer_at(struct aligned_buffer *b0, size_t index);
+MATHC_API size_t aligned_buffer_size(struct aligned_buffer *b0, size_t count);
+MATHC_API mfloat_t *mat4_skin_points(mfloat_t *result, mfloat_t *v0, size_t count, size_t stride, int *bones, mfloat_t *weights, mfloat_t *m0);
+MATHC_API struct vec3_stream *mat4_skin_stream(struct vec3_stream *result, struct vec3_stream *v0, int *bones, mfloat_t *weights, mfloat_t *m0);
+MATHC_API mfloat_t *dualquat_from_quat_vec3(mfloat_t *result, mfloat_t *q0, mfloat_t *v0);
+MATHC_API mfloat_t *dualquat_from_mat4(mfloat_t *result, mfloat_t *m0);
+MATHC_API mfloat_t *dualquat_skin_points(mfloat_t *result, mfloat_t *v0, size_t count, size_t stride, int *bones, mfloat_t *weights, mfloat_t *d0);
+MATHC_API struct vec3_stream *dualquat_skin_stream(struct vec3_stream *result, struct vec3_stream *v0, int *bones, mfloat_t *weights, mfloat_t *d0);
+MATHC_API mfloat_t *animation_track_sample(mfloat_t *result, struct animation_track *t0, mfloat_t time);
+MATHC_API mfloat_t *animation_track_sample_n(mfloat_t *result, struct animation_track *t0, size_t count, mfloat_t time);
+MATHC_API uint32_t *quat_encode_32(uint32_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *quat_decode_32(mfloat_t *result, uint32_t *v0);
+MATHC_API uint32_t *quat_encode_32_n(uint32_t *result, mfloat_t *q0, size_t count);
+MATHC_API mfloat_t *quat_decode_32_n(mfloat_t *result, uint32_t *v0, size_t count);
+MATHC_API uint16_t *quat_encode_48(uint16_t *result, mfloat_t *q0);
+MATHC_API mfloat_t *quat_decode_48(mfloat_t *result, uint16_t *v0);
+MATHC_API uint16_t *quat_encode_48_n(uint16_t *result, mfloat_t *q0, size_t count);
+MATHC_API mfloat_t *quat_decode_48_n(mfloat_t *result, uint16_t *v0, size_t count);
+MATHC_API mhalf_t *vec3_encode_half(mhalf_t *result, mfloat_t *v0);
+MATHC_API mfloat_t *vec3_decode_half(mfloat_t *result, mhalf_t *v0);
+MATHC_API mhalf_t *vec3_encode_half_n(mhalf_t *result, mfloat_t *v0, size_t count);
+MATHC_API mfloat_t *vec3_decode_half_n(mfloat_t *result, mhalf_t *v0, size_t count);
+MATHC_API uint16_t *vec3_encode_range(uint16_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API mfloat_t *vec3_decode_range(mfloat_t *result, uint16_t *v0, mfloat_t *v1, mfloat_t *v2);
+MATHC_API uint16_t *vec3_encode_range_n(uint16_t *result, mfloat_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count);
+MATHC_API mfloat_t *vec3_decode_range_n(mfloat_t *result, uint16_t *v0, mfloat_t *v1, mfloat_t *v2, size_t count);
+MATHC_API mhalf_t *half_encode_n(mhalf_t *result, mfloat_t *v0, size_t count);
+MATHC_API mfloat_t *half_decode_n(mfloat_t *result, mhalf_t *v0, size_t count);
+MATHC_API mbfloat16_t *bfloat16_encode_n(mbfloat16_t *result, mfloat_t *v0, size_t count);
+MATHC_API mfloat_t *bfloat16_decode_n(mfloat_t *result, mbfloat16_t *v0, size_t count);
+MATHC_API mfloat_t *mat4_transform_points_half(mfloat_t *result, mhalf_t *v0, size_t count, size_t stride, mfloat_t *m0);
 #endif
 
 #if defined(MATHC_USE_FLOATING_POINT) && defined(MATHC_USE_EASING_FUNCTIONS)
-mfloat_t quadratic_ease_out(mfloat_t f);
-mfloat_t quadratic_ease_in(mfloat_t f);
-mfloat_t quadratic_ease_in_out(mfloat_t f);
-mfloat_t cubic_ease_out(mfloat_t f);
-mfloat_t cubic_ease_in(mfloat_t f);
-mfloat_t cubic_ease_in_out(mfloat_t f);
-mfloat_t quartic_ease_out(mfloat_t f);
-mfloat_t quartic_ease_in(mfloat_t f);
-mfloat_t quartic_ease_in_out(mfloat_t f);
-mfloat_t quintic_ease_out(mfloat_t f);
-mfloat_t quintic_ease_in(mfloat_t f);
-mfloat_t quintic_ease_in_out(mfloat_t f);
-mfloat_t sine_ease_out(mfloat_t f);
-mfloat_t sine_ease_in(mfloat_t f);
-mfloat_t sine_ease_in_out(mfloat_t f);
-mfloat_t circular_ease_out(mfloat_t f);
-mfloat_t circular_ease_in(mfloat_t f);
-mfloat_t circular_ease_in_out(mfloat_t f);
-mfloat_t exponential_ease_out(mfloat_t f);
-mfloat_t exponential_ease_in(mfloat_t f);
-mfloat_t exponential_ease_in_out(mfloat_t f);
-mfloat_t elastic_ease_out(mfloat_t f);
-mfloat_t elastic_ease_in(mfloat_t f);
-mfloat_t elastic_ease_in_out(mfloat_t f);
-mfloat_t back_ease_out(mfloat_t f);
-mfloat_t back_ease_in(mfloat_t f);
-mfloat_t back_ease_in_out(mfloat_t f);
-mfloat_t bounce_ease_out(mfloat_t f);
-mfloat_t bounce_ease_in(mfloat_t f);
-mfloat_t bounce_ease_in_out(mfloat_t f);
+/* Samples of an easing function at count (3 or more) evenly spaced values
+ * from 0.0 to 1.0, read back with linear or cubic interpolation. values
+ * needs room for count + 2 samples, one past each end */
+struct ease_table {
+	mfloat_t *values;
+	size_t count;
+	bool cubic;
+};
+
+MATHC_API mfloat_t quadratic_ease_out(mfloat_t f);
+MATHC_API mfloat_t *quadratic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t quadratic_ease_in(mfloat_t f);
+MATHC_API mfloat_t *quadratic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t quadratic_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *quadratic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t cubic_ease_out(mfloat_t f);
+MATHC_API mfloat_t *cubic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t cubic_ease_in(mfloat_t f);
+MATHC_API mfloat_t *cubic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t cubic_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *cubic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t quartic_ease_out(mfloat_t f);
+MATHC_API mfloat_t *quartic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t quartic_ease_in(mfloat_t f);
+MATHC_API mfloat_t *quartic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t quartic_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *quartic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t quintic_ease_out(mfloat_t f);
+MATHC_API mfloat_t *quintic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t quintic_ease_in(mfloat_t f);
+MATHC_API mfloat_t *quintic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t quintic_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *quintic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t sine_ease_out(mfloat_t f);
+MATHC_API mfloat_t *sine_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t sine_ease_in(mfloat_t f);
+MATHC_API mfloat_t *sine_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t sine_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *sine_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t circular_ease_out(mfloat_t f);
+MATHC_API mfloat_t *circular_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t circular_ease_in(mfloat_t f);
+MATHC_API mfloat_t *circular_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t circular_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *circular_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t exponential_ease_out(mfloat_t f);
+MATHC_API mfloat_t *exponential_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t exponential_ease_in(mfloat_t f);
+MATHC_API mfloat_t *exponential_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t exponential_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *exponential_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t elastic_ease_out(mfloat_t f);
+MATHC_API mfloat_t *elastic_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t elastic_ease_in(mfloat_t f);
+MATHC_API mfloat_t *elastic_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t elastic_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *elastic_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t back_ease_out(mfloat_t f);
+MATHC_API mfloat_t *back_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t back_ease_in(mfloat_t f);
+MATHC_API mfloat_t *back_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t back_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *back_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t bounce_ease_out(mfloat_t f);
+MATHC_API mfloat_t *bounce_ease_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t bounce_ease_in(mfloat_t f);
+MATHC_API mfloat_t *bounce_ease_in_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API mfloat_t bounce_ease_in_out(mfloat_t f);
+MATHC_API mfloat_t *bounce_ease_in_out_n(mfloat_t *result, mfloat_t *f, size_t count);
+MATHC_API struct ease_table *ease_table(struct ease_table *result, mfloat_t (*func)(mfloat_t f), mfloat_t *values, size_t count, bool cubic);
+MATHC_API mfloat_t ease_table_sample(struct ease_table *t0, mfloat_t f);
+MATHC_API mfloat_t *ease_table_sample_n(mfloat_t *result, struct ease_table *t0, mfloat_t *f, size_t count);
+#endif
+
+#if defined(MATHC_INLINE) || defined(MATHC_IMPLEMENTATION)
+#include "mathc.c"
 #endif
 
 #endif
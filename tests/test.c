@@ -0,0 +1,2727 @@
+/*
+Copyright (c) 2025 Joshua Skelton
+
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not claim
+     that you wrote the original software. If you use this software in a
+     product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "../mathc.h"
+
+#if !defined(MATHC_USE_FLOATING_POINT)
+#error "The tests require mfloat_t"
+#endif
+
+/* Number of random inputs checked by each case */
+#define TEST_SAMPLES 10000
+/* Filler for the elements past the end of an argument and for results
+ * that are overwritten, so that stray reads and writes show up as errors */
+#define TEST_GARBAGE MFLOAT_C(1000.0)
+
+#if defined(MATHC_USE_DOUBLE_FLOATING_POINT)
+#define TEST_MANT_DIG DBL_MANT_DIG
+#else
+#define TEST_MANT_DIG FLT_MANT_DIG
+#endif
+
+static unsigned int test_seed = 12345;
+static int test_failures = 0;
+
+static const char *test_precision(void)
+{
+#if defined(__SANITIZE_ADDRESS__)
+	return sizeof(mfloat_t) == sizeof(double) ? "double-sanitize" : "float-sanitize";
+#elif defined(MATHC_SSE)
+	return "float-sse";
+#else
+	return sizeof(mfloat_t) == sizeof(double) ? "double" : "float";
+#endif
+}
+
+static long double test_random(long double low, long double high)
+{
+	test_seed = test_seed * 1103515245u + 12345u;
+	return low + (high - low) * (long double)((test_seed >> 8) & 0xffffu) / 65535.0L;
+}
+
+/* Largest error of the components of computed, in units in the last place
+ * of mfloat_t at the largest component of the reference (or at magnitude,
+ * whichever is larger). Measuring every component against the same scale
+ * keeps components that should be zero from reporting unbounded errors */
+static long double test_ulp(mfloat_t *computed, long double *reference, int n, long double magnitude)
+{
+	long double error = 0.0L;
+	int exponent;
+	int i;
+	for (i = 0; i < n; i++) {
+		long double difference = fabsl((long double)computed[i] - reference[i]);
+		if (fabsl(reference[i]) > magnitude) {
+			magnitude = fabsl(reference[i]);
+		}
+		/* Written so that a NaN result is kept as the error */
+		if (!(difference <= error)) {
+			error = difference;
+		}
+	}
+	frexpl(magnitude, &exponent);
+	return error / ldexpl(1.0L, exponent - TEST_MANT_DIG);
+}
+
+static long double test_max(long double max_ulp, long double ulp)
+{
+	return (ulp > max_ulp || ulp != ulp) ? ulp : max_ulp;
+}
+
+static void test_report(const char *name, long double max_ulp, long double limit)
+{
+	bool passed = max_ulp <= limit;
+	if (!passed) {
+		test_failures = test_failures + 1;
+	}
+	printf("%s,%s,%.2Lf,%.0Lf,%s\n", name, test_precision(), max_ulp, limit, passed ? "pass" : "FAIL");
+}
+
+static void test_store(mfloat_t *result, long double *values, int n)
+{
+	int i;
+	for (i = 0; i < n; i++) {
+		result[i] = (mfloat_t)values[i];
+	}
+}
+
+static void test_load(long double *result, mfloat_t *values, int n)
+{
+	int i;
+	for (i = 0; i < n; i++) {
+		result[i] = (long double)values[i];
+	}
+}
+
+static void test_random_axis(long double *result)
+{
+	long double length;
+	do {
+		result[0] = test_random(-1.0L, 1.0L);
+		result[1] = test_random(-1.0L, 1.0L);
+		result[2] = test_random(-1.0L, 1.0L);
+		length = sqrtl(result[0] * result[0] + result[1] * result[1] + result[2] * result[2]);
+	} while (length < 0.1L || length > 1.0L);
+	result[0] = result[0] / length;
+	result[1] = result[1] / length;
+	result[2] = result[2] / length;
+}
+
+static void test_random_quat(long double *result)
+{
+	long double angle = test_random(0.0L, 6.2831853071795864769L);
+	test_random_axis(result);
+	result[0] = result[0] * sinl(angle * 0.5L);
+	result[1] = result[1] * sinl(angle * 0.5L);
+	result[2] = result[2] * sinl(angle * 0.5L);
+	result[3] = cosl(angle * 0.5L);
+}
+
+/* Frustum of a perspective camera at a random position, looking at a
+ * random point near the origin */
+/* View-projection matrix of a random camera, with a far plane at infinity
+ * if asked */
+static void test_random_view_projection(mfloat_t *result, bool infinite)
+{
+	mfloat_t view[MAT4_SIZE];
+	mfloat_t position[VEC3_SIZE];
+	mfloat_t target[VEC3_SIZE];
+	mfloat_t up[VEC3_SIZE];
+	mfloat_t fov_y;
+	mfloat_t aspect;
+	int k;
+	for (k = 0; k < VEC3_SIZE; k++) {
+		position[k] = (mfloat_t)test_random(-6.0L, 6.0L);
+		target[k] = (mfloat_t)test_random(-1.0L, 1.0L);
+	}
+	vec3(up, MFLOAT_C(0.0), MFLOAT_C(1.0), MFLOAT_C(0.0));
+	fov_y = (mfloat_t)test_random(0.5L, 1.5L);
+	aspect = (mfloat_t)test_random(1.0L, 2.0L);
+	if (infinite) {
+		mat4_perspective_infinite(result, fov_y, aspect, MFLOAT_C(0.1));
+	} else {
+		mat4_perspective(result, fov_y, aspect, MFLOAT_C(0.1), (mfloat_t)test_random(2.0L, 12.0L));
+	}
+	mat4_look_at(view, position, target, up);
+	mat4_multiply(result, result, view);
+}
+
+static void test_random_frustum(mfloat_t *result)
+{
+	mfloat_t m0[MAT4_SIZE];
+	test_random_view_projection(m0, false);
+	frustum_from_mat4(result, m0);
+}
+
+/* Reference implementations, in long double */
+
+static void ref_quat_multiply(long double *result, long double *q0, long double *q1)
+{
+	result[0] = q0[3] * q1[0] + q0[0] * q1[3] + q0[1] * q1[2] - q0[2] * q1[1];
+	result[1] = q0[3] * q1[1] + q0[1] * q1[3] + q0[2] * q1[0] - q0[0] * q1[2];
+	result[2] = q0[3] * q1[2] + q0[2] * q1[3] + q0[0] * q1[1] - q0[1] * q1[0];
+	result[3] = q0[3] * q1[3] - q0[0] * q1[0] - q0[1] * q1[1] - q0[2] * q1[2];
+}
+
+/* Column-major rotation of angle radians around a unit axis (Rodrigues) */
+static void ref_mat3_rotation_axis(long double *result, long double *axis, long double angle)
+{
+	long double c = cosl(angle);
+	long double s = sinl(angle);
+	long double one_c = 1.0L - c;
+	long double x = axis[0];
+	long double y = axis[1];
+	long double z = axis[2];
+	result[0] = c + x * x * one_c;
+	result[1] = y * x * one_c + z * s;
+	result[2] = z * x * one_c - y * s;
+	result[3] = x * y * one_c - z * s;
+	result[4] = c + y * y * one_c;
+	result[5] = z * y * one_c + x * s;
+	result[6] = x * z * one_c + y * s;
+	result[7] = y * z * one_c - x * s;
+	result[8] = c + z * z * one_c;
+}
+
+static void ref_mat3_rotation_quat(long double *result, long double *q0)
+{
+	long double x = q0[0];
+	long double y = q0[1];
+	long double z = q0[2];
+	long double w = q0[3];
+	result[0] = 1.0L - 2.0L * (y * y + z * z);
+	result[1] = 2.0L * (x * y + z * w);
+	result[2] = 2.0L * (x * z - y * w);
+	result[3] = 2.0L * (x * y - z * w);
+	result[4] = 1.0L - 2.0L * (x * x + z * z);
+	result[5] = 2.0L * (y * z + x * w);
+	result[6] = 2.0L * (x * z + y * w);
+	result[7] = 2.0L * (y * z - x * w);
+	result[8] = 1.0L - 2.0L * (x * x + y * y);
+}
+
+/* Matrix of a translation, rotation and scale stored as in TRS_SIZE */
+static void ref_mat4_from_trs(long double *result, long double *t0)
+{
+	long double rotation[MAT3_SIZE];
+	int column;
+	int row;
+	ref_mat3_rotation_quat(rotation, t0 + 3);
+	for (column = 0; column < 3; column++) {
+		for (row = 0; row < 3; row++) {
+			result[column * 4 + row] = rotation[column * 3 + row] * t0[7 + column];
+		}
+		result[column * 4 + 3] = 0.0L;
+		result[12 + column] = t0[column];
+	}
+	result[15] = 1.0L;
+}
+
+/* Column-major product m0 * m1 */
+static void ref_mat4_multiply(long double *result, long double *m0, long double *m1)
+{
+	int row;
+	int column;
+	for (column = 0; column < 4; column++) {
+		for (row = 0; row < 4; row++) {
+			result[column * 4 + row] = m0[row] * m1[column * 4]
+				+ m0[4 + row] * m1[column * 4 + 1]
+				+ m0[8 + row] * m1[column * 4 + 2]
+				+ m0[12 + row] * m1[column * 4 + 3];
+		}
+	}
+}
+
+/* Gauss-Jordan elimination with partial pivoting */
+static void ref_mat4_inverse(long double *result, long double *m0)
+{
+	long double a[4][8];
+	int row;
+	int column;
+	int k;
+	for (row = 0; row < 4; row++) {
+		for (column = 0; column < 4; column++) {
+			a[row][column] = m0[column * 4 + row];
+			a[row][column + 4] = row == column ? 1.0L : 0.0L;
+		}
+	}
+	for (k = 0; k < 4; k++) {
+		int pivot = k;
+		long double divisor;
+		for (row = k + 1; row < 4; row++) {
+			if (fabsl(a[row][k]) > fabsl(a[pivot][k])) {
+				pivot = row;
+			}
+		}
+		for (column = 0; column < 8; column++) {
+			long double swap = a[k][column];
+			a[k][column] = a[pivot][column];
+			a[pivot][column] = swap;
+		}
+		divisor = a[k][k];
+		for (column = 0; column < 8; column++) {
+			a[k][column] = a[k][column] / divisor;
+		}
+		for (row = 0; row < 4; row++) {
+			long double factor = a[row][k];
+			if (row == k) {
+				continue;
+			}
+			for (column = 0; column < 8; column++) {
+				a[row][column] = a[row][column] - factor * a[k][column];
+			}
+		}
+	}
+	for (row = 0; row < 4; row++) {
+		for (column = 0; column < 4; column++) {
+			result[column * 4 + row] = a[row][column + 4];
+		}
+	}
+}
+
+/* Value of a keyframe track at a time, with the key found by a linear
+ * search. Sets key to the key before the time, or to count when the time
+ * is clamped to the first or the last key */
+static void ref_animation_track_sample(long double *result, struct animation_track *t0, mfloat_t time, size_t *key)
+{
+	size_t stride = (size_t)t0->size * (t0->interpolation == ANIMATION_CUBIC ? 3 : 1);
+	size_t offset = t0->interpolation == ANIMATION_CUBIC ? (size_t)t0->size : 0;
+	long double f;
+	long double g;
+	mfloat_t *v0;
+	mfloat_t *v1;
+	size_t k;
+	int i;
+	*key = t0->count;
+	if (t0->count < 2 || time <= t0->times[0] || time >= t0->times[t0->count - 1]) {
+		v0 = t0->values + (t0->count < 2 || time <= t0->times[0] ? 0 : (t0->count - 1) * stride) + offset;
+		test_load(result, v0, t0->size);
+		return;
+	}
+	for (k = 0; k + 1 < t0->count && t0->times[k + 1] <= time; k++) {
+	}
+	*key = k;
+	f = ((long double)time - (long double)t0->times[k]) / ((long double)t0->times[k + 1] - (long double)t0->times[k]);
+	g = 1.0L - f;
+	v0 = t0->values + k * stride;
+	v1 = v0 + stride;
+	if (t0->interpolation == ANIMATION_STEP) {
+		test_load(result, v0, t0->size);
+	} else if (t0->interpolation == ANIMATION_SLERP) {
+		long double d = 0.0L;
+		long double sign = 1.0L;
+		long double f0 = g;
+		long double f1 = f;
+		for (i = 0; i < QUAT_SIZE; i++) {
+			d = d + (long double)v0[i] * (long double)v1[i];
+		}
+		if (d < 0.0L) {
+			sign = -1.0L;
+			d = -d;
+		}
+		/* quat_slerp() interpolates linearly between close quaternions */
+		if (d <= 0.9995L) {
+			long double theta = acosl(d);
+			f0 = sinl(g * theta) / sinl(theta);
+			f1 = sinl(f * theta) / sinl(theta);
+		}
+		for (i = 0; i < QUAT_SIZE; i++) {
+			result[i] = (long double)v0[i] * f0 + sign * (long double)v1[i] * f1;
+		}
+	} else if (t0->interpolation == ANIMATION_CUBIC) {
+		for (i = 0; i < t0->size; i++) {
+			result[i] = (long double)v0[t0->size + i] * g * g * g
+				+ 3.0L * (long double)v0[t0->size * 2 + i] * g * g * f
+				+ 3.0L * (long double)v1[i] * g * f * f
+				+ (long double)v1[t0->size + i] * f * f * f;
+		}
+	} else {
+		for (i = 0; i < t0->size; i++) {
+			result[i] = (long double)v0[i] * g + (long double)v1[i] * f;
+		}
+	}
+}
+
+/* Test cases */
+
+static void test_mat4_inverse(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t m0[MAT4_SIZE];
+		mfloat_t result[MAT4_SIZE];
+		long double input[MAT4_SIZE];
+		long double reference[MAT4_SIZE];
+		/* Well-conditioned general matrices, with a dominant diagonal */
+		for (k = 0; k < MAT4_SIZE; k++) {
+			input[k] = test_random(-1.0L, 1.0L) + (k % 5 == 0 ? 4.0L : 0.0L);
+		}
+		test_store(m0, input, MAT4_SIZE);
+		test_load(input, m0, MAT4_SIZE);
+		ref_mat4_inverse(reference, input);
+		mat4_inverse(result, m0);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, MAT4_SIZE, 0.0L));
+	}
+	test_report("mat4_inverse", max_ulp, 16.0L);
+}
+
+/* Affine matrices with a well-conditioned upper-left 3x3 and rigid ones
+ * against the general inverse, and affine products against the general
+ * product, in place on either operand */
+static void test_mat4_affine(void)
+{
+	long double max_ulp[3] = {0.0L, 0.0L, 0.0L};
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t m0[MAT4_SIZE];
+		mfloat_t m1[MAT4_SIZE];
+		mfloat_t rotation[QUAT_SIZE];
+		mfloat_t result[MAT4_SIZE];
+		long double q[QUAT_SIZE];
+		long double a[MAT4_SIZE];
+		long double b[MAT4_SIZE];
+		long double reference[MAT4_SIZE];
+		for (k = 0; k < MAT4_SIZE; k++) {
+			a[k] = k % 4 == 3 ? 0.0L : test_random(-1.0L, 1.0L) + (k % 5 == 0 ? 4.0L : 0.0L);
+			b[k] = k % 4 == 3 ? 0.0L : test_random(-2.0L, 2.0L);
+		}
+		a[15] = 1.0L;
+		b[15] = 1.0L;
+		test_store(m0, a, MAT4_SIZE);
+		test_store(m1, b, MAT4_SIZE);
+		ref_mat4_inverse(reference, a);
+		mat4_inverse_affine(result, m0);
+		max_ulp[0] = test_max(max_ulp[0], test_ulp(result, reference, MAT4_SIZE, 0.0L));
+		ref_mat4_multiply(reference, a, b);
+		mat4_multiply_affine(result, m0, m1);
+		max_ulp[2] = test_max(max_ulp[2], test_ulp(result, reference, MAT4_SIZE, 1.0L));
+		mat4_assign(result, m0);
+		mat4_multiply_affine(result, result, m1);
+		max_ulp[2] = test_max(max_ulp[2], test_ulp(result, reference, MAT4_SIZE, 1.0L));
+		mat4_assign(result, m1);
+		mat4_multiply_affine(result, m0, result);
+		max_ulp[2] = test_max(max_ulp[2], test_ulp(result, reference, MAT4_SIZE, 1.0L));
+		/* The rigid inverse is exact for the rounded rotation only up to
+		 * its distance from orthonormal, a few units in the last place */
+		test_random_quat(q);
+		test_store(rotation, q, QUAT_SIZE);
+		mat4_rotation_quat(m0, rotation);
+		for (k = 12; k < 15; k++) {
+			m0[k] = (mfloat_t)test_random(-4.0L, 4.0L);
+		}
+		test_load(a, m0, MAT4_SIZE);
+		ref_mat4_inverse(reference, a);
+		mat4_inverse_rigid(result, m0);
+		max_ulp[1] = test_max(max_ulp[1], test_ulp(result, reference, MAT4_SIZE, 1.0L));
+		mat4_inverse_rigid(m0, m0);
+		max_ulp[1] = test_max(max_ulp[1], test_ulp(m0, reference, MAT4_SIZE, 1.0L));
+	}
+	test_report("mat4_inverse_affine", max_ulp[0], 16.0L);
+	test_report("mat4_inverse_rigid", max_ulp[1], 16.0L);
+	test_report("mat4_multiply_affine", max_ulp[2], 8.0L);
+}
+
+/* The batched products, with the shared operand of the _left and _right
+ * forms taken from the array that is overwritten in place */
+static void test_mat4_multiply_n(void)
+{
+	long double max_ulp[3] = {0.0L, 0.0L, 0.0L};
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES / 4; i++) {
+		mfloat_t m0[4 * MAT4_SIZE];
+		mfloat_t m1[4 * MAT4_SIZE];
+		mfloat_t result[4 * MAT4_SIZE];
+		long double a[4 * MAT4_SIZE];
+		long double b[4 * MAT4_SIZE];
+		long double reference[4 * MAT4_SIZE];
+		for (k = 0; k < 4 * MAT4_SIZE; k++) {
+			a[k] = test_random(-1.0L, 1.0L);
+			b[k] = test_random(-1.0L, 1.0L);
+		}
+		test_store(m0, a, 4 * MAT4_SIZE);
+		test_store(m1, b, 4 * MAT4_SIZE);
+		test_load(a, m0, 4 * MAT4_SIZE);
+		test_load(b, m1, 4 * MAT4_SIZE);
+		for (k = 0; k < 4; k++) {
+			ref_mat4_multiply(reference + k * MAT4_SIZE, a + k * MAT4_SIZE, b + k * MAT4_SIZE);
+		}
+		mat4_multiply_n(result, m0, m1, 4);
+		max_ulp[0] = test_max(max_ulp[0], test_ulp(result, reference, 4 * MAT4_SIZE, 1.0L));
+		/* In place, with the result aliasing m1 */
+		mat4_multiply_n(m1, m0, m1, 4);
+		max_ulp[0] = test_max(max_ulp[0], test_ulp(m1, reference, 4 * MAT4_SIZE, 1.0L));
+		/* m0[2] * every m1, in place over m0 */
+		test_store(m1, b, 4 * MAT4_SIZE);
+		for (k = 0; k < 4; k++) {
+			ref_mat4_multiply(reference + k * MAT4_SIZE, a + 2 * MAT4_SIZE, b + k * MAT4_SIZE);
+		}
+		mat4_multiply_n_left(m0, m0 + 2 * MAT4_SIZE, m1, 4);
+		max_ulp[1] = test_max(max_ulp[1], test_ulp(m0, reference, 4 * MAT4_SIZE, 1.0L));
+		/* Every m0 * m1[1], in place over m1 */
+		test_store(m0, a, 4 * MAT4_SIZE);
+		for (k = 0; k < 4; k++) {
+			ref_mat4_multiply(reference + k * MAT4_SIZE, a + k * MAT4_SIZE, b + MAT4_SIZE);
+		}
+		mat4_multiply_n_right(m1, m0, m1 + MAT4_SIZE, 4);
+		max_ulp[2] = test_max(max_ulp[2], test_ulp(m1, reference, 4 * MAT4_SIZE, 1.0L));
+	}
+	test_report("mat4_multiply_n", max_ulp[0], 8.0L);
+	test_report("mat4_multiply_n_left", max_ulp[1], 8.0L);
+	test_report("mat4_multiply_n_right", max_ulp[2], 8.0L);
+}
+
+static void test_mat2_inverse(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t m0[MAT2_SIZE];
+		mfloat_t result[MAT2_SIZE];
+		long double m[MAT2_SIZE];
+		long double reference[MAT2_SIZE];
+		long double det;
+		/* Not symmetric, so that the cofactor matrix is not the adjugate */
+		m[0] = test_random(2.0L, 3.0L);
+		m[1] = test_random(-1.0L, 1.0L);
+		m[2] = test_random(-1.0L, 1.0L) + 1.5L;
+		m[3] = test_random(2.0L, 3.0L);
+		test_store(m0, m, MAT2_SIZE);
+		test_load(m, m0, MAT2_SIZE);
+		det = m[0] * m[3] - m[2] * m[1];
+		reference[0] = m[3] / det;
+		reference[1] = -m[1] / det;
+		reference[2] = -m[2] / det;
+		reference[3] = m[0] / det;
+		mat2_inverse(result, m0);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, MAT2_SIZE, 0.0L));
+	}
+	test_report("mat2_inverse", max_ulp, 8.0L);
+}
+
+static void test_mat3_rotation_axis(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t v0[VEC3_SIZE];
+		mfloat_t result[MAT3_SIZE];
+		long double axis[VEC3_SIZE];
+		long double reference[MAT3_SIZE];
+		long double angle = test_random(-6.2831853071795864769L, 6.2831853071795864769L);
+		long double length;
+		/* The axis does not have to be unit length */
+		test_random_axis(axis);
+		length = test_random(0.5L, 2.0L);
+		v0[0] = (mfloat_t)(axis[0] * length);
+		v0[1] = (mfloat_t)(axis[1] * length);
+		v0[2] = (mfloat_t)(axis[2] * length);
+		test_load(axis, v0, VEC3_SIZE);
+		length = sqrtl(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+		axis[0] = axis[0] / length;
+		axis[1] = axis[1] / length;
+		axis[2] = axis[2] / length;
+		ref_mat3_rotation_axis(reference, axis, (long double)(mfloat_t)angle);
+		mat3_rotation_axis(result, v0, (mfloat_t)angle);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, MAT3_SIZE, 1.0L));
+	}
+	test_report("mat3_rotation_axis", max_ulp, 8.0L);
+}
+
+static void test_mat3_rotation_quat(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		/* Padded, so that reading past q0[3] gives a wrong result */
+		mfloat_t q0[12];
+		mfloat_t result[MAT3_SIZE];
+		long double q[QUAT_SIZE];
+		long double reference[MAT3_SIZE];
+		for (k = 0; k < 12; k++) {
+			q0[k] = TEST_GARBAGE;
+		}
+		test_random_quat(q);
+		test_store(q0, q, QUAT_SIZE);
+		test_load(q, q0, QUAT_SIZE);
+		ref_mat3_rotation_quat(reference, q);
+		mat3_rotation_quat(result, q0);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, MAT3_SIZE, 1.0L));
+	}
+	test_report("mat3_rotation_quat", max_ulp, 8.0L);
+}
+
+static void test_mat4_perspective(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t result[MAT4_SIZE];
+		long double reference[MAT4_SIZE];
+		mfloat_t fov_y = (mfloat_t)test_random(0.2L, 2.5L);
+		mfloat_t aspect = (mfloat_t)test_random(0.5L, 2.0L);
+		mfloat_t n = (mfloat_t)test_random(0.01L, 1.0L);
+		mfloat_t f = (mfloat_t)test_random(10.0L, 1000.0L);
+		long double scale_y = 1.0L / tanl((long double)fov_y * 0.5L);
+		for (k = 0; k < MAT4_SIZE; k++) {
+			reference[k] = 0.0L;
+		}
+		reference[0] = scale_y / (long double)aspect;
+		reference[5] = scale_y;
+		reference[10] = (long double)f / ((long double)n - (long double)f);
+		reference[11] = -1.0L;
+		reference[14] = -((long double)f * (long double)n) / ((long double)f - (long double)n);
+		mat4_perspective(result, fov_y, aspect, n, f);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, MAT4_SIZE, 0.0L));
+	}
+	test_report("mat4_perspective", max_ulp, 8.0L);
+}
+
+static void test_mathc_sincos(void)
+{
+	long double max_ulp[3] = {0.0L, 0.0L, 0.0L};
+	/* The absolute error documented for MATHC_FAST_ACCURACY, in ULP of 1.0 */
+#if MATHC_FAST_ACCURACY <= 4
+	long double limit = 1.0e-4L / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+#else
+	long double limit = 1.0e-6L / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+#endif
+	int i;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		/* Small angles, then the whole documented range */
+		long double range = i % 2 == 0 ? 20.0L : 1.0e5L;
+		mfloat_t x = (mfloat_t)test_random(-range, range);
+		mfloat_t result[2];
+		long double reference[2];
+		reference[0] = sinl((long double)x);
+		reference[1] = cosl((long double)x);
+		result[0] = mathc_sin(x);
+		max_ulp[0] = test_max(max_ulp[0], test_ulp(result, reference, 1, 1.0L));
+		result[1] = mathc_cos(x);
+		max_ulp[1] = test_max(max_ulp[1], test_ulp(result + 1, reference + 1, 1, 1.0L));
+		mathc_sincos(x, &result[0], &result[1]);
+		max_ulp[2] = test_max(max_ulp[2], test_ulp(result, reference, 2, 1.0L));
+	}
+	test_report("mathc_sin", max_ulp[0], limit);
+	test_report("mathc_cos", max_ulp[1], limit);
+	test_report("mathc_sincos", max_ulp[2], limit);
+}
+
+/* The whole domain, including both ends, and values past the ends, NaN
+ * and infinities, which must give NaN */
+static void test_mathc_acos(void)
+{
+	long double max_ulp = 0.0L;
+	/* The absolute error documented for MATHC_FAST_ACCURACY, in ULP of 1.0 */
+#if MATHC_FAST_ACCURACY <= 4
+	long double limit = 1.0e-4L / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+#else
+	long double limit = (TEST_MANT_DIG == FLT_MANT_DIG ? 5.0e-6L : 1.0e-6L) / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+#endif
+	mfloat_t outside[6];
+	int i;
+	for (i = 0; i <= TEST_SAMPLES; i++) {
+		mfloat_t x = (mfloat_t)(-1.0L + 2.0L * (long double)i / (long double)TEST_SAMPLES);
+		mfloat_t result = mathc_acos(x);
+		long double reference = acosl((long double)x);
+		max_ulp = test_max(max_ulp, test_ulp(&result, &reference, 1, 1.0L));
+	}
+	outside[0] = MFLOAT_C(1.0) + MFLT_EPSILON;
+	outside[1] = -outside[0];
+	outside[2] = MFLOAT_C(2.0);
+	outside[3] = (mfloat_t)INFINITY;
+	outside[4] = -outside[3];
+	outside[5] = (mfloat_t)NAN;
+	for (i = 0; i < 6; i++) {
+		mfloat_t result = mathc_acos(outside[i]);
+		if (result == result) {
+			max_ulp = INFINITY;
+		}
+	}
+	test_report("mathc_acos", max_ulp, limit);
+}
+
+static void test_quat_multiply(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t q0[QUAT_SIZE];
+		mfloat_t q1[QUAT_SIZE];
+		mfloat_t result[QUAT_SIZE];
+		long double a[QUAT_SIZE];
+		long double b[QUAT_SIZE];
+		long double reference[QUAT_SIZE];
+		test_random_quat(a);
+		test_random_quat(b);
+		test_store(q0, a, QUAT_SIZE);
+		test_store(q1, b, QUAT_SIZE);
+		test_load(a, q0, QUAT_SIZE);
+		test_load(b, q1, QUAT_SIZE);
+		ref_quat_multiply(reference, a, b);
+		quat_multiply(result, q0, q1);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, QUAT_SIZE, 1.0L));
+		/* In place, with the result aliasing either operand */
+		quat_assign(result, q0);
+		quat_multiply(result, result, q1);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, QUAT_SIZE, 1.0L));
+		quat_assign(result, q1);
+		quat_multiply(result, q0, result);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, QUAT_SIZE, 1.0L));
+	}
+	test_report("quat_multiply", max_ulp, 4.0L);
+}
+
+static void test_quat_divide(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t q0[QUAT_SIZE];
+		/* Padded, so that reading past q1[3] gives a wrong result */
+		mfloat_t q1[12];
+		mfloat_t result[QUAT_SIZE];
+		long double a[QUAT_SIZE];
+		long double b[QUAT_SIZE];
+		long double inverse[QUAT_SIZE];
+		long double reference[QUAT_SIZE];
+		long double length_squared;
+		long double length = test_random(0.5L, 2.0L);
+		for (k = 0; k < 12; k++) {
+			q1[k] = TEST_GARBAGE;
+		}
+		test_random_quat(a);
+		test_random_quat(b);
+		for (k = 0; k < QUAT_SIZE; k++) {
+			b[k] = b[k] * length;
+		}
+		test_store(q0, a, QUAT_SIZE);
+		test_store(q1, b, QUAT_SIZE);
+		test_load(a, q0, QUAT_SIZE);
+		test_load(b, q1, QUAT_SIZE);
+		length_squared = b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3];
+		inverse[0] = -b[0] / length_squared;
+		inverse[1] = -b[1] / length_squared;
+		inverse[2] = -b[2] / length_squared;
+		inverse[3] = b[3] / length_squared;
+		ref_quat_multiply(reference, a, inverse);
+		quat_divide(result, q0, q1);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, QUAT_SIZE, 0.0L));
+	}
+	test_report("quat_divide", max_ulp, 8.0L);
+}
+
+static void test_quat_power(void)
+{
+	long double max_ulp = 0.0L;
+	mfloat_t q0[QUAT_SIZE];
+	mfloat_t result[QUAT_SIZE];
+	long double reference[QUAT_SIZE];
+	int i;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		long double q[QUAT_SIZE];
+		long double alpha;
+		long double s;
+		mfloat_t exponent = (mfloat_t)test_random(-2.0L, 2.0L);
+		test_random_quat(q);
+		test_store(q0, q, QUAT_SIZE);
+		test_load(q, q0, QUAT_SIZE);
+		if (fabsl(q[3]) >= 0.999L) {
+			continue;
+		}
+		alpha = acosl(q[3]);
+		s = sinl(alpha * (long double)exponent) / sinl(alpha);
+		reference[0] = q[0] * s;
+		reference[1] = q[1] * s;
+		reference[2] = q[2] * s;
+		reference[3] = cosl(alpha * (long double)exponent);
+		/* The result must not depend on its previous content */
+		quat(result, TEST_GARBAGE, TEST_GARBAGE, TEST_GARBAGE, TEST_GARBAGE);
+		quat_power(result, q0, exponent);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, QUAT_SIZE, 1.0L));
+	}
+	/* A scalar part of one is returned unchanged */
+	quat(q0, MFLOAT_C(0.25), MFLOAT_C(0.5), MFLOAT_C(0.75), MFLOAT_C(1.0));
+	test_load(reference, q0, QUAT_SIZE);
+	quat_power(result, q0, MFLOAT_C(0.5));
+	max_ulp = test_max(max_ulp, test_ulp(result, reference, QUAT_SIZE, 1.0L));
+	test_report("quat_power", max_ulp, 64.0L);
+}
+
+static void test_quat_slerp_n_fast(void)
+{
+	long double max_ulp = 0.0L;
+	/* The absolute error documented for quat_slerp_n_fast(), in ULP of 1.0 */
+#if MATHC_FAST_ACCURACY <= 4
+	long double limit = 2.0e-4L / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+#elif defined(MATHC_USE_DOUBLE_FLOATING_POINT)
+	long double limit = 2.0e-6L / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+#else
+	long double limit = 2.0e-5L / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+#endif
+	mfloat_t q0[100 * QUAT_SIZE];
+	mfloat_t q1[100 * QUAT_SIZE];
+	mfloat_t result[100 * QUAT_SIZE];
+	int i;
+	int j;
+	int k;
+	/* Batches of 100 pairs, across the 64 pairs of a chunk */
+	for (i = 0; i < TEST_SAMPLES / 100; i++) {
+		mfloat_t f = (mfloat_t)test_random(0.0L, 1.0L);
+		for (j = 0; j < 100; j++) {
+			long double a[QUAT_SIZE];
+			long double turn[QUAT_SIZE];
+			long double b[QUAT_SIZE];
+			long double angle = test_random(0.0L, j % 4 == 0 ? 0.1L : 3.1415926535897932385L);
+			test_random_quat(a);
+			test_random_axis(turn);
+			turn[0] = turn[0] * sinl(angle * 0.5L);
+			turn[1] = turn[1] * sinl(angle * 0.5L);
+			turn[2] = turn[2] * sinl(angle * 0.5L);
+			turn[3] = cosl(angle * 0.5L);
+			ref_quat_multiply(b, a, turn);
+			for (k = 0; k < QUAT_SIZE; k++) {
+				/* Also pairs in opposite hemispheres */
+				b[k] = j % 3 == 0 ? -b[k] : b[k];
+			}
+			test_store(q0 + j * QUAT_SIZE, a, QUAT_SIZE);
+			test_store(q1 + j * QUAT_SIZE, b, QUAT_SIZE);
+		}
+		quat_slerp_n_fast(result, q0, q1, f, 100);
+		for (j = 0; j < 100; j++) {
+			long double a[QUAT_SIZE];
+			long double b[QUAT_SIZE];
+			long double reference[QUAT_SIZE];
+			long double d;
+			long double f0;
+			long double f1;
+			test_load(a, q0 + j * QUAT_SIZE, QUAT_SIZE);
+			test_load(b, q1 + j * QUAT_SIZE, QUAT_SIZE);
+			d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+			/* Same linear fallback as quat_slerp(), skipping the pairs whose
+			 * rounding may pick the other side of it */
+			if (fabsl(fabsl(d) - 0.9995L) < 1.0e-5L) {
+				continue;
+			}
+			if (fabsl(d) > 0.9995L) {
+				f0 = 1.0L - (long double)f;
+				f1 = (long double)f;
+			} else {
+				long double theta = acosl(fabsl(d));
+				f0 = sinl((1.0L - (long double)f) * theta) / sinl(theta);
+				f1 = sinl((long double)f * theta) / sinl(theta);
+			}
+			f1 = d < 0.0L ? -f1 : f1;
+			for (k = 0; k < QUAT_SIZE; k++) {
+				reference[k] = a[k] * f0 + b[k] * f1;
+			}
+			max_ulp = test_max(max_ulp, test_ulp(result + j * QUAT_SIZE, reference, QUAT_SIZE, 1.0L));
+		}
+	}
+	test_report("quat_slerp_n_fast", max_ulp, limit);
+}
+
+static void test_quat_from_vec3(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t v0[VEC3_SIZE];
+		mfloat_t v1[VEC3_SIZE];
+		mfloat_t result[QUAT_SIZE];
+		long double a[VEC3_SIZE];
+		long double b[VEC3_SIZE];
+		long double reference[QUAT_SIZE];
+		long double length_a;
+		long double length_b;
+		long double length;
+		/* Different lengths, away from the opposite direction where the
+		 * rotation is not well defined */
+		do {
+			test_random_axis(a);
+			test_random_axis(b);
+		} while (a[0] * b[0] + a[1] * b[1] + a[2] * b[2] < -0.9L);
+		length_a = test_random(0.5L, 2.0L);
+		length_b = test_random(2.0L, 4.0L);
+		for (k = 0; k < VEC3_SIZE; k++) {
+			v0[k] = (mfloat_t)(a[k] * length_a);
+			v1[k] = (mfloat_t)(b[k] * length_b);
+		}
+		test_load(a, v0, VEC3_SIZE);
+		test_load(b, v1, VEC3_SIZE);
+		length_a = sqrtl(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+		length_b = sqrtl(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+		reference[0] = a[1] * b[2] - a[2] * b[1];
+		reference[1] = a[2] * b[0] - a[0] * b[2];
+		reference[2] = a[0] * b[1] - a[1] * b[0];
+		reference[3] = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + length_a * length_b;
+		length = sqrtl(reference[0] * reference[0] + reference[1] * reference[1] + reference[2] * reference[2] + reference[3] * reference[3]);
+		for (k = 0; k < QUAT_SIZE; k++) {
+			reference[k] = reference[k] / length;
+		}
+		quat_from_vec3(result, v0, v1);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, QUAT_SIZE, 1.0L));
+	}
+	test_report("quat_from_vec3", max_ulp, 8.0L);
+}
+
+static void test_quat_from_mat4(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t m0[MAT4_SIZE];
+		mfloat_t result[QUAT_SIZE];
+		long double axis[VEC3_SIZE];
+		long double rotation[MAT3_SIZE];
+		long double m[MAT4_SIZE];
+		long double reference[QUAT_SIZE];
+		long double negative[QUAT_SIZE];
+		long double ulp;
+		/* Angles up to pi, so that every branch is taken */
+		long double angle = test_random(0.0L, 3.1415926535897932385L);
+		test_random_axis(axis);
+		ref_mat3_rotation_axis(rotation, axis, angle);
+		for (k = 0; k < MAT4_SIZE; k++) {
+			m[k] = k == 15 ? 1.0L : 0.0L;
+		}
+		for (k = 0; k < MAT3_SIZE; k++) {
+			m[(k / 3) * 4 + k % 3] = rotation[k];
+		}
+		test_store(m0, m, MAT4_SIZE);
+		reference[0] = axis[0] * sinl(angle * 0.5L);
+		reference[1] = axis[1] * sinl(angle * 0.5L);
+		reference[2] = axis[2] * sinl(angle * 0.5L);
+		reference[3] = cosl(angle * 0.5L);
+		for (k = 0; k < QUAT_SIZE; k++) {
+			negative[k] = -reference[k];
+		}
+		quat_from_mat4(result, m0);
+		/* q and -q are the same rotation */
+		ulp = test_ulp(result, reference, QUAT_SIZE, 1.0L);
+		if (test_ulp(result, negative, QUAT_SIZE, 1.0L) < ulp) {
+			ulp = test_ulp(result, negative, QUAT_SIZE, 1.0L);
+		}
+		max_ulp = test_max(max_ulp, ulp);
+	}
+	test_report("quat_from_mat4", max_ulp, 8.0L);
+}
+
+/* Random transform with translations from -4.0 to 4.0 and scales from 0.5
+ * to 2.0, uniform if asked */
+static void test_random_trs(mfloat_t *result, bool uniform)
+{
+	long double q[QUAT_SIZE];
+	int k;
+	test_random_quat(q);
+	test_store(result + 3, q, QUAT_SIZE);
+	for (k = 0; k < VEC3_SIZE; k++) {
+		result[k] = (mfloat_t)test_random(-4.0L, 4.0L);
+		result[7 + k] = (mfloat_t)test_random(0.5L, 2.0L);
+	}
+	if (uniform) {
+		result[8] = result[7];
+		result[9] = result[7];
+	}
+}
+
+/* The trs_* functions against products and inverses of the matrices of
+ * the transforms. A uniform scale on the left keeps products exact for
+ * any scale on the right, and inverses need a uniform scale */
+static void test_trs(void)
+{
+	long double max_ulp[5] = {0.0L, 0.0L, 0.0L, 0.0L, 0.0L};
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t t0[TRS_SIZE];
+		mfloat_t t1[TRS_SIZE];
+		mfloat_t t[TRS_SIZE];
+		mfloat_t rotation[QUAT_SIZE];
+		mfloat_t point[VEC3_SIZE];
+		mfloat_t result[MAT4_SIZE];
+		long double a[TRS_SIZE];
+		long double b[TRS_SIZE];
+		long double m0[MAT4_SIZE];
+		long double m1[MAT4_SIZE];
+		long double reference[MAT4_SIZE];
+		mfloat_t f = (mfloat_t)test_random(0.0L, 1.0L);
+		test_random_trs(t0, true);
+		test_random_trs(t1, false);
+		test_load(a, t0, TRS_SIZE);
+		test_load(b, t1, TRS_SIZE);
+		ref_mat4_from_trs(m0, a);
+		ref_mat4_from_trs(m1, b);
+		mat4_from_trs(result, t1);
+		max_ulp[0] = test_max(max_ulp[0], test_ulp(result, m1, MAT4_SIZE, 1.0L));
+		ref_mat4_multiply(reference, m0, m1);
+		trs_multiply(t, t0, t1);
+		mat4_from_trs(result, t);
+		max_ulp[1] = test_max(max_ulp[1], test_ulp(result, reference, MAT4_SIZE, 1.0L));
+		ref_mat4_inverse(reference, m0);
+		trs_inverse(t, t0);
+		mat4_from_trs(result, t);
+		max_ulp[2] = test_max(max_ulp[2], test_ulp(result, reference, MAT4_SIZE, 1.0L));
+		/* Any scale moves a point like the matrix */
+		for (k = 0; k < VEC3_SIZE; k++) {
+			point[k] = (mfloat_t)test_random(-4.0L, 4.0L);
+		}
+		for (k = 0; k < VEC3_SIZE; k++) {
+			reference[k] = m1[k] * (long double)point[0] + m1[4 + k] * (long double)point[1] + m1[8 + k] * (long double)point[2] + m1[12 + k];
+		}
+		trs_transform_point(result, point, t1);
+		max_ulp[3] = test_max(max_ulp[3], test_ulp(result, reference, VEC3_SIZE, 1.0L));
+		/* Linear translation and scale, and the rotation of quat_slerp() */
+		trs_lerp(t, t0, t1, f);
+		for (k = 0; k < VEC3_SIZE; k++) {
+			reference[k] = a[k] + (b[k] - a[k]) * (long double)f;
+			reference[3 + k] = a[7 + k] + (b[7 + k] - a[7 + k]) * (long double)f;
+		}
+		vec3_assign(result, t);
+		vec3_assign(result + 3, t + 7);
+		max_ulp[4] = test_max(max_ulp[4], test_ulp(result, reference, 6, 1.0L));
+		quat_slerp(rotation, t0 + 3, t1 + 3, f);
+		if (memcmp(rotation, t + 3, sizeof(rotation)) != 0) {
+			max_ulp[4] = INFINITY;
+		}
+	}
+	test_report("mat4_from_trs", max_ulp[0], 8.0L);
+	test_report("trs_multiply", max_ulp[1], 16.0L);
+	test_report("trs_inverse", max_ulp[2], 16.0L);
+	test_report("trs_transform_point", max_ulp[3], 16.0L);
+	test_report("trs_lerp", max_ulp[4], 8.0L);
+}
+
+#define TEST_HIERARCHY_COUNT 64
+
+/* A forest of rigid nodes, updated in full and after changes to a few
+ * local matrices. The world matrices must match the chained products of
+ * mat4_multiply() exactly and the dirty flags must be cleared. The local
+ * matrices outside the changed subtrees are garbled before the second
+ * update, which must not read them */
+static void test_mat4_hierarchy(void)
+{
+	long double max_ulp = 0.0L;
+	int parents[TEST_HIERARCHY_COUNT];
+	mfloat_t local[TEST_HIERARCHY_COUNT * MAT4_SIZE];
+	mfloat_t world[TEST_HIERARCHY_COUNT * MAT4_SIZE];
+	mfloat_t expected[TEST_HIERARCHY_COUNT * MAT4_SIZE];
+	bool dirty[TEST_HIERARCHY_COUNT];
+	bool changed[TEST_HIERARCHY_COUNT];
+	struct mat4_hierarchy hierarchy;
+	int i;
+	int j;
+	int k;
+	hierarchy.parents = parents;
+	hierarchy.local = local;
+	hierarchy.world = world;
+	hierarchy.dirty = dirty;
+	hierarchy.count = TEST_HIERARCHY_COUNT;
+	for (i = 0; i < TEST_SAMPLES / 100; i++) {
+		for (j = 0; j < TEST_HIERARCHY_COUNT; j++) {
+			parents[j] = j % 16 == 0 ? -1 : (int)test_random(0.0L, j - 0.01L);
+			dirty[j] = true;
+			changed[j] = true;
+		}
+		for (k = 0; k < 2; k++) {
+			for (j = 0; j < TEST_HIERARCHY_COUNT; j++) {
+				mfloat_t t0[TRS_SIZE];
+				mfloat_t m0[MAT4_SIZE];
+				if (k == 0 || test_random(0.0L, 1.0L) < 0.05L) {
+					test_random_trs(t0, true);
+					vec3(t0 + 7, MFLOAT_C(1.0), MFLOAT_C(1.0), MFLOAT_C(1.0));
+					mat4_from_trs(m0, t0);
+					mat4_hierarchy_set_local(&hierarchy, (size_t)j, m0);
+					changed[j] = true;
+				} else {
+					changed[j] = parents[j] >= 0 && changed[parents[j]];
+				}
+				if (parents[j] < 0) {
+					mat4_assign(expected + j * MAT4_SIZE, local + j * MAT4_SIZE);
+				} else {
+					mat4_multiply(expected + j * MAT4_SIZE, expected + parents[j] * MAT4_SIZE, local + j * MAT4_SIZE);
+				}
+			}
+			for (j = 0; j < TEST_HIERARCHY_COUNT * MAT4_SIZE; j++) {
+				if (!changed[j / MAT4_SIZE]) {
+					local[j] = TEST_GARBAGE;
+				}
+			}
+			mat4_hierarchy_update(&hierarchy);
+			for (j = 0; j < TEST_HIERARCHY_COUNT; j++) {
+				if (memcmp(world + j * MAT4_SIZE, expected + j * MAT4_SIZE, MAT4_SIZE * sizeof(mfloat_t)) != 0 || dirty[j]) {
+					max_ulp = INFINITY;
+				}
+			}
+		}
+	}
+	test_report("mat4_hierarchy_update", max_ulp, 0.0L);
+}
+
+#define TEST_FRUSTUM_COUNT 100
+
+/* Planes against the normalized rows of the matrix, with and without a
+ * far plane. The scalar tests are checked against the signed distances
+ * away from the planes, and every bit of the _n and _stream masks must
+ * match the scalar tests */
+static void test_frustum(void)
+{
+	long double max_ulp[5] = {0.0L, 0.0L, 0.0L, 0.0L, 0.0L};
+	mfloat_t spheres[TEST_FRUSTUM_COUNT * VEC4_SIZE];
+	mfloat_t min[TEST_FRUSTUM_COUNT * VEC3_SIZE];
+	mfloat_t max[TEST_FRUSTUM_COUNT * VEC3_SIZE];
+	mfloat_t x[3][TEST_FRUSTUM_COUNT];
+	mfloat_t y[3][TEST_FRUSTUM_COUNT];
+	mfloat_t z[3][TEST_FRUSTUM_COUNT];
+	mfloat_t radius[TEST_FRUSTUM_COUNT];
+	uint32_t masks[4][(TEST_FRUSTUM_COUNT + 31) / 32];
+	struct vec3_stream streams[3];
+	int i;
+	int j;
+	int k;
+	for (k = 0; k < 3; k++) {
+		streams[k].x = x[k];
+		streams[k].y = y[k];
+		streams[k].z = z[k];
+		streams[k].count = TEST_FRUSTUM_COUNT;
+	}
+	for (i = 0; i < TEST_SAMPLES / 10; i++) {
+		mfloat_t m0[MAT4_SIZE];
+		mfloat_t f0[FRUSTUM_SIZE];
+		long double m[MAT4_SIZE];
+		test_random_view_projection(m0, i % 4 == 0);
+		test_load(m, m0, MAT4_SIZE);
+		frustum_from_mat4(f0, m0);
+		for (j = 0; j < 6; j++) {
+			long double plane[VEC4_SIZE];
+			long double l;
+			for (k = 0; k < VEC4_SIZE; k++) {
+				plane[k] = m[k * 4 + 3] + (j % 2 == 0 ? m[k * 4 + j / 2] : -m[k * 4 + j / 2]);
+			}
+			l = sqrtl(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+			for (k = 0; k < VEC4_SIZE && l > 0.0L; k++) {
+				plane[k] = plane[k] / l;
+			}
+			max_ulp[0] = test_max(max_ulp[0], test_ulp(f0 + j * VEC4_SIZE, plane, VEC4_SIZE, 1.0L));
+		}
+		for (j = 0; j < TEST_FRUSTUM_COUNT; j++) {
+			for (k = 0; k < VEC3_SIZE; k++) {
+				mfloat_t center = (mfloat_t)test_random(-16.0L, 16.0L);
+				mfloat_t extent = (mfloat_t)test_random(0.0L, 2.0L);
+				spheres[j * VEC4_SIZE + k] = center;
+				min[j * VEC3_SIZE + k] = center - extent;
+				max[j * VEC3_SIZE + k] = center + extent;
+			}
+			spheres[j * VEC4_SIZE + 3] = (mfloat_t)test_random(0.0L, 2.0L);
+			x[0][j] = spheres[j * VEC4_SIZE];
+			y[0][j] = spheres[j * VEC4_SIZE + 1];
+			z[0][j] = spheres[j * VEC4_SIZE + 2];
+			radius[j] = spheres[j * VEC4_SIZE + 3];
+			x[1][j] = min[j * VEC3_SIZE];
+			y[1][j] = min[j * VEC3_SIZE + 1];
+			z[1][j] = min[j * VEC3_SIZE + 2];
+			x[2][j] = max[j * VEC3_SIZE];
+			y[2][j] = max[j * VEC3_SIZE + 1];
+			z[2][j] = max[j * VEC3_SIZE + 2];
+		}
+		frustum_intersects_sphere_n(masks[0], f0, spheres, TEST_FRUSTUM_COUNT);
+		frustum_intersects_sphere_stream(masks[1], f0, &streams[0], radius);
+		frustum_intersects_aabb_n(masks[2], f0, min, max, TEST_FRUSTUM_COUNT);
+		frustum_intersects_aabb_stream(masks[3], f0, &streams[1], &streams[2]);
+		for (j = 0; j < TEST_FRUSTUM_COUNT; j++) {
+			bool sphere = frustum_intersects_sphere(f0, spheres + j * VEC4_SIZE, radius[j]);
+			bool aabb = frustum_intersects_aabb(f0, min + j * VEC3_SIZE, max + j * VEC3_SIZE);
+			long double sphere_distance = INFINITY;
+			long double aabb_distance = INFINITY;
+			uint32_t bit = (uint32_t)1 << (j % 32);
+			int plane;
+			for (plane = 0; plane < 6; plane++) {
+				long double p[VEC4_SIZE];
+				long double d;
+				test_load(p, f0 + plane * VEC4_SIZE, VEC4_SIZE);
+				d = p[3];
+				for (k = 0; k < VEC3_SIZE; k++) {
+					d = d + p[k] * (long double)spheres[j * VEC4_SIZE + k];
+				}
+				d = d + (long double)radius[j];
+				sphere_distance = d < sphere_distance ? d : sphere_distance;
+				d = p[3];
+				for (k = 0; k < VEC3_SIZE; k++) {
+					d = d + p[k] * (long double)(p[k] > 0.0L ? max[j * VEC3_SIZE + k] : min[j * VEC3_SIZE + k]);
+				}
+				aabb_distance = d < aabb_distance ? d : aabb_distance;
+			}
+			/* Objects within rounding of a plane may go either way */
+			if (fabsl(sphere_distance) > 1e-4L && sphere != (sphere_distance >= 0.0L)) {
+				max_ulp[1] = INFINITY;
+			}
+			if (fabsl(aabb_distance) > 1e-4L && aabb != (aabb_distance >= 0.0L)) {
+				max_ulp[2] = INFINITY;
+			}
+			for (k = 0; k < 2; k++) {
+				if (((masks[k][j / 32] & bit) != 0) != sphere) {
+					max_ulp[3] = INFINITY;
+				}
+				if (((masks[2 + k][j / 32] & bit) != 0) != aabb) {
+					max_ulp[4] = INFINITY;
+				}
+			}
+		}
+	}
+	test_report("frustum_from_mat4", max_ulp[0], 8.0L);
+	test_report("frustum_intersects_sphere", max_ulp[1], 0.0L);
+	test_report("frustum_intersects_aabb", max_ulp[2], 0.0L);
+	test_report("frustum_intersects_sphere_n", max_ulp[3], 0.0L);
+	test_report("frustum_intersects_aabb_n", max_ulp[4], 0.0L);
+}
+
+#define TEST_BUFFER_SIZE 1024
+
+/* Views at every element offset, for several alignments, strides and
+ * sizes, against the aligned start and the number of whole elements after
+ * it. mat4_multiply_n() and mat3_to_std140_n() then write through views,
+ * the padding of std140 columns must be zero and the rest of a longer
+ * stride must be left alone */
+static void test_aligned_buffer(void)
+{
+	long double max_ulp[2] = {0.0L, 0.0L};
+	mfloat_t memory[TEST_BUFFER_SIZE / sizeof(mfloat_t)];
+	size_t strides[3] = {MAT4_SIZE * sizeof(mfloat_t), MAT3_STD140_SIZE * sizeof(mfloat_t), (MAT4_SIZE + 4) * sizeof(mfloat_t)};
+	size_t alignment;
+	int i;
+	int j;
+	int k;
+	for (alignment = 16; alignment <= 64; alignment = alignment * 2) {
+		for (i = 0; i < 16; i++) {
+			for (j = 0; j < 3; j++) {
+				struct aligned_buffer buffer;
+				char *start = (char *)(memory + i);
+				size_t size = TEST_BUFFER_SIZE - (size_t)i * sizeof(mfloat_t) - (size_t)test_random(0.0L, 512.0L);
+				char *data;
+				size_t capacity;
+				aligned_buffer(&buffer, start, size, alignment, strides[j]);
+				data = (char *)buffer.data;
+				capacity = buffer.capacity;
+				if ((uintptr_t)data % alignment != 0 || data < start || data >= start + alignment || buffer.stride != strides[j]) {
+					max_ulp[0] = INFINITY;
+				}
+				if (capacity * strides[j] > size - (size_t)(data - start) || (capacity + 1) * strides[j] <= size - (size_t)(data - start)) {
+					max_ulp[0] = INFINITY;
+				}
+				for (k = 0; k < (int)capacity; k++) {
+					if ((char *)aligned_buffer_at(&buffer, (size_t)k) != data + (size_t)k * strides[j]) {
+						max_ulp[0] = INFINITY;
+					}
+				}
+				if (aligned_buffer_size(&buffer, capacity) != capacity * strides[j]) {
+					max_ulp[0] = INFINITY;
+				}
+			}
+		}
+		/* Memory that ends before the aligned start holds nothing */
+		{
+			struct aligned_buffer buffer;
+			char *start = (char *)memory + sizeof(mfloat_t);
+			start = start + (alignment - (size_t)((uintptr_t)start % alignment)) % alignment + sizeof(mfloat_t);
+			aligned_buffer(&buffer, start, alignment - sizeof(mfloat_t), alignment, sizeof(mfloat_t));
+			if (buffer.capacity != 0 || (char *)buffer.data != start + alignment - sizeof(mfloat_t)) {
+				max_ulp[0] = INFINITY;
+			}
+		}
+	}
+	for (i = 0; i < TEST_SAMPLES / 100; i++) {
+		struct aligned_buffer buffer;
+		mfloat_t m0[4 * MAT4_SIZE];
+		mfloat_t m1[4 * MAT4_SIZE];
+		mfloat_t expected[MAT4_SIZE];
+		mfloat_t m[4 * MAT3_SIZE];
+		mfloat_t unpacked[MAT3_SIZE];
+		for (k = 0; k < 4 * MAT4_SIZE; k++) {
+			m0[k] = (mfloat_t)test_random(-2.0L, 2.0L);
+			m1[k] = (mfloat_t)test_random(-2.0L, 2.0L);
+		}
+		for (k = 0; k < 4 * MAT3_SIZE; k++) {
+			m[k] = (mfloat_t)test_random(-2.0L, 2.0L);
+		}
+		for (k = 0; k < (int)(TEST_BUFFER_SIZE / sizeof(mfloat_t)); k++) {
+			memory[k] = TEST_GARBAGE;
+		}
+		aligned_buffer(&buffer, memory + i % 16, TEST_BUFFER_SIZE / 2, 64, MAT4_SIZE * sizeof(mfloat_t));
+		mat4_multiply_n(aligned_buffer_at(&buffer, 1), m0, m1, 4);
+		for (j = 0; j < 4; j++) {
+			mat4_multiply(expected, m0 + j * MAT4_SIZE, m1 + j * MAT4_SIZE);
+			if (memcmp(aligned_buffer_at(&buffer, (size_t)j + 1), expected, sizeof(expected)) != 0) {
+				max_ulp[0] = INFINITY;
+			}
+		}
+		if (buffer.data[MAT4_SIZE - 1] != TEST_GARBAGE || buffer.data[5 * MAT4_SIZE] != TEST_GARBAGE) {
+			max_ulp[0] = INFINITY;
+		}
+		/* std140 columns in elements of a mat4 each */
+		mat3_to_std140_n(buffer.data, m, 4, buffer.stride);
+		for (j = 0; j < 4; j++) {
+			mfloat_t *packed = aligned_buffer_at(&buffer, (size_t)j);
+			for (k = 0; k < MAT3_STD140_SIZE; k++) {
+				if (packed[k] != (k % 4 == 3 ? MFLOAT_C(0.0) : m[j * MAT3_SIZE + k / 4 * 3 + k % 4])) {
+					max_ulp[1] = INFINITY;
+				}
+			}
+			for (k = MAT3_STD140_SIZE; k < MAT4_SIZE && j == 0; k++) {
+				if (packed[k] != TEST_GARBAGE) {
+					max_ulp[1] = INFINITY;
+				}
+			}
+			mat3_from_std140(unpacked, packed);
+			if (memcmp(unpacked, m + j * MAT3_SIZE, sizeof(unpacked)) != 0) {
+				max_ulp[1] = INFINITY;
+			}
+		}
+		mat3_to_std140_n(buffer.data, m, 4, 0);
+		for (k = 0; k < 4 * MAT3_STD140_SIZE; k++) {
+			int element = k / MAT3_STD140_SIZE * MAT3_SIZE + k % MAT3_STD140_SIZE / 4 * 3 + k % 4;
+			if (buffer.data[k] != (k % 4 == 3 ? MFLOAT_C(0.0) : m[element])) {
+				max_ulp[1] = INFINITY;
+			}
+		}
+	}
+	test_report("aligned_buffer", max_ulp[0], 0.0L);
+	test_report("mat3_to_std140", max_ulp[1], 0.0L);
+}
+
+#define TEST_ENCODE_COUNT 100
+
+/* Angle between two rotations, in radians, from the distance between the
+ * normalized quaternions, which stays accurate for small angles */
+static long double test_quat_angle(long double *q0, mfloat_t *q1)
+{
+	long double a[QUAT_SIZE];
+	long double b[QUAT_SIZE];
+	long double length_a = 0.0L;
+	long double length_b = 0.0L;
+	long double dot = 0.0L;
+	long double distance = 0.0L;
+	int k;
+	for (k = 0; k < QUAT_SIZE; k++) {
+		a[k] = q0[k];
+		b[k] = (long double)q1[k];
+		length_a = length_a + a[k] * a[k];
+		length_b = length_b + b[k] * b[k];
+		dot = dot + a[k] * b[k];
+	}
+	for (k = 0; k < QUAT_SIZE; k++) {
+		long double d = a[k] / sqrtl(length_a) - (dot < 0.0L ? -b[k] : b[k]) / sqrtl(length_b);
+		distance = distance + d * d;
+	}
+	return 4.0L * asinl(sqrtl(distance) * 0.5L);
+}
+
+/* The batched encoders and decoders against the scalar ones, exactly, for
+ * every index of the largest component, on encoded quaternions and on
+ * arbitrary codes. The angle between a quaternion and its decoded form is
+ * checked against the documented error, in ULP of 1.0 */
+static void test_quat_encode(void)
+{
+	long double max_ulp[6] = {0.0L, 0.0L, 0.0L, 0.0L, 0.0L, 0.0L};
+	long double limit_32 = 0.25L * 3.1415926535897932385L / 180.0L / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+	long double limit_48 = 0.01L * 3.1415926535897932385L / 180.0L / ldexpl(1.0L, 1 - TEST_MANT_DIG);
+	mfloat_t q0[TEST_ENCODE_COUNT * QUAT_SIZE];
+	mfloat_t decoded[TEST_ENCODE_COUNT * QUAT_SIZE];
+	mfloat_t batched[TEST_ENCODE_COUNT * QUAT_SIZE];
+	long double input[TEST_ENCODE_COUNT][QUAT_SIZE];
+	uint32_t code_32[TEST_ENCODE_COUNT];
+	uint32_t batched_32[TEST_ENCODE_COUNT];
+	uint16_t code_48[TEST_ENCODE_COUNT * 3];
+	uint16_t batched_48[TEST_ENCODE_COUNT * 3];
+	int i;
+	int k;
+	int round;
+	for (i = 0; i < TEST_SAMPLES / TEST_ENCODE_COUNT; i++) {
+		for (k = 0; k < TEST_ENCODE_COUNT; k++) {
+			long double *q = input[k];
+			long double swap;
+			int largest = 0;
+			int j;
+			/* Component k % 4 is made the largest one, negative for half of them */
+			test_random_quat(q);
+			for (j = 1; j < QUAT_SIZE; j++) {
+				if (fabsl(q[j]) > fabsl(q[largest])) {
+					largest = j;
+				}
+			}
+			swap = q[largest];
+			q[largest] = q[k % 4];
+			q[k % 4] = swap;
+			for (j = 0; j < QUAT_SIZE && k % 8 >= 4; j++) {
+				q[j] = -q[j];
+			}
+			test_store(q0 + k * QUAT_SIZE, q, QUAT_SIZE);
+			test_load(q, q0 + k * QUAT_SIZE, QUAT_SIZE);
+		}
+		quat_encode_32_n(batched_32, q0, TEST_ENCODE_COUNT);
+		quat_encode_48_n(batched_48, q0, TEST_ENCODE_COUNT);
+		for (k = 0; k < TEST_ENCODE_COUNT; k++) {
+			quat_encode_32(code_32 + k, q0 + k * QUAT_SIZE);
+			quat_encode_48(code_48 + k * 3, q0 + k * QUAT_SIZE);
+			if (code_32[k] != batched_32[k] || (int)(code_32[k] >> 30) != k % 4) {
+				max_ulp[0] = INFINITY;
+			}
+			if (memcmp(code_48 + k * 3, batched_48 + k * 3, 3 * sizeof(uint16_t)) != 0 || ((code_48[k * 3] >> 15) << 1 | code_48[k * 3 + 1] >> 15) != k % 4) {
+				max_ulp[3] = INFINITY;
+			}
+		}
+		/* Encoded quaternions, then arbitrary codes, whose three components
+		 * may lie outside the unit sphere */
+		for (round = 0; round < 2; round++) {
+			quat_decode_32_n(batched, code_32, TEST_ENCODE_COUNT);
+			for (k = 0; k < TEST_ENCODE_COUNT; k++) {
+				long double reference[QUAT_SIZE];
+				quat_decode_32(decoded + k * QUAT_SIZE, code_32 + k);
+				test_load(reference, decoded + k * QUAT_SIZE, QUAT_SIZE);
+				max_ulp[1] = test_max(max_ulp[1], test_ulp(batched + k * QUAT_SIZE, reference, QUAT_SIZE, 1.0L));
+				if (round == 0) {
+					max_ulp[2] = test_max(max_ulp[2], test_quat_angle(input[k], decoded + k * QUAT_SIZE) / ldexpl(1.0L, 1 - TEST_MANT_DIG));
+				}
+			}
+			quat_decode_48_n(batched, code_48, TEST_ENCODE_COUNT);
+			for (k = 0; k < TEST_ENCODE_COUNT; k++) {
+				long double reference[QUAT_SIZE];
+				quat_decode_48(decoded + k * QUAT_SIZE, code_48 + k * 3);
+				test_load(reference, decoded + k * QUAT_SIZE, QUAT_SIZE);
+				max_ulp[4] = test_max(max_ulp[4], test_ulp(batched + k * QUAT_SIZE, reference, QUAT_SIZE, 1.0L));
+				if (round == 0) {
+					max_ulp[5] = test_max(max_ulp[5], test_quat_angle(input[k], decoded + k * QUAT_SIZE) / ldexpl(1.0L, 1 - TEST_MANT_DIG));
+				}
+			}
+			for (k = 0; k < TEST_ENCODE_COUNT; k++) {
+				code_32[k] = (uint32_t)(k % 4) << 30 | (uint32_t)test_random(0.0L, 1023.0L) << 20 | (uint32_t)test_random(0.0L, 1023.0L) << 10 | (uint32_t)test_random(0.0L, 1023.0L);
+				code_48[k * 3] = (uint16_t)((k % 4) >> 1 << 15 | (int)test_random(0.0L, 32767.0L));
+				code_48[k * 3 + 1] = (uint16_t)((k % 2) << 15 | (int)test_random(0.0L, 32767.0L));
+				code_48[k * 3 + 2] = (uint16_t)test_random(0.0L, 32767.0L);
+			}
+		}
+	}
+	test_report("quat_encode_32_n", max_ulp[0], 0.0L);
+	test_report("quat_decode_32_n", max_ulp[1], 0.0L);
+	test_report("quat_decode_32", max_ulp[2], limit_32);
+	test_report("quat_encode_48_n", max_ulp[3], 0.0L);
+	test_report("quat_decode_48_n", max_ulp[4], 0.0L);
+	test_report("quat_decode_48", max_ulp[5], limit_48);
+}
+
+/* The vec3 codecs against their batched forms, exactly, and the round trip
+ * against the input: within half a unit of the 11-bit significand of a
+ * half, and within half a step of the 16-bit range of a box (for values
+ * inside it, the others are clamped) */
+static void test_vec3_encode(void)
+{
+	long double max_ulp[6] = {0.0L, 0.0L, 0.0L, 0.0L, 0.0L, 0.0L};
+	long double limit_range = (2.0L / 65535.0L) / ldexpl(1.0L, 2 - TEST_MANT_DIG) + 2.0L;
+	mfloat_t v0[TEST_ENCODE_COUNT * VEC3_SIZE];
+	mfloat_t decoded[TEST_ENCODE_COUNT * VEC3_SIZE];
+	mfloat_t batched[TEST_ENCODE_COUNT * VEC3_SIZE];
+	uint16_t code[TEST_ENCODE_COUNT * VEC3_SIZE];
+	uint16_t batched_code[TEST_ENCODE_COUNT * VEC3_SIZE];
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES / TEST_ENCODE_COUNT; i++) {
+		mfloat_t box_min[VEC3_SIZE];
+		mfloat_t box_max[VEC3_SIZE];
+		for (k = 0; k < TEST_ENCODE_COUNT * VEC3_SIZE; k++) {
+			v0[k] = (mfloat_t)test_random(-1000.0L, 1000.0L);
+		}
+		vec3_encode_half_n(batched_code, v0, TEST_ENCODE_COUNT);
+		vec3_decode_half_n(batched, batched_code, TEST_ENCODE_COUNT);
+		for (k = 0; k < TEST_ENCODE_COUNT; k++) {
+			long double reference[VEC3_SIZE];
+			vec3_encode_half(code + k * VEC3_SIZE, v0 + k * VEC3_SIZE);
+			vec3_decode_half(decoded + k * VEC3_SIZE, code + k * VEC3_SIZE);
+			if (memcmp(code + k * VEC3_SIZE, batched_code + k * VEC3_SIZE, VEC3_SIZE * sizeof(uint16_t)) != 0) {
+				max_ulp[0] = INFINITY;
+			}
+			test_load(reference, decoded + k * VEC3_SIZE, VEC3_SIZE);
+			max_ulp[1] = test_max(max_ulp[1], test_ulp(batched + k * VEC3_SIZE, reference, VEC3_SIZE, 0.0L));
+			test_load(reference, v0 + k * VEC3_SIZE, VEC3_SIZE);
+			max_ulp[2] = test_max(max_ulp[2], test_ulp(decoded + k * VEC3_SIZE, reference, VEC3_SIZE, 0.0L));
+		}
+		for (k = 0; k < VEC3_SIZE; k++) {
+			box_min[k] = (mfloat_t)test_random(-2.0L, -1.0L);
+			box_max[k] = (mfloat_t)test_random(1.0L, 2.0L);
+		}
+		for (k = 0; k < TEST_ENCODE_COUNT * VEC3_SIZE; k++) {
+			v0[k] = (mfloat_t)test_random(-2.5L, 2.5L);
+		}
+		vec3_encode_range_n(batched_code, v0, box_min, box_max, TEST_ENCODE_COUNT);
+		vec3_decode_range_n(batched, batched_code, box_min, box_max, TEST_ENCODE_COUNT);
+		for (k = 0; k < TEST_ENCODE_COUNT; k++) {
+			long double reference[VEC3_SIZE];
+			int j;
+			vec3_encode_range(code + k * VEC3_SIZE, v0 + k * VEC3_SIZE, box_min, box_max);
+			vec3_decode_range(decoded + k * VEC3_SIZE, code + k * VEC3_SIZE, box_min, box_max);
+			if (memcmp(code + k * VEC3_SIZE, batched_code + k * VEC3_SIZE, VEC3_SIZE * sizeof(uint16_t)) != 0) {
+				max_ulp[3] = INFINITY;
+			}
+			test_load(reference, decoded + k * VEC3_SIZE, VEC3_SIZE);
+			max_ulp[4] = test_max(max_ulp[4], test_ulp(batched + k * VEC3_SIZE, reference, VEC3_SIZE, 2.0L));
+			for (j = 0; j < VEC3_SIZE; j++) {
+				reference[j] = fmaxl(fminl((long double)v0[k * VEC3_SIZE + j], (long double)box_max[j]), (long double)box_min[j]);
+			}
+			max_ulp[5] = test_max(max_ulp[5], test_ulp(decoded + k * VEC3_SIZE, reference, VEC3_SIZE, 2.0L));
+		}
+	}
+	test_report("vec3_encode_half_n", max_ulp[0], 0.0L);
+	test_report("vec3_decode_half_n", max_ulp[1], 0.0L);
+	/* Plus the rounding to float on the way, with double */
+	test_report("vec3_decode_half", max_ulp[2], ldexpl(1.0L, TEST_MANT_DIG - 12) + ldexpl(1.0L, TEST_MANT_DIG - 24));
+	test_report("vec3_encode_range_n", max_ulp[3], 0.0L);
+	test_report("vec3_decode_range_n", max_ulp[4], 0.0L);
+	test_report("vec3_decode_range", max_ulp[5], limit_range);
+}
+
+static float test_float_from_bits(uint32_t i)
+{
+	union {
+		float f;
+		uint32_t i;
+	} bits;
+	bits.i = i;
+	return bits.f;
+}
+
+/* Value of a half, from its fields */
+static long double ref_half_value(mhalf_t h)
+{
+	int exponent = (h >> 10) & 31;
+	int mantissa = h & 1023;
+	long double value;
+	if (exponent == 31) {
+		value = mantissa == 0 ? INFINITY : NAN;
+	} else if (exponent == 0) {
+		value = ldexpl((long double)mantissa, -24);
+	} else {
+		value = ldexpl((long double)(mantissa + 1024), exponent - 25);
+	}
+	return (h & 0x8000) != 0 ? -value : value;
+}
+
+/* Whether a decoded value is the expected one, NaNs and signed zeros included */
+static bool test_same_value(mfloat_t value, long double expected)
+{
+	if (expected != expected) {
+		return value != value;
+	}
+	return (long double)value == expected && (signbit(value) != 0) == (signbit(expected) != 0);
+}
+
+/* Encodes count values with one call, which takes the F16C path for groups
+ * of four when it is enabled, and one value per call, which always takes
+ * the portable conversion. Both must give the expected halves */
+static bool test_half_encode(mfloat_t *v0, mhalf_t *expected, size_t count)
+{
+	mhalf_t result[64];
+	mhalf_t single;
+	bool passed = true;
+	size_t i;
+	half_encode_n(result, v0, count);
+	for (i = 0; i < count; i++) {
+		half_encode_n(&single, v0 + i, 1);
+		if (result[i] != expected[i] || single != expected[i]) {
+			passed = false;
+		}
+	}
+	return passed;
+}
+
+/* Fixed values at the edges of the half and bfloat16 formats, then every
+ * half and every bfloat16: decoded against the value of their fields,
+ * encoded back, and the midpoints between neighbours rounded to the even
+ * one (with the values just below and above them) */
+static void test_half(void)
+{
+	static mfloat_t decoded[65536];
+	static mhalf_t all[65536];
+	long double max_ulp[5] = {0.0L, 0.0L, 0.0L, 0.0L, 0.0L};
+	/* 65520 is halfway between 65504 and 65536, and rounds to infinity */
+	mfloat_t edges[] = {
+		MFLOAT_C(0.0), -MFLOAT_C(0.0), MFLOAT_C(1.0), -MFLOAT_C(2.0),
+		MFLOAT_C(65504.0), MFLOAT_C(65519.0), MFLOAT_C(65520.0), -MFLOAT_C(65520.0),
+		(mfloat_t)INFINITY, -(mfloat_t)INFINITY, MFLOAT_C(1.0e6), (mfloat_t)FLT_MAX,
+		MFLOAT_C(5.9604644775390625e-8), MFLOAT_C(2.98023223876953125e-8), MFLOAT_C(8.94069671630859375e-8), MFLOAT_C(6.0975551605224609375e-5),
+		MFLOAT_C(6.103515625e-5), MFLOAT_C(1.00048828125), MFLOAT_C(1.00146484375), MFLOAT_C(1.0e-10)
+	};
+	mhalf_t edge_halves[] = {
+		0x0000, 0x8000, 0x3c00, 0xc000,
+		0x7bff, 0x7bff, 0x7c00, 0xfc00,
+		0x7c00, 0xfc00, 0x7c00, 0x7c00,
+		0x0001, 0x0000, 0x0002, 0x03ff,
+		0x0400, 0x3c00, 0x3c02, 0x0000
+	};
+	/* Float bits and their bfloat16: ties to even both ways, just above a
+	 * tie, the largest float rounding to infinity, and NaNs kept quiet */
+	uint32_t bfloat16_edges[][2] = {
+		{UINT32_C(0x3f800000), 0x3f80}, {UINT32_C(0x3f808000), 0x3f80}, {UINT32_C(0x3f818000), 0x3f82}, {UINT32_C(0x3f808001), 0x3f81},
+		{UINT32_C(0x80000000), 0x8000}, {UINT32_C(0x00000001), 0x0000}, {UINT32_C(0x7f7fffff), 0x7f80}, {UINT32_C(0xff800000), 0xff80},
+		{UINT32_C(0x7fc00000), 0x7fc0}, {UINT32_C(0x7f800001), 0x7fc0}, {UINT32_C(0xffc00000), 0xffc0}, {UINT32_C(0xc0490fdb), 0xc049}
+	};
+	mfloat_t v0[64];
+	mhalf_t expected[64];
+	mhalf_t code;
+	size_t count = sizeof(edges) / sizeof(edges[0]);
+	size_t i;
+	size_t j;
+	mfloat_t value;
+	if (!test_half_encode(edges, edge_halves, count)) {
+		max_ulp[0] = INFINITY;
+	}
+	/* NaN, whose payload may differ between the two paths */
+	for (i = 0; i < 5; i++) {
+		v0[i] = (mfloat_t)NAN;
+	}
+	half_encode_n(expected, v0, 5);
+	for (i = 0; i < 5; i++) {
+		if ((expected[i] & 0x7c00) != 0x7c00 || (expected[i] & 0x03ff) == 0) {
+			max_ulp[0] = INFINITY;
+		}
+	}
+	for (i = 0; i < 65536; i++) {
+		all[i] = (mhalf_t)i;
+	}
+	half_decode_n(decoded, all, 65536);
+	for (i = 0; i < 65536; i++) {
+		half_decode_n(&value, all + i, 1);
+		if (!test_same_value(decoded[i], ref_half_value((mhalf_t)i)) || !test_same_value(value, ref_half_value((mhalf_t)i))) {
+			max_ulp[1] = INFINITY;
+		}
+	}
+	/* Every finite half of both signs, then the midpoints above the
+	 * positive ones, 16 at a time */
+	for (i = 0; i < 0x7c00; i += 16) {
+		for (j = 0; j < 16; j++) {
+			v0[j] = (mfloat_t)ref_half_value((mhalf_t)(i + j));
+			v0[16 + j] = (mfloat_t)ref_half_value((mhalf_t)(0x8000 | (i + j)));
+			expected[j] = (mhalf_t)(i + j);
+			expected[16 + j] = (mhalf_t)(0x8000 | (i + j));
+		}
+		if (!test_half_encode(v0, expected, 32)) {
+			max_ulp[0] = INFINITY;
+		}
+		for (j = 0; j < 16 && i + j < 0x7bff; j++) {
+			float midpoint = (float)((ref_half_value((mhalf_t)(i + j)) + ref_half_value((mhalf_t)(i + j + 1))) * 0.5L);
+			v0[j * 3] = (mfloat_t)midpoint;
+			v0[j * 3 + 1] = (mfloat_t)nextafterf(midpoint, 0.0f);
+			v0[j * 3 + 2] = (mfloat_t)nextafterf(midpoint, INFINITY);
+			expected[j * 3] = (mhalf_t)((i + j) % 2 == 0 ? i + j : i + j + 1);
+			expected[j * 3 + 1] = (mhalf_t)(i + j);
+			expected[j * 3 + 2] = (mhalf_t)(i + j + 1);
+		}
+		if (!test_half_encode(v0, expected, j * 3)) {
+			max_ulp[0] = INFINITY;
+		}
+	}
+	for (i = 0; i < sizeof(bfloat16_edges) / sizeof(bfloat16_edges[0]); i++) {
+		value = (mfloat_t)test_float_from_bits(bfloat16_edges[i][0]);
+		bfloat16_encode_n(&code, &value, 1);
+		if (code != bfloat16_edges[i][1]) {
+			max_ulp[2] = INFINITY;
+		}
+	}
+	bfloat16_decode_n(decoded, all, 65536);
+	for (i = 0; i < 65536; i++) {
+		float f = test_float_from_bits((uint32_t)i << 16);
+		if (!test_same_value(decoded[i], f != f ? (long double)NAN : (long double)f)) {
+			max_ulp[3] = INFINITY;
+		}
+		if (f != f) {
+			continue;
+		}
+		/* Encoded back, then the midpoint above it and its neighbours */
+		for (j = 0; j < 4; j++) {
+			uint32_t bits = (uint32_t)i << 16 | (j == 0 ? 0 : UINT32_C(0x7ffe) + (uint32_t)j);
+			mhalf_t result = (mhalf_t)(j <= 1 ? i : (j == 3 || i % 2 == 1 ? i + 1 : i));
+			if ((i & 0x7fff) == 0x7f80 && j > 0) {
+				continue;
+			}
+			value = (mfloat_t)test_float_from_bits(bits);
+			bfloat16_encode_n(&code, &value, 1);
+			if (code != result) {
+				max_ulp[2] = INFINITY;
+			}
+		}
+	}
+	test_report("half_encode_n", max_ulp[0], 0.0L);
+	test_report("half_decode_n", max_ulp[1], 0.0L);
+	test_report("bfloat16_encode_n", max_ulp[2], 0.0L);
+	test_report("bfloat16_decode_n", max_ulp[3], 0.0L);
+}
+
+#define TEST_TRANSFORM_COUNT 150
+
+/* Points by affine and projective matrices and directions by any matrix,
+ * tightly packed, interleaved with two more values per vertex, which must
+ * be left alone, and in place */
+static void test_mat4_transform_points(void)
+{
+	long double max_ulp[2] = {0.0L, 0.0L};
+	mfloat_t packed[TEST_TRANSFORM_COUNT * VEC3_SIZE];
+	mfloat_t interleaved[TEST_TRANSFORM_COUNT * 5];
+	mfloat_t result[TEST_TRANSFORM_COUNT * 5];
+	mfloat_t m0[MAT4_SIZE];
+	int i;
+	int j;
+	int k;
+	for (i = 0; i < TEST_SAMPLES / 50; i++) {
+		long double m[MAT4_SIZE];
+		for (k = 0; k < MAT4_SIZE; k++) {
+			m0[k] = (mfloat_t)test_random(-2.0L, 2.0L);
+		}
+		/* Affine, or projective with w from 2.0 to 15.0 */
+		if (i % 2 == 0) {
+			m0[3] = MFLOAT_C(0.0);
+			m0[7] = MFLOAT_C(0.0);
+			m0[11] = MFLOAT_C(0.0);
+			m0[15] = MFLOAT_C(1.0);
+		} else {
+			m0[3] = m0[3] / MFLOAT_C(4.0);
+			m0[7] = m0[7] / MFLOAT_C(4.0);
+			m0[11] = m0[11] / MFLOAT_C(4.0);
+			m0[15] = (mfloat_t)test_random(8.0L, 9.0L);
+		}
+		test_load(m, m0, MAT4_SIZE);
+		for (k = 0; k < TEST_TRANSFORM_COUNT * 5; k++) {
+			interleaved[k] = k % 5 < VEC3_SIZE ? (mfloat_t)test_random(-4.0L, 4.0L) : TEST_GARBAGE;
+		}
+		for (k = 0; k < TEST_TRANSFORM_COUNT * VEC3_SIZE; k++) {
+			packed[k] = interleaved[k / VEC3_SIZE * 5 + k % VEC3_SIZE];
+		}
+		for (j = 0; j < 2; j++) {
+			int layout;
+			for (layout = 0; layout < 3; layout++) {
+				size_t stride = layout == 0 ? 0 : 5 * sizeof(mfloat_t);
+				mfloat_t *in = layout == 0 ? packed : layout == 1 ? interleaved : result;
+				int step = layout == 0 ? VEC3_SIZE : 5;
+				int point;
+				for (k = 0; k < TEST_TRANSFORM_COUNT * 5; k++) {
+					result[k] = layout == 2 ? interleaved[k] : TEST_GARBAGE;
+				}
+				if (j == 0) {
+					mat4_transform_points(result, in, TEST_TRANSFORM_COUNT, stride, m0);
+				} else {
+					mat4_transform_directions(result, in, TEST_TRANSFORM_COUNT, stride, m0);
+				}
+				for (point = 0; point < TEST_TRANSFORM_COUNT; point++) {
+					long double v[VEC3_SIZE];
+					long double reference[VEC3_SIZE];
+					long double w;
+					test_load(v, packed + point * VEC3_SIZE, VEC3_SIZE);
+					w = j == 0 ? m[3] * v[0] + m[7] * v[1] + m[11] * v[2] + m[15] : 1.0L;
+					for (k = 0; k < VEC3_SIZE; k++) {
+						reference[k] = (m[k] * v[0] + m[4 + k] * v[1] + m[8 + k] * v[2] + (j == 0 ? m[12 + k] : 0.0L)) / w;
+					}
+					max_ulp[j] = test_max(max_ulp[j], test_ulp(result + point * step, reference, VEC3_SIZE, 1.0L));
+					if (layout > 0 && (result[point * 5 + 3] != TEST_GARBAGE || result[point * 5 + 4] != TEST_GARBAGE)) {
+						max_ulp[j] = INFINITY;
+					}
+				}
+				if (layout == 0 && result[TEST_TRANSFORM_COUNT * VEC3_SIZE] != TEST_GARBAGE) {
+					max_ulp[j] = INFINITY;
+				}
+			}
+		}
+	}
+	test_report("mat4_transform_points", max_ulp[0], 8.0L);
+	test_report("mat4_transform_directions", max_ulp[1], 8.0L);
+}
+
+/* Packed and interleaved half positions, over more than one chunk, against
+ * mat4_transform_points() on the decoded positions */
+static void test_mat4_transform_points_half(void)
+{
+	long double max_ulp = 0.0L;
+	mhalf_t interleaved[150 * 8];
+	mhalf_t packed[150 * VEC3_SIZE];
+	mfloat_t points[150 * VEC3_SIZE];
+	mfloat_t expected[150 * VEC3_SIZE];
+	mfloat_t result[150 * VEC3_SIZE];
+	mfloat_t m0[MAT4_SIZE];
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES / 100; i++) {
+		for (k = 0; k < MAT4_SIZE; k++) {
+			m0[k] = (mfloat_t)test_random(-2.0L, 2.0L);
+		}
+		for (k = 0; k < 150 * VEC3_SIZE; k++) {
+			points[k] = (mfloat_t)test_random(-100.0L, 100.0L);
+		}
+		half_encode_n(packed, points, 150 * VEC3_SIZE);
+		half_decode_n(points, packed, 150 * VEC3_SIZE);
+		for (k = 0; k < 150 * 8; k++) {
+			interleaved[k] = (mhalf_t)0x7e00;
+		}
+		for (k = 0; k < 150 * VEC3_SIZE; k++) {
+			interleaved[k / VEC3_SIZE * 8 + k % VEC3_SIZE] = packed[k];
+		}
+		mat4_transform_points(expected, points, 150, 0, m0);
+		for (k = 0; k < 2; k++) {
+			long double reference[150 * VEC3_SIZE];
+			test_load(reference, expected, 150 * VEC3_SIZE);
+			if (k == 0) {
+				mat4_transform_points_half(result, packed, 150, 0, m0);
+			} else {
+				mat4_transform_points_half(result, interleaved, 150, 8 * sizeof(mhalf_t), m0);
+			}
+			max_ulp = test_max(max_ulp, test_ulp(result, reference, 150 * VEC3_SIZE, 1.0L));
+		}
+	}
+	test_report("mat4_transform_points_half", max_ulp, 0.0L);
+}
+
+#define TEST_TRACK_KEYS 32
+
+/* Four tracks, one per interpolation, with 1 to 32 keys, sampled forward,
+ * backward and with jumps that include the key times and both clamped
+ * ends. Each sample is compared with a linear search for the key, the
+ * cursor must be left on that key, and animation_track_sample_n() must
+ * match the scalar samples exactly */
+static void test_animation_track(void)
+{
+	mfloat_t times[4][TEST_TRACK_KEYS];
+	mfloat_t values[4][TEST_TRACK_KEYS * 3 * QUAT_SIZE];
+	struct animation_track tracks[4];
+	struct animation_track batched_tracks[4];
+	long double max_ulp[5] = {0.0L, 0.0L, 0.0L, 0.0L, 0.0L};
+	int i;
+	int j;
+	int k;
+	for (i = 0; i < TEST_SAMPLES / 50; i++) {
+		size_t count = i % 8 == 0 ? 1 : 2 + (size_t)test_random(0.0L, TEST_TRACK_KEYS - 2.0L);
+		mfloat_t first;
+		mfloat_t last;
+		for (k = 0; k < 4; k++) {
+			struct animation_track *t0 = &tracks[k];
+			size_t key;
+			t0->times = times[k];
+			t0->values = values[k];
+			t0->count = count;
+			t0->interpolation = k;
+			t0->size = k == ANIMATION_SLERP ? QUAT_SIZE : 1 + i % 3;
+			t0->cursor = 0;
+			times[k][0] = (mfloat_t)test_random(-1.0L, 1.0L);
+			for (key = 1; key < count; key++) {
+				times[k][key] = times[k][key - 1] + (mfloat_t)test_random(0.05L, 1.0L);
+			}
+			for (key = 0; key < count * (k == ANIMATION_CUBIC ? 3 : 1); key++) {
+				long double q[QUAT_SIZE];
+				if (k == ANIMATION_SLERP) {
+					test_random_quat(q);
+					test_store(values[k] + key * QUAT_SIZE, q, QUAT_SIZE);
+				} else {
+					for (j = 0; j < t0->size; j++) {
+						values[k][key * (size_t)t0->size + (size_t)j] = (mfloat_t)test_random(-1.0L, 1.0L);
+					}
+				}
+			}
+			batched_tracks[k] = *t0;
+		}
+		/* The same key times for every track, so that they share a sequence */
+		for (k = 1; k < 4; k++) {
+			memcpy(times[k], times[0], count * sizeof(mfloat_t));
+		}
+		first = times[0][0] - MFLOAT_C(0.5);
+		last = times[0][count - 1] + MFLOAT_C(0.5);
+		for (j = 0; j < 90; j++) {
+			mfloat_t time;
+			mfloat_t batched[3 * 3 + QUAT_SIZE];
+			mfloat_t *out = batched;
+			if (j < 30) {
+				time = first + (last - first) * (mfloat_t)j / MFLOAT_C(29.0);
+			} else if (j < 60) {
+				time = last - (last - first) * (mfloat_t)(j - 30) / MFLOAT_C(29.0);
+			} else if (j % 3 == 0) {
+				time = times[0][(size_t)test_random(0.0L, (long double)count - 0.01L)];
+			} else {
+				time = (mfloat_t)test_random((long double)first, (long double)last);
+			}
+			animation_track_sample_n(batched, batched_tracks, 4, time);
+			for (k = 0; k < 4; k++) {
+				mfloat_t result[QUAT_SIZE];
+				long double reference[QUAT_SIZE];
+				size_t key;
+				ref_animation_track_sample(reference, &tracks[k], time, &key);
+				animation_track_sample(result, &tracks[k], time);
+				max_ulp[k] = test_max(max_ulp[k], test_ulp(result, reference, tracks[k].size, 1.0L));
+				if (key < count && tracks[k].cursor != key) {
+					max_ulp[k] = INFINITY;
+				}
+				test_load(reference, result, tracks[k].size);
+				max_ulp[4] = test_max(max_ulp[4], test_ulp(out, reference, tracks[k].size, 1.0L));
+				out = out + tracks[k].size;
+			}
+		}
+	}
+	test_report("animation_track_sample_step", max_ulp[ANIMATION_STEP], 0.0L);
+	test_report("animation_track_sample_linear", max_ulp[ANIMATION_LINEAR], 8.0L);
+	test_report("animation_track_sample_slerp", max_ulp[ANIMATION_SLERP], 8.0L);
+	test_report("animation_track_sample_cubic", max_ulp[ANIMATION_CUBIC], 8.0L);
+	test_report("animation_track_sample_n", max_ulp[4], 0.0L);
+}
+
+#define TEST_SKIN_COUNT 150
+#define TEST_SKIN_BONES 8
+
+/* Weighted sum of the four bone matrices of a vertex applied to a point */
+static void test_skin_reference(long double *result, mfloat_t *v0, int *bones, mfloat_t *weights, mfloat_t *m0)
+{
+	mfloat_t point[VEC4_SIZE];
+	mfloat_t transformed[VEC4_SIZE];
+	int j;
+	int k;
+	vec4(point, v0[0], v0[1], v0[2], MFLOAT_C(1.0));
+	for (k = 0; k < VEC3_SIZE; k++) {
+		result[k] = 0.0L;
+	}
+	for (j = 0; j < 4; j++) {
+		vec4_multiply_mat4(transformed, point, m0 + bones[j] * MAT4_SIZE);
+		for (k = 0; k < VEC3_SIZE; k++) {
+			result[k] = result[k] + (long double)weights[j] * (long double)transformed[k];
+		}
+	}
+}
+
+/* Linear blend skinning of interleaved and stream points against weighted
+ * sums of vec4_multiply_mat4() over affine bones. Dual quaternion skinning
+ * is checked against the same sums with rigid bones, on vertices whose
+ * blend stays rigid: a single bone, one bone in every slot, or bones
+ * sharing a rotation, with some dual quaternions negated */
+static void test_skin(void)
+{
+	long double max_ulp[4] = {0.0L, 0.0L, 0.0L, 0.0L};
+	mfloat_t interleaved[TEST_SKIN_COUNT * 5];
+	mfloat_t result[TEST_SKIN_COUNT * 5];
+	mfloat_t x[2][TEST_SKIN_COUNT];
+	mfloat_t y[2][TEST_SKIN_COUNT];
+	mfloat_t z[2][TEST_SKIN_COUNT];
+	mfloat_t affine[TEST_SKIN_BONES * MAT4_SIZE];
+	mfloat_t rigid[TEST_SKIN_BONES * MAT4_SIZE];
+	mfloat_t dual[TEST_SKIN_BONES * DUALQUAT_SIZE];
+	mfloat_t weights[2][TEST_SKIN_COUNT * 4];
+	int bones[2][TEST_SKIN_COUNT * 4];
+	struct vec3_stream points;
+	struct vec3_stream skinned;
+	int i;
+	int j;
+	int k;
+	points.x = x[0];
+	points.y = y[0];
+	points.z = z[0];
+	points.count = TEST_SKIN_COUNT;
+	skinned.x = x[1];
+	skinned.y = y[1];
+	skinned.z = z[1];
+	skinned.count = 0;
+	for (i = 0; i < TEST_SAMPLES / 100; i++) {
+		for (j = 0; j < TEST_SKIN_BONES; j++) {
+			long double q[QUAT_SIZE];
+			mfloat_t rotation[QUAT_SIZE];
+			for (k = 0; k < MAT4_SIZE; k++) {
+				affine[j * MAT4_SIZE + k] = k % 4 == 3 ? MFLOAT_C(0.0) : (mfloat_t)test_random(-2.0L, 2.0L);
+			}
+			affine[j * MAT4_SIZE + 15] = MFLOAT_C(1.0);
+			/* Bones 4 to 7 share the rotations of bones 0 to 3 */
+			if (j < 4) {
+				test_random_quat(q);
+				test_store(rotation, q, QUAT_SIZE);
+				mat4_rotation_quat(rigid + j * MAT4_SIZE, rotation);
+			} else {
+				mat4_assign(rigid + j * MAT4_SIZE, rigid + (j - 4) * MAT4_SIZE);
+			}
+			for (k = 12; k < 15; k++) {
+				rigid[j * MAT4_SIZE + k] = (mfloat_t)test_random(-2.0L, 2.0L);
+			}
+			dualquat_from_mat4(dual + j * DUALQUAT_SIZE, rigid + j * MAT4_SIZE);
+			/* Bones 4 to 7 come from the other hemisphere */
+			for (k = 0; k < DUALQUAT_SIZE && j >= 4; k++) {
+				dual[j * DUALQUAT_SIZE + k] = -dual[j * DUALQUAT_SIZE + k];
+			}
+		}
+		for (j = 0; j < TEST_SKIN_COUNT; j++) {
+			int bone = (int)test_random(0.0L, 3.99L);
+			long double total = 0.0L;
+			for (k = 0; k < 5; k++) {
+				interleaved[j * 5 + k] = (mfloat_t)test_random(-2.0L, 2.0L);
+			}
+			x[0][j] = interleaved[j * 5];
+			y[0][j] = interleaved[j * 5 + 1];
+			z[0][j] = interleaved[j * 5 + 2];
+			/* Any four bones with weights summing to one, the last slot
+			 * unused for a third of the vertices */
+			for (k = 0; k < 4; k++) {
+				bones[0][j * 4 + k] = (int)test_random(0.0L, TEST_SKIN_BONES - 0.01L);
+				weights[0][j * 4 + k] = (mfloat_t)(k == 3 && j % 3 == 0 ? 0.0L : test_random(0.1L, 1.0L));
+				total = total + (long double)weights[0][j * 4 + k];
+			}
+			for (k = 0; k < 4; k++) {
+				weights[0][j * 4 + k] = (mfloat_t)((long double)weights[0][j * 4 + k] / total);
+			}
+			/* A single bone, one bone in every slot, or bones sharing a rotation */
+			total = 0.0L;
+			for (k = 0; k < 4; k++) {
+				bones[1][j * 4 + k] = j % 3 == 2 ? bone + 4 * (k % 2) : bone;
+				weights[1][j * 4 + k] = (mfloat_t)(j % 3 == 0 && k > 0 ? 0.0L : test_random(0.1L, 1.0L));
+				total = total + (long double)weights[1][j * 4 + k];
+			}
+			for (k = 0; k < 4; k++) {
+				weights[1][j * 4 + k] = (mfloat_t)((long double)weights[1][j * 4 + k] / total);
+			}
+		}
+		mat4_skin_points(result, interleaved, TEST_SKIN_COUNT, 5 * sizeof(mfloat_t), bones[0], weights[0], affine);
+		mat4_skin_stream(&skinned, &points, bones[0], weights[0], affine);
+		for (j = 0; j < TEST_SKIN_COUNT; j++) {
+			long double reference[VEC3_SIZE];
+			mfloat_t stream[VEC3_SIZE];
+			test_skin_reference(reference, interleaved + j * 5, bones[0] + j * 4, weights[0] + j * 4, affine);
+			max_ulp[0] = test_max(max_ulp[0], test_ulp(result + j * 5, reference, VEC3_SIZE, 1.0L));
+			vec3(stream, x[1][j], y[1][j], z[1][j]);
+			max_ulp[1] = test_max(max_ulp[1], test_ulp(stream, reference, VEC3_SIZE, 1.0L));
+		}
+		if (skinned.count != TEST_SKIN_COUNT) {
+			max_ulp[1] = INFINITY;
+		}
+		dualquat_skin_points(result, interleaved, TEST_SKIN_COUNT, 5 * sizeof(mfloat_t), bones[1], weights[1], dual);
+		dualquat_skin_stream(&skinned, &points, bones[1], weights[1], dual);
+		for (j = 0; j < TEST_SKIN_COUNT; j++) {
+			long double reference[VEC3_SIZE];
+			mfloat_t stream[VEC3_SIZE];
+			test_skin_reference(reference, interleaved + j * 5, bones[1] + j * 4, weights[1] + j * 4, rigid);
+			max_ulp[2] = test_max(max_ulp[2], test_ulp(result + j * 5, reference, VEC3_SIZE, 1.0L));
+			vec3(stream, x[1][j], y[1][j], z[1][j]);
+			max_ulp[3] = test_max(max_ulp[3], test_ulp(stream, reference, VEC3_SIZE, 1.0L));
+		}
+	}
+	test_report("mat4_skin_points", max_ulp[0], 8.0L);
+	test_report("mat4_skin_stream", max_ulp[1], 8.0L);
+	test_report("dualquat_skin_points", max_ulp[2], 32.0L);
+	test_report("dualquat_skin_stream", max_ulp[3], 32.0L);
+}
+
+/* Compares the packet against ray_intersect_plane() one ray at a time, with
+ * a stream longer than a packet, whose rays past the first 32 must be left alone.
+ * Every other sample uses an axis as the normal, with some rays parallel to the plane */
+static void test_ray_intersect_plane_packet(void)
+{
+	long double max_ulp = 0.0L;
+	mfloat_t x[2][40];
+	mfloat_t y[2][40];
+	mfloat_t z[2][40];
+	struct vec3_stream origins;
+	struct vec3_stream directions;
+	int i;
+	int k;
+	origins.x = x[0];
+	origins.y = y[0];
+	origins.z = z[0];
+	origins.count = 40;
+	directions.x = x[1];
+	directions.y = y[1];
+	directions.z = z[1];
+	directions.count = 40;
+	for (i = 0; i < TEST_SAMPLES / 10; i++) {
+		mfloat_t plane[VEC4_SIZE];
+		mfloat_t result[40];
+		mfloat_t closest[40];
+		long double normal[VEC3_SIZE];
+		uint32_t mask;
+		test_random_axis(normal);
+		if (i % 2 == 1) {
+			normal[0] = 0.0L;
+			normal[1] = 1.0L;
+			normal[2] = 0.0L;
+		}
+		test_store(plane, normal, VEC3_SIZE);
+		plane[3] = (mfloat_t)test_random(-1.0L, 1.0L);
+		for (k = 0; k < 40; k++) {
+			x[0][k] = (mfloat_t)test_random(-2.0L, 2.0L);
+			y[0][k] = (mfloat_t)test_random(-2.0L, 2.0L);
+			z[0][k] = (mfloat_t)test_random(-2.0L, 2.0L);
+			x[1][k] = (mfloat_t)test_random(-1.0L, 1.0L);
+			y[1][k] = i % 2 == 1 && k % 4 == 0 ? MFLOAT_C(0.0) : (mfloat_t)test_random(-1.0L, 1.0L);
+			z[1][k] = (mfloat_t)test_random(-1.0L, 1.0L);
+			closest[k] = k % 2 == 0 ? (mfloat_t)INFINITY : (mfloat_t)test_random(0.0L, 4.0L);
+			result[k] = closest[k];
+		}
+		mask = ray_intersect_plane_packet(result, &origins, &directions, plane);
+		for (k = 0; k < 40; k++) {
+			mfloat_t origin[VEC3_SIZE];
+			mfloat_t direction[VEC3_SIZE];
+			mfloat_t t = closest[k];
+			long double reference = (long double)closest[k];
+			bool hit = false;
+			bool reported = k < 32 && (mask >> k & 1u) != 0;
+			vec3(origin, x[0][k], y[0][k], z[0][k]);
+			vec3(direction, x[1][k], y[1][k], z[1][k]);
+			if (k < 32 && ray_intersect_plane(&t, origin, direction, plane) && t <= closest[k]) {
+				reference = (long double)t;
+				hit = true;
+			}
+			/* A wrong hit, or a miss that changes the distance, is an error without bound */
+			if (hit != reported || (!hit && result[k] != closest[k])) {
+				max_ulp = INFINITY;
+			} else if (hit) {
+				max_ulp = test_max(max_ulp, test_ulp(result + k, &reference, 1, 1.0L));
+			}
+		}
+	}
+	test_report("ray_intersect_plane_packet", max_ulp, 0.0L);
+}
+
+#define TEST_PACKET_TRIANGLE 0
+#define TEST_PACKET_AABB 1
+#define TEST_PACKET_SPHERE 2
+
+/* Triangle, box and sphere packets against their scalar tests one ray at a
+ * time, as for planes. A quarter of the rays aim at a point inside the
+ * primitive, a quarter start inside the box or sphere, and a quarter are
+ * parallel to the triangle or have a zero direction component for the box */
+static void test_ray_intersect_packets(void)
+{
+	long double max_ulp[3] = {0.0L, 0.0L, 0.0L};
+	mfloat_t x[2][40];
+	mfloat_t y[2][40];
+	mfloat_t z[2][40];
+	struct vec3_stream origins;
+	struct vec3_stream directions;
+	int i;
+	int j;
+	int k;
+	origins.x = x[0];
+	origins.y = y[0];
+	origins.z = z[0];
+	origins.count = 40;
+	directions.x = x[1];
+	directions.y = y[1];
+	directions.z = z[1];
+	directions.count = 40;
+	for (i = 0; i < TEST_SAMPLES / 10; i++) {
+		for (j = TEST_PACKET_TRIANGLE; j <= TEST_PACKET_SPHERE; j++) {
+			mfloat_t v[3][VEC3_SIZE];
+			mfloat_t r = (mfloat_t)test_random(0.2L, 1.0L);
+			mfloat_t result[40];
+			mfloat_t closest[40];
+			uint32_t mask;
+			/* The vertices of the triangle, the corners of the box, or the
+			 * center of the sphere */
+			for (k = 0; k < VEC3_SIZE; k++) {
+				mfloat_t center = (mfloat_t)test_random(-1.0L, 1.0L);
+				mfloat_t extent = (mfloat_t)test_random(0.2L, 1.0L);
+				v[0][k] = j == TEST_PACKET_AABB ? center - extent : center;
+				v[1][k] = j == TEST_PACKET_AABB ? center + extent : (mfloat_t)test_random(-1.0L, 1.0L);
+				v[2][k] = (mfloat_t)test_random(-1.0L, 1.0L);
+			}
+			for (k = 0; k < 40; k++) {
+				mfloat_t inside[VEC3_SIZE];
+				mfloat_t a = (mfloat_t)test_random(0.05L, 0.95L);
+				mfloat_t b = (mfloat_t)test_random(0.05L, 0.95L) * (MFLOAT_C(1.0) - a);
+				int axis;
+				for (axis = 0; axis < VEC3_SIZE; axis++) {
+					mfloat_t f = (mfloat_t)test_random(0.05L, 0.95L);
+					if (j == TEST_PACKET_TRIANGLE) {
+						inside[axis] = v[0][axis] + (v[1][axis] - v[0][axis]) * a + (v[2][axis] - v[0][axis]) * b;
+					} else if (j == TEST_PACKET_AABB) {
+						inside[axis] = v[0][axis] + (v[1][axis] - v[0][axis]) * f;
+					} else {
+						inside[axis] = v[0][axis] + r * (f - MFLOAT_C(0.5));
+					}
+				}
+				x[0][k] = (mfloat_t)test_random(-2.0L, 2.0L);
+				y[0][k] = (mfloat_t)test_random(-2.0L, 2.0L);
+				z[0][k] = (mfloat_t)test_random(-2.0L, 2.0L);
+				x[1][k] = (mfloat_t)test_random(-1.0L, 1.0L);
+				y[1][k] = (mfloat_t)test_random(-1.0L, 1.0L);
+				z[1][k] = (mfloat_t)test_random(-1.0L, 1.0L);
+				if (k % 4 == 1 && j != TEST_PACKET_TRIANGLE) {
+					x[0][k] = inside[0];
+					y[0][k] = inside[1];
+					z[0][k] = inside[2];
+				} else if (k % 4 == 2 && j == TEST_PACKET_TRIANGLE) {
+					/* Along an edge the determinant is exactly zero */
+					a = k % 8 == 2 ? MFLOAT_C(0.0) : a;
+					b = k % 8 == 2 ? MFLOAT_C(1.0) : b;
+					x[1][k] = (v[1][0] - v[0][0]) * a + (v[2][0] - v[0][0]) * b;
+					y[1][k] = (v[1][1] - v[0][1]) * a + (v[2][1] - v[0][1]) * b;
+					z[1][k] = (v[1][2] - v[0][2]) * a + (v[2][2] - v[0][2]) * b;
+				} else if (k % 4 == 2 && j == TEST_PACKET_AABB) {
+					y[1][k] = MFLOAT_C(0.0);
+					z[1][k] = k % 8 == 2 ? MFLOAT_C(0.0) : z[1][k];
+				} else if (k % 4 == 3) {
+					x[1][k] = inside[0] - x[0][k];
+					y[1][k] = inside[1] - y[0][k];
+					z[1][k] = inside[2] - z[0][k];
+				}
+				closest[k] = k % 2 == 0 ? (mfloat_t)INFINITY : (mfloat_t)test_random(0.0L, 4.0L);
+				result[k] = closest[k];
+			}
+			if (j == TEST_PACKET_TRIANGLE) {
+				mask = ray_intersect_triangle_packet(result, &origins, &directions, v[0], v[1], v[2]);
+			} else if (j == TEST_PACKET_AABB) {
+				mask = ray_intersect_aabb_packet(result, &origins, &directions, v[0], v[1]);
+			} else {
+				mask = ray_intersect_sphere_packet(result, &origins, &directions, v[0], r);
+			}
+			for (k = 0; k < 40; k++) {
+				mfloat_t origin[VEC3_SIZE];
+				mfloat_t direction[VEC3_SIZE];
+				mfloat_t t = closest[k];
+				long double reference = (long double)closest[k];
+				bool hit = false;
+				bool reported = k < 32 && (mask >> k & 1u) != 0;
+				vec3(origin, x[0][k], y[0][k], z[0][k]);
+				vec3(direction, x[1][k], y[1][k], z[1][k]);
+				if (j == TEST_PACKET_TRIANGLE) {
+					hit = ray_intersect_triangle(&t, origin, direction, v[0], v[1], v[2]);
+				} else if (j == TEST_PACKET_AABB) {
+					hit = ray_intersect_aabb(&t, origin, direction, v[0], v[1]);
+				} else {
+					hit = ray_intersect_sphere(&t, origin, direction, v[0], r);
+				}
+				hit = k < 32 && hit && t <= closest[k];
+				if (hit) {
+					reference = (long double)t;
+				}
+				if (hit != reported || (!hit && result[k] != closest[k])) {
+					max_ulp[j] = INFINITY;
+				} else if (hit) {
+					max_ulp[j] = test_max(max_ulp[j], test_ulp(result + k, &reference, 1, 1.0L));
+				}
+			}
+		}
+	}
+	test_report("ray_intersect_triangle_packet", max_ulp[0], 0.0L);
+	test_report("ray_intersect_aabb_packet", max_ulp[1], 0.0L);
+	test_report("ray_intersect_sphere_packet", max_ulp[2], 0.0L);
+}
+
+#define TEST_BVH_COUNT 1000
+
+struct test_bvh_boxes {
+	mfloat_t *min;
+	mfloat_t *max;
+};
+
+static bool test_bvh_box(void *data, int index, mfloat_t *result, mfloat_t *origin, mfloat_t *direction)
+{
+	struct test_bvh_boxes *boxes = (struct test_bvh_boxes *)data;
+	mfloat_t t;
+	if (ray_intersect_aabb(&t, origin, direction, boxes->min + index * VEC3_SIZE, boxes->max + index * VEC3_SIZE) && t < *result) {
+		*result = t;
+		return true;
+	}
+	return false;
+}
+
+static void test_bvh_visit(void *data, int index)
+{
+	int *visits = (int *)data;
+	visits[index] = visits[index] + 1;
+}
+
+/* Error of a traversal against the closest hit of a brute force loop: none
+ * when both agree on the distance and the primitive returned is hit at
+ * that distance (primitives may tie), unbounded otherwise */
+static long double test_bvh_error(int hit, mfloat_t distance, int expected_hit, mfloat_t expected, mfloat_t t)
+{
+	if ((hit < 0) != (expected_hit < 0) || distance != expected || (hit >= 0 && t != expected)) {
+		return INFINITY;
+	}
+	return 0.0L;
+}
+
+/* Trees over boxes and over triangles, each checked against brute force
+ * loops over every primitive for rays and frustums. The scenes are random,
+ * with every centroid at the origin (no split by area is possible), and
+ * spaced by powers of two (deep trees, then identical centroids) */
+static void test_bvh(void)
+{
+	static mfloat_t min[TEST_BVH_COUNT * VEC3_SIZE];
+	static mfloat_t max[TEST_BVH_COUNT * VEC3_SIZE];
+	static mfloat_t triangles[TEST_BVH_COUNT * VEC3_SIZE * 3];
+	static struct bvh_node nodes[2][2 * TEST_BVH_COUNT - 1];
+	static int indices[2][TEST_BVH_COUNT];
+	static int visits[TEST_BVH_COUNT];
+	long double max_ulp[3] = {0.0L, 0.0L, 0.0L};
+	struct test_bvh_boxes boxes;
+	struct bvh trees[2];
+	int scene;
+	int i;
+	int k;
+	boxes.min = min;
+	boxes.max = max;
+	trees[0].nodes = nodes[0];
+	trees[0].indices = indices[0];
+	trees[1].nodes = nodes[1];
+	trees[1].indices = indices[1];
+	for (scene = 0; scene < 3; scene++) {
+		for (i = 0; i < TEST_BVH_COUNT; i++) {
+			mfloat_t *t = triangles + i * VEC3_SIZE * 3;
+			long double center[VEC3_SIZE] = {0.0L, 0.0L, 0.0L};
+			long double size = test_random(0.1L, 1.0L);
+			if (scene == 0) {
+				for (k = 0; k < VEC3_SIZE; k++) {
+					center[k] = test_random(-4.0L, 4.0L);
+				}
+			} else if (scene == 1) {
+				size = test_random(0.01L, 2.0L);
+			} else {
+				center[0] = ldexpl(4.0L, -(i % 120));
+				size = center[0] * 0.25L;
+			}
+			for (k = 0; k < VEC3_SIZE; k++) {
+				long double extent = size * test_random(0.2L, 1.0L);
+				min[i * VEC3_SIZE + k] = (mfloat_t)(center[k] - extent);
+				max[i * VEC3_SIZE + k] = (mfloat_t)(center[k] + extent);
+				/* The bounds of the triangle are centered too */
+				t[k] = (mfloat_t)(center[k] + extent);
+				t[VEC3_SIZE + k] = (mfloat_t)(center[k] - extent);
+				t[VEC3_SIZE * 2 + k] = (mfloat_t)(center[k] + (k == 0 ? extent : -extent) * test_random(-1.0L, 1.0L));
+			}
+		}
+		bvh_build(&trees[0], min, max, TEST_BVH_COUNT);
+		bvh_build_triangles(&trees[1], triangles, TEST_BVH_COUNT);
+		for (i = 0; i < TEST_SAMPLES / 10; i++) {
+			mfloat_t origin[VEC3_SIZE];
+			mfloat_t direction[VEC3_SIZE];
+			mfloat_t limit = i % 4 == 3 ? (mfloat_t)test_random(0.5L, 1.5L) : (mfloat_t)INFINITY;
+			mfloat_t expected[2];
+			mfloat_t distance;
+			mfloat_t t;
+			int expected_hit[2] = {-1, -1};
+			int hit;
+			for (k = 0; k < VEC3_SIZE; k++) {
+				origin[k] = (mfloat_t)test_random(-6.0L, 6.0L);
+				direction[k] = (mfloat_t)(test_random(-4.0L, 4.0L) * (scene == 0 ? 1.0L : 0.1L)) - origin[k];
+			}
+			expected[0] = limit;
+			expected[1] = limit;
+			for (k = 0; k < TEST_BVH_COUNT; k++) {
+				mfloat_t *v = triangles + k * VEC3_SIZE * 3;
+				if (ray_intersect_aabb(&t, origin, direction, min + k * VEC3_SIZE, max + k * VEC3_SIZE) && t < expected[0]) {
+					expected[0] = t;
+					expected_hit[0] = k;
+				}
+				if (ray_intersect_triangle(&t, origin, direction, v, v + VEC3_SIZE, v + VEC3_SIZE * 2) && t < expected[1]) {
+					expected[1] = t;
+					expected_hit[1] = k;
+				}
+			}
+			distance = limit;
+			hit = bvh_intersect_ray(&distance, &trees[0], origin, direction, test_bvh_box, &boxes);
+			t = distance;
+			if (hit >= 0) {
+				t = (mfloat_t)INFINITY;
+				test_bvh_box(&boxes, hit, &t, origin, direction);
+			}
+			max_ulp[0] = test_max(max_ulp[0], test_bvh_error(hit, distance, expected_hit[0], expected[0], t));
+			distance = limit;
+			hit = bvh_intersect_ray_triangles(&distance, &trees[1], origin, direction, triangles);
+			if (hit >= 0) {
+				mfloat_t *v = triangles + hit * VEC3_SIZE * 3;
+				t = (mfloat_t)INFINITY;
+				ray_intersect_triangle(&t, origin, direction, v, v + VEC3_SIZE, v + VEC3_SIZE * 2);
+			}
+			max_ulp[1] = test_max(max_ulp[1], test_bvh_error(hit, distance, expected_hit[1], expected[1], t));
+		}
+		/* Every primitive in the frustum is found once, the others may be
+		 * found with the leaf that holds them */
+		for (i = 0; i < TEST_SAMPLES / 100; i++) {
+			mfloat_t f0[FRUSTUM_SIZE];
+			size_t found;
+			size_t total = 0;
+			test_random_frustum(f0);
+			for (k = 0; k < TEST_BVH_COUNT; k++) {
+				visits[k] = 0;
+			}
+			found = bvh_query_frustum(&trees[0], f0, test_bvh_visit, visits);
+			for (k = 0; k < TEST_BVH_COUNT; k++) {
+				if (visits[k] > 1 || (visits[k] == 0 && frustum_intersects_aabb(f0, min + k * VEC3_SIZE, max + k * VEC3_SIZE))) {
+					max_ulp[2] = INFINITY;
+				}
+				total = total + (size_t)visits[k];
+			}
+			if (total != found) {
+				max_ulp[2] = INFINITY;
+			}
+		}
+	}
+	test_report("bvh_intersect_ray", max_ulp[0], 0.0L);
+	test_report("bvh_intersect_ray_triangles", max_ulp[1], 0.0L);
+	test_report("bvh_query_frustum", max_ulp[2], 0.0L);
+}
+
+static void test_vec_clamp(void)
+{
+	long double max_ulp[4] = {0.0L, 0.0L, 0.0L, 0.0L};
+	mfloat_t x[VEC3_SIZE];
+	mfloat_t y[VEC3_SIZE];
+	mfloat_t z[VEC3_SIZE];
+	struct vec3_stream stream;
+	int i;
+	int k;
+	stream.x = x;
+	stream.y = y;
+	stream.z = z;
+	stream.count = 1;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t v0[VEC4_SIZE];
+		mfloat_t v1[VEC4_SIZE];
+		mfloat_t v2[VEC4_SIZE];
+		mfloat_t result[VEC4_SIZE];
+		long double reference[VEC4_SIZE];
+		/* v1 is the upper bound and v2 the lower bound */
+		for (k = 0; k < VEC4_SIZE; k++) {
+			v0[k] = (mfloat_t)test_random(-2.0L, 2.0L);
+			v1[k] = (mfloat_t)test_random(0.0L, 1.0L);
+			v2[k] = (mfloat_t)test_random(-1.0L, 0.0L);
+			reference[k] = fmaxl(fminl((long double)v0[k], (long double)v1[k]), (long double)v2[k]);
+		}
+		vec2_clamp(result, v0, v1, v2);
+		max_ulp[0] = test_max(max_ulp[0], test_ulp(result, reference, VEC2_SIZE, 1.0L));
+		vec3_clamp(result, v0, v1, v2);
+		max_ulp[1] = test_max(max_ulp[1], test_ulp(result, reference, VEC3_SIZE, 1.0L));
+		vec4_clamp(result, v0, v1, v2);
+		max_ulp[2] = test_max(max_ulp[2], test_ulp(result, reference, VEC4_SIZE, 1.0L));
+		/* In place, with the result aliasing v0 */
+		vec4_assign(result, v0);
+		vec4_clamp(result, result, v1, v2);
+		max_ulp[2] = test_max(max_ulp[2], test_ulp(result, reference, VEC4_SIZE, 1.0L));
+		x[0] = v0[0];
+		y[0] = v0[1];
+		z[0] = v0[2];
+		vec3_stream_clamp(&stream, &stream, v1, v2);
+		vec3(result, x[0], y[0], z[0]);
+		max_ulp[3] = test_max(max_ulp[3], test_ulp(result, reference, VEC3_SIZE, 1.0L));
+	}
+	test_report("vec2_clamp", max_ulp[0], 0.0L);
+	test_report("vec3_clamp", max_ulp[1], 0.0L);
+	test_report("vec4_clamp", max_ulp[2], 0.0L);
+	test_report("vec3_stream_clamp", max_ulp[3], 0.0L);
+}
+
+static void test_vec4_bilinear(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	int k;
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		mfloat_t v[4][VEC4_SIZE];
+		mfloat_t result[VEC4_SIZE];
+		long double corners[4][VEC4_SIZE];
+		long double reference[VEC4_SIZE];
+		mfloat_t u = (mfloat_t)test_random(0.0L, 1.0L);
+		mfloat_t w = (mfloat_t)test_random(0.0L, 1.0L);
+		for (k = 0; k < VEC4_SIZE * 4; k++) {
+			v[k / VEC4_SIZE][k % VEC4_SIZE] = (mfloat_t)test_random(-1.0L, 1.0L);
+			corners[k / VEC4_SIZE][k % VEC4_SIZE] = (long double)v[k / VEC4_SIZE][k % VEC4_SIZE];
+		}
+		for (k = 0; k < VEC4_SIZE; k++) {
+			long double bottom = corners[0][k] + (corners[1][k] - corners[0][k]) * (long double)u;
+			long double top = corners[2][k] + (corners[3][k] - corners[2][k]) * (long double)u;
+			reference[k] = bottom + (top - bottom) * (long double)w;
+		}
+		vec4_bilinear(result, v[0], v[1], v[2], v[3], u, w);
+		max_ulp = test_max(max_ulp, test_ulp(result, reference, VEC4_SIZE, 1.0L));
+	}
+	test_report("vec4_bilinear", max_ulp, 8.0L);
+}
+
+#if defined(MATHC_USE_EASING_FUNCTIONS)
+static void test_back_ease_in_out(void)
+{
+	long double max_ulp = 0.0L;
+	int i;
+	for (i = 0; i <= TEST_SAMPLES; i++) {
+		mfloat_t f = (mfloat_t)((long double)i / (long double)TEST_SAMPLES);
+		mfloat_t result = back_ease_in_out(f);
+		long double a;
+		long double reference;
+		if ((long double)f < 0.5L) {
+			a = 2.0L * (long double)f;
+			reference = 0.5L * (a * a * a - a * sinl(a * 3.1415926535897932385L));
+		} else {
+			a = 2.0L - 2.0L * (long double)f;
+			reference = 0.5L * (1.0L - (a * a * a - a * sinl(a * 3.1415926535897932385L))) + 0.5L;
+		}
+		/* Measured against the output range, the curve crosses zero */
+		max_ulp = test_max(max_ulp, test_ulp(&result, &reference, 1, 1.0L));
+	}
+	test_report("back_ease_in_out", max_ulp, 8.0L);
+}
+
+#define TEST_EASE_COUNT 8193
+#define TEST_EASE_TABLE 1024
+
+struct test_ease {
+	const char *name;
+	mfloat_t (*func)(mfloat_t f);
+	mfloat_t *(*func_n)(mfloat_t *result, mfloat_t *f, size_t count);
+	int row;
+};
+
+static const struct test_ease test_eases[] = {
+	{"quadratic_ease_out", quadratic_ease_out, quadratic_ease_out_n, 0},
+	{"quadratic_ease_in", quadratic_ease_in, quadratic_ease_in_n, 0},
+	{"quadratic_ease_in_out", quadratic_ease_in_out, quadratic_ease_in_out_n, 0},
+	{"cubic_ease_out", cubic_ease_out, cubic_ease_out_n, 0},
+	{"cubic_ease_in", cubic_ease_in, cubic_ease_in_n, 0},
+	{"cubic_ease_in_out", cubic_ease_in_out, cubic_ease_in_out_n, 0},
+	{"quartic_ease_out", quartic_ease_out, quartic_ease_out_n, 0},
+	{"quartic_ease_in", quartic_ease_in, quartic_ease_in_n, 0},
+	{"quartic_ease_in_out", quartic_ease_in_out, quartic_ease_in_out_n, 0},
+	{"quintic_ease_out", quintic_ease_out, quintic_ease_out_n, 0},
+	{"quintic_ease_in", quintic_ease_in, quintic_ease_in_n, 0},
+	{"quintic_ease_in_out", quintic_ease_in_out, quintic_ease_in_out_n, 0},
+	{"sine_ease_out", sine_ease_out, sine_ease_out_n, 0},
+	{"sine_ease_in", sine_ease_in, sine_ease_in_n, 0},
+	{"sine_ease_in_out", sine_ease_in_out, sine_ease_in_out_n, 0},
+	{"back_ease_out", back_ease_out, back_ease_out_n, 0},
+	{"back_ease_in", back_ease_in, back_ease_in_n, 0},
+	{"back_ease_in_out", back_ease_in_out, back_ease_in_out_n, 0},
+	{"exponential_ease_out", exponential_ease_out, exponential_ease_out_n, 1},
+	{"exponential_ease_in", exponential_ease_in, exponential_ease_in_n, 4},
+	{"exponential_ease_in_out", exponential_ease_in_out, exponential_ease_in_out_n, 1},
+	{"elastic_ease_out", elastic_ease_out, elastic_ease_out_n, 1},
+	{"elastic_ease_in", elastic_ease_in, elastic_ease_in_n, 1},
+	{"elastic_ease_in_out", elastic_ease_in_out, elastic_ease_in_out_n, 1},
+	{"bounce_ease_out", bounce_ease_out, bounce_ease_out_n, 2},
+	{"bounce_ease_in", bounce_ease_in, bounce_ease_in_n, 2},
+	{"bounce_ease_in_out", bounce_ease_in_out, bounce_ease_in_out_n, 2},
+	{"circular_ease_out", circular_ease_out, circular_ease_out_n, 3},
+	{"circular_ease_in", circular_ease_in, circular_ease_in_n, 3},
+	{"circular_ease_in_out", circular_ease_in_out, circular_ease_in_out_n, 3},
+};
+
+/* Largest absolute errors of ease_table_sample() given in the README, by
+ * row of the table and by linear and cubic tables of 256 and 1024 values */
+static const long double test_ease_bounds[5][4] = {
+	{8e-5L, 1.2e-5L, 5e-6L, 1e-6L},
+	{1.2e-3L, 2e-4L, 9e-5L, 1.3e-5L},
+	{7e-3L, 5e-3L, 2.2e-3L, 1.7e-3L},
+	{2.3e-2L, 1.8e-2L, 1.2e-2L, 9e-3L},
+	{1e-3L, 1e-3L, 1e-3L, 1e-3L}
+};
+
+/* Every _n easing function against its scalar version, value by value and
+ * in place, then every function sampled from tables of 256 and 1024 values
+ * against the README bounds. The errors are absolute, in units in the last
+ * place of 1.0, and float builds add their rounding error to the bounds */
+static void test_ease_n(void)
+{
+	long double max_ulp[2] = {0.0L, 0.0L};
+	long double table_ulp[5][4] = {{0.0L}};
+	static mfloat_t f[TEST_EASE_COUNT];
+	static mfloat_t result[TEST_EASE_COUNT + 1];
+	mfloat_t values[TEST_EASE_TABLE + 2];
+	char name[64];
+	size_t i;
+	int column;
+	int j;
+	for (i = 0; i < TEST_EASE_COUNT; i++) {
+		f[i] = (mfloat_t)((long double)i / (long double)(TEST_EASE_COUNT - 1));
+	}
+	for (j = 0; j < (int)(sizeof(test_eases) / sizeof(test_eases[0])); j++) {
+		const struct test_ease *ease = &test_eases[j];
+		result[TEST_EASE_COUNT] = TEST_GARBAGE;
+		ease->func_n(result, f, TEST_EASE_COUNT);
+		for (i = 0; i < TEST_EASE_COUNT; i++) {
+			if (!test_same_value(result[i], ease->func(f[i]))) {
+				max_ulp[0] = INFINITY;
+			}
+		}
+		if (result[TEST_EASE_COUNT] != TEST_GARBAGE) {
+			max_ulp[0] = INFINITY;
+		}
+		memcpy(result, f, sizeof(f));
+		ease->func_n(result, result, TEST_EASE_COUNT);
+		for (i = 0; i < TEST_EASE_COUNT; i++) {
+			if (!test_same_value(result[i], ease->func(f[i]))) {
+				max_ulp[0] = INFINITY;
+			}
+		}
+		for (column = 0; column < 4; column++) {
+			struct ease_table table;
+			ease_table(&table, ease->func, values, column < 2 ? 256 : 1024, column % 2 == 1);
+			ease_table_sample_n(result, &table, f, TEST_EASE_COUNT);
+			for (i = 0; i < TEST_EASE_COUNT; i++) {
+				long double error = fabsl((long double)result[i] - (long double)ease->func(f[i]));
+				table_ulp[ease->row][column] = test_max(table_ulp[ease->row][column], error / ldexpl(1.0L, 1 - TEST_MANT_DIG));
+				if (!test_same_value(result[i], ease_table_sample(&table, f[i]))) {
+					max_ulp[1] = INFINITY;
+				}
+			}
+		}
+	}
+	test_report("ease_n", max_ulp[0], 0.0L);
+	test_report("ease_table_sample_n", max_ulp[1], 0.0L);
+	for (j = 0; j < 5; j++) {
+		for (column = 0; column < 4; column++) {
+			long double bound = test_ease_bounds[j][column] + ldexpl(1.0L, 3 - TEST_MANT_DIG);
+			sprintf(name, "ease_table_row%d_%s_%d", j + 1, column % 2 == 1 ? "cubic" : "linear", column < 2 ? 256 : 1024);
+			test_report(name, table_ulp[j][column], bound / ldexpl(1.0L, 1 - TEST_MANT_DIG));
+		}
+	}
+}
+#endif
+
+#if defined(MATHC_USE_THREADS)
+#define TEST_THREAD_COUNT 1000
+
+struct test_thread_job {
+	mfloat_t *result;
+	mfloat_t *m0;
+	mfloat_t *m1;
+	int *visits;
+};
+
+static void test_thread_multiply(void *data, size_t begin, size_t end)
+{
+	struct test_thread_job *job = (struct test_thread_job *)data;
+	size_t i;
+	mat4_multiply_n(job->result + begin * MAT4_SIZE, job->m0 + begin * MAT4_SIZE, job->m1 + begin * MAT4_SIZE, end - begin);
+	for (i = begin; i < end; i++) {
+		job->visits[i] = job->visits[i] + 1;
+	}
+}
+
+/* Many dispatches of different sizes and grains over one pool, and calls
+ * of mathc_parallel_for(), against a single call on the calling thread.
+ * Every element must be processed exactly once per dispatch */
+static void test_thread_pool(void)
+{
+	static mfloat_t m0[TEST_THREAD_COUNT * MAT4_SIZE];
+	static mfloat_t m1[TEST_THREAD_COUNT * MAT4_SIZE];
+	static mfloat_t result[TEST_THREAD_COUNT * MAT4_SIZE];
+	static mfloat_t expected[TEST_THREAD_COUNT * MAT4_SIZE];
+	static int visits[TEST_THREAD_COUNT];
+	long double max_ulp[2] = {0.0L, 0.0L};
+	struct mathc_thread_pool pool;
+	struct test_thread_job job;
+	int i;
+	size_t k;
+	for (k = 0; k < TEST_THREAD_COUNT * MAT4_SIZE; k++) {
+		m0[k] = (mfloat_t)test_random(-1.0L, 1.0L);
+		m1[k] = (mfloat_t)test_random(-1.0L, 1.0L);
+	}
+	mat4_multiply_n(expected, m0, m1, TEST_THREAD_COUNT);
+	job.result = result;
+	job.m0 = m0;
+	job.m1 = m1;
+	job.visits = visits;
+	mathc_thread_pool_create(&pool, 4);
+	for (i = 0; i < 400; i++) {
+		size_t count = (size_t)(i * 37) % TEST_THREAD_COUNT + 1;
+		size_t grain = (size_t)(i % 3 == 0 ? 0 : i % 9);
+		int which = i % 4 == 3 ? 1 : 0;
+		for (k = 0; k < count * MAT4_SIZE; k++) {
+			result[k] = TEST_GARBAGE;
+		}
+		for (k = 0; k < count; k++) {
+			visits[k] = 0;
+		}
+		if (which == 0) {
+			mathc_thread_pool_dispatch(&pool, count, grain, test_thread_multiply, &job);
+		} else {
+			mathc_parallel_for(count, grain, test_thread_multiply, &job, 1 + i % 8);
+		}
+		for (k = 0; k < count; k++) {
+			if (visits[k] != 1) {
+				max_ulp[which] = INFINITY;
+			}
+		}
+		for (k = 0; k < count * MAT4_SIZE; k++) {
+			long double reference = (long double)expected[k];
+			max_ulp[which] = test_max(max_ulp[which], test_ulp(result + k, &reference, 1, 1.0L));
+		}
+	}
+	mathc_thread_pool_destroy(&pool);
+	test_report("mathc_thread_pool_dispatch", max_ulp[0], 0.0L);
+	test_report("mathc_parallel_for", max_ulp[1], 0.0L);
+}
+#endif
+
+int main(int argc, char **argv)
+{
+	int i;
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--no-header") == 0) {
+			continue;
+		}
+		fprintf(stderr, "usage: %s [--no-header]\n", argv[0]);
+		return 2;
+	}
+	if (argc < 2) {
+		printf("function,precision,max_ulp,limit,result\n");
+	}
+	test_mat2_inverse();
+	test_mat3_rotation_axis();
+	test_mat3_rotation_quat();
+	test_mat4_inverse();
+	test_mat4_affine();
+	test_mat4_multiply_n();
+	test_mat4_perspective();
+	test_mathc_sincos();
+	test_mathc_acos();
+	test_quat_multiply();
+	test_quat_divide();
+	test_quat_power();
+	test_quat_slerp_n_fast();
+	test_quat_from_vec3();
+	test_quat_from_mat4();
+	test_trs();
+	test_mat4_hierarchy();
+	test_frustum();
+	test_aligned_buffer();
+	test_quat_encode();
+	test_vec3_encode();
+	test_half();
+	test_mat4_transform_points();
+	test_mat4_transform_points_half();
+	test_animation_track();
+	test_skin();
+	test_ray_intersect_plane_packet();
+	test_ray_intersect_packets();
+	test_bvh();
+	test_vec_clamp();
+	test_vec4_bilinear();
+#if defined(MATHC_USE_EASING_FUNCTIONS)
+	test_back_ease_in_out();
+	test_ease_n();
+#endif
+#if defined(MATHC_USE_THREADS)
+	test_thread_pool();
+#endif
+	return test_failures == 0 ? 0 : 1;
+}